@@ -21,10 +21,13 @@
 #include "feedbackmanager/include/FeedbackManager.h"
 #include "rtxts-ttm/TiledTextureManager.h"
 
+class TileDataSource;
+
 struct FeedbackTextureWrapper
 {
     nvrhi::RefCountPtr<nvfeedback::FeedbackTexture> m_feedbackTexture;
     std::shared_ptr<donut::engine::TextureData> m_sourceTexture;
+    std::shared_ptr<TileDataSource> m_tileDataSource;
 };
 
 struct FeedbackTextureMaps
@@ -0,0 +1,303 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "TileDataSource.h"
+
+#include <donut/core/vfs/VFS.h>
+#include <donut/core/log.h>
+
+#include <algorithm>
+#include <string.h>
+
+using namespace donut;
+using namespace donut::engine;
+
+namespace
+{
+    // Formats tile packs can be transcoded to, see tilestream/TileTranscoder.h
+    bool GetTranscodedFormat(uint32_t dxgiFormat, nvrhi::Format& format)
+    {
+        switch (dxgiFormat)
+        {
+        case 71: format = nvrhi::Format::BC1_UNORM; return true;
+        case 72: format = nvrhi::Format::BC1_UNORM_SRGB; return true;
+        case 77: format = nvrhi::Format::BC3_UNORM; return true;
+        case 78: format = nvrhi::Format::BC3_UNORM_SRGB; return true;
+        case 83: format = nvrhi::Format::BC5_UNORM; return true;
+        case 98: format = nvrhi::Format::BC7_UNORM; return true;
+        case 99: format = nvrhi::Format::BC7_UNORM_SRGB; return true;
+        default: return false;
+        }
+    }
+}
+
+TileDataSource::TileDataSource(nvrhi::Format format, uint32_t width, uint32_t height, uint32_t depth, uint32_t arraySize, uint32_t mipLevels)
+    : m_width(width)
+    , m_height(height)
+    , m_depth(depth)
+    , m_arraySize(arraySize)
+    , m_mipLevels(mipLevels)
+{
+    SetFormat(format);
+}
+
+void TileDataSource::SetFormat(nvrhi::Format format)
+{
+    const nvrhi::FormatInfo& formatInfo = nvrhi::getFormatInfo(format);
+    m_format = format;
+    m_blockSize = formatInfo.blockSize;
+    m_bytesPerBlock = formatInfo.bytesPerBlock;
+}
+
+void TileDataSource::RequestTile(const nvfeedback::TileDataRequest& request, const nvfeedback::TileDataCompletion& onComplete)
+{
+    onComplete(ReadTile(request.tile, request.dest, request.destRowPitch, request.destDepthPitch));
+}
+
+uint32_t TileDataSource::GetRowPitch(uint32_t widthInTexels) const
+{
+    return ((widthInTexels + m_blockSize - 1) / m_blockSize) * m_bytesPerBlock;
+}
+
+uint64_t TileDataSource::GetSizeInBytes(uint32_t widthInTexels, uint32_t heightInTexels) const
+{
+    return uint64_t(GetRowPitch(widthInTexels)) * ((heightInTexels + m_blockSize - 1) / m_blockSize);
+}
+
+uint64_t TileDataSource::GetMipSizeInBytes(uint32_t mip) const
+{
+    return GetSizeInBytes(GetMipWidth(mip), GetMipHeight(mip));
+}
+
+uint32_t TileDataSource::GetMipWidth(uint32_t mip) const
+{
+    return std::max(m_width >> mip, 1u);
+}
+
+uint32_t TileDataSource::GetMipHeight(uint32_t mip) const
+{
+    return std::max(m_height >> mip, 1u);
+}
+
+uint32_t TileDataSource::GetMipDepth(uint32_t mip) const
+{
+    return std::max(m_depth >> mip, 1u);
+}
+
+void TileDataSource::CopyTileRows(const uint8_t* mipBase, uint64_t mipRowPitch, uint64_t mipDepthPitch, const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch) const
+{
+    // Tiles at the edge of non-pow2 textures can extend past the mip, only copy the blocks that exist
+    uint32_t mipWidth = GetMipWidth(tile.mip);
+    uint32_t mipHeight = GetMipHeight(tile.mip);
+    uint32_t widthInTexels = std::min(tile.widthInTexels, mipWidth - std::min(tile.xInTexels, mipWidth));
+    uint32_t heightInTexels = std::min(tile.heightInTexels, mipHeight - std::min(tile.yInTexels, mipHeight));
+    uint32_t mipDepth = GetMipDepth(tile.mip);
+    uint32_t depthInTexels = std::min(tile.depthInTexels, mipDepth - std::min(tile.zInTexels, mipDepth));
+
+    uint32_t rowBytes = GetRowPitch(widthInTexels);
+    uint32_t blockRows = (heightInTexels + m_blockSize - 1) / m_blockSize;
+    uint64_t sourceOffset = uint64_t(tile.zInTexels) * mipDepthPitch + uint64_t(tile.yInTexels / m_blockSize) * mipRowPitch + uint64_t(tile.xInTexels / m_blockSize) * m_bytesPerBlock;
+
+    for (uint32_t z = 0; z < depthInTexels; z++)
+    {
+        for (uint32_t blockRow = 0; blockRow < blockRows; blockRow++)
+            memcpy(dest + z * destDepthPitch + uint64_t(blockRow) * destRowPitch, mipBase + sourceOffset + z * mipDepthPitch + uint64_t(blockRow) * mipRowPitch, rowBytes);
+    }
+}
+
+bool TileDataSource::FindUniformBlock(const uint8_t* mipBase, uint64_t mipRowPitch, const nvfeedback::FeedbackTextureTileInfo& tile, std::vector<uint8_t>& block) const
+{
+    uint32_t mipWidth = GetMipWidth(tile.mip);
+    uint32_t mipHeight = GetMipHeight(tile.mip);
+    uint32_t widthInTexels = std::min(tile.widthInTexels, mipWidth - std::min(tile.xInTexels, mipWidth));
+    uint32_t heightInTexels = std::min(tile.heightInTexels, mipHeight - std::min(tile.yInTexels, mipHeight));
+    if (widthInTexels == 0 || heightInTexels == 0)
+        return false;
+
+    uint32_t rowBytes = GetRowPitch(widthInTexels);
+    uint32_t blockRows = (heightInTexels + m_blockSize - 1) / m_blockSize;
+    const uint8_t* first = mipBase + uint64_t(tile.yInTexels / m_blockSize) * mipRowPitch + uint64_t(tile.xInTexels / m_blockSize) * m_bytesPerBlock;
+
+    for (uint32_t blockRow = 0; blockRow < blockRows; blockRow++)
+    {
+        const uint8_t* row = first + uint64_t(blockRow) * mipRowPitch;
+        if (memcmp(row, first, m_bytesPerBlock) != 0 || !tilestream::IsUniformData(row, rowBytes, m_bytesPerBlock))
+            return false;
+    }
+
+    block.assign(first, first + m_bytesPerBlock);
+    return true;
+}
+
+TextureDataTileSource::TextureDataTileSource(std::shared_ptr<TextureData> textureData)
+    : TileDataSource(textureData->format, textureData->width, textureData->height, textureData->depth, textureData->arraySize, textureData->mipLevels)
+    , m_textureData(textureData)
+{
+}
+
+bool TextureDataTileSource::ReadTile(const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch)
+{
+    if (!m_textureData->data || tile.arraySlice >= m_arraySize || tile.mip >= m_mipLevels)
+        return false;
+
+    const TextureSubresourceData& layout = m_textureData->dataLayout[tile.arraySlice][tile.mip];
+    const uint8_t* mipBase = static_cast<const uint8_t*>(m_textureData->data->data()) + layout.dataOffset;
+    CopyTileRows(mipBase, layout.rowPitch, layout.depthPitch, tile, dest, destRowPitch, destDepthPitch);
+
+    return true;
+}
+
+bool TextureDataTileSource::GetUniformTileBlock(const nvfeedback::FeedbackTextureTileInfo& tile, std::vector<uint8_t>& block)
+{
+    // Only tiles of 2D textures are checked
+    if (!m_textureData->data || tile.arraySlice >= m_arraySize || tile.mip >= m_mipLevels || tile.depthInTexels != 1)
+        return false;
+
+    const TextureSubresourceData& layout = m_textureData->dataLayout[tile.arraySlice][tile.mip];
+    const uint8_t* mipBase = static_cast<const uint8_t*>(m_textureData->data->data()) + layout.dataOffset;
+    return FindUniformBlock(mipBase, layout.rowPitch, tile, block);
+}
+
+MappedDdsTileSource::MappedDdsTileSource(nvrhi::Format format, uint32_t width, uint32_t height, uint32_t depth, uint32_t arraySize, uint32_t mipLevels)
+    : TileDataSource(format, width, height, depth, arraySize, mipLevels)
+{
+}
+
+std::shared_ptr<MappedDdsTileSource> MappedDdsTileSource::Create(const std::filesystem::path& path, const TextureData& textureData)
+{
+    auto source = std::make_shared<MappedDdsTileSource>(textureData.format, textureData.width, textureData.height, textureData.depth, textureData.arraySize, textureData.mipLevels);
+
+    if (!source->m_file.Open(path))
+        return nullptr;
+
+    tilestream::DdsTextureInfo& info = source->m_ddsInfo;
+    if (!tilestream::ParseDdsFile(source->m_file.GetData(), source->m_file.GetSize(), info))
+        return nullptr;
+
+    // The texture cache may have changed the format, e.g. to sRGB, which is fine as long as the memory layout is the same
+    bool layoutMatches = info.width == textureData.width && info.height == textureData.height &&
+        info.depth == textureData.depth && info.arraySize >= textureData.arraySize && info.mipLevels >= textureData.mipLevels &&
+        info.blockSize == source->m_blockSize && info.bytesPerBlock == source->m_bytesPerBlock;
+    if (!layoutMatches)
+    {
+        log::warning("DDS file '%s' does not match the loaded texture, streaming from memory instead", path.generic_string().c_str());
+        return nullptr;
+    }
+
+    return source;
+}
+
+bool MappedDdsTileSource::ReadTile(const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch)
+{
+    if (tile.arraySlice >= m_arraySize || tile.mip >= m_mipLevels)
+        return false;
+
+    const tilestream::DdsSubresourceLayout& layout = m_ddsInfo.subresources[tile.arraySlice * m_ddsInfo.mipLevels + tile.mip];
+    CopyTileRows(m_file.GetData() + layout.dataOffset, layout.rowPitch, layout.slicePitch, tile, dest, destRowPitch, destDepthPitch);
+
+    return true;
+}
+
+TilePackTileSource::TilePackTileSource(nvrhi::Format format, uint32_t width, uint32_t height, uint32_t depth, uint32_t arraySize, uint32_t mipLevels)
+    : TileDataSource(format, width, height, depth, arraySize, mipLevels)
+{
+}
+
+std::shared_ptr<TilePackTileSource> TilePackTileSource::Create(const std::filesystem::path& path, const TextureData& textureData)
+{
+    auto source = std::make_shared<TilePackTileSource>(textureData.format, textureData.width, textureData.height, textureData.depth, textureData.arraySize, textureData.mipLevels);
+
+    if (!source->m_reader.Open(path))
+        return nullptr;
+
+    const tilestream::TilePackHeader& header = source->m_reader.GetHeader();
+
+    // Packs transcoded from an RGBA8 texture are streamed in their BC format
+    nvrhi::Format transcodedFormat;
+    bool isRgba8 = textureData.format == nvrhi::Format::RGBA8_UNORM || textureData.format == nvrhi::Format::SRGBA8_UNORM;
+    if (isRgba8 && GetTranscodedFormat(header.dxgiFormat, transcodedFormat))
+        source->SetFormat(transcodedFormat);
+
+    // Tile packs only hold 2D textures
+    bool layoutMatches = header.width == textureData.width && header.height == textureData.height && textureData.depth == 1 &&
+        header.arraySize >= textureData.arraySize && header.mipLevels >= textureData.mipLevels &&
+        header.blockSize == source->m_blockSize && header.bytesPerBlock == source->m_bytesPerBlock;
+    if (!layoutMatches)
+    {
+        log::warning("Tile pack '%s' does not match the loaded texture, ignoring it", path.generic_string().c_str());
+        return nullptr;
+    }
+
+    return source;
+}
+
+bool TilePackTileSource::ReadTile(const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch)
+{
+    if (tile.arraySlice >= m_arraySize || tile.mip >= m_mipLevels)
+        return false;
+
+    tilestream::TileRegion region = { tile.arraySlice, tile.mip, tile.xInTexels, tile.yInTexels, tile.widthInTexels, tile.heightInTexels };
+    return m_reader.ReadRegion(region, dest, destRowPitch);
+}
+
+bool TilePackTileSource::GetStoredTile(const nvfeedback::FeedbackTextureTileInfo& tile, StoredTileRange& range)
+{
+    tilestream::TileRegion region = { tile.arraySlice, tile.mip, tile.xInTexels, tile.yInTexels, tile.widthInTexels, tile.heightInTexels };
+    const tilestream::TilePackTileEntry* storedTile = m_reader.FindStoredTile(region);
+    if (!storedTile)
+        return false;
+
+    range.file = &m_reader.GetFile();
+    range.offset = storedTile->offset;
+    range.storedSize = storedTile->storedSize;
+    range.size = storedTile->size;
+    range.flags = storedTile->flags;
+    range.dxgiFormat = m_reader.GetHeader().dxgiFormat;
+    return true;
+}
+
+bool TilePackTileSource::GetTileContentHash(const nvfeedback::FeedbackTextureTileInfo& tile, uint64_t& contentHash)
+{
+    tilestream::TileRegion region = { tile.arraySlice, tile.mip, tile.xInTexels, tile.yInTexels, tile.widthInTexels, tile.heightInTexels };
+    const tilestream::TilePackTileEntry* storedTile = m_reader.FindStoredTile(region);
+    if (!storedTile)
+        return false;
+
+    contentHash = storedTile->contentHash;
+    return true;
+}
+
+bool TilePackTileSource::GetUniformTileBlock(const nvfeedback::FeedbackTextureTileInfo& tile, std::vector<uint8_t>& block)
+{
+    tilestream::TileRegion region = { tile.arraySlice, tile.mip, tile.xInTexels, tile.yInTexels, tile.widthInTexels, tile.heightInTexels };
+    const tilestream::TilePackTileEntry* storedTile = m_reader.FindStoredTile(region);
+    return storedTile && m_reader.ReadUniformBlock(*storedTile, block);
+}
+
+std::shared_ptr<TileDataSource> CreateTileDataSource(std::shared_ptr<TextureData> textureData, const std::filesystem::path& nativePath)
+{
+    if (!nativePath.empty())
+    {
+        std::shared_ptr<TilePackTileSource> tilePackSource = TilePackTileSource::Create(std::filesystem::path(nativePath).replace_extension(".tilepack"), *textureData);
+        if (tilePackSource)
+            return tilePackSource;
+
+        std::shared_ptr<MappedDdsTileSource> mappedSource = MappedDdsTileSource::Create(nativePath, *textureData);
+        if (mappedSource)
+            return mappedSource;
+    }
+
+    if (!textureData->data)
+        return nullptr;
+
+    return std::make_shared<TextureDataTileSource>(textureData);
+}
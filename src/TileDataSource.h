@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <donut/engine/TextureCache.h>
+#include <nvrhi/nvrhi.h>
+#include <filesystem>
+#include <memory>
+
+#include "feedbackmanager/include/FeedbackManager.h"
+#include "tilestream/DdsFile.h"
+#include "tilestream/MappedFile.h"
+#include "tilestream/TilePack.h"
+
+// A tile stored contiguously in a file, possibly compressed
+struct StoredTileRange
+{
+    const tilestream::ReadOnlyFile* file = nullptr;
+    uint64_t offset = 0;
+    uint32_t storedSize = 0;
+    uint32_t size = 0;  // Size after decoding
+    uint32_t flags = 0; // Encoding, see tilestream/TileCodec.h
+    uint32_t dxgiFormat = 0; // Format tiles stored in the intermediate form are transcoded to
+};
+
+// Provides the texel data of a tiled texture one tile or packed mip at a time from a texture file or its decoded data.
+// Data is returned tightly packed in rows of blocks, as expected by the upload paths.
+class TileDataSource : public nvfeedback::TileDataProvider
+{
+public:
+    TileDataSource(nvrhi::Format format, uint32_t width, uint32_t height, uint32_t depth, uint32_t arraySize, uint32_t mipLevels);
+    virtual ~TileDataSource() {}
+
+    // Reads the tile synchronously on the calling worker thread
+    void RequestTile(const nvfeedback::TileDataRequest& request, const nvfeedback::TileDataCompletion& onComplete) override;
+
+    // Copies the blocks covered by a tile to dest, using destRowPitch bytes per row of blocks and destDepthPitch bytes per depth slice
+    virtual bool ReadTile(const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch) = 0;
+
+    // Returns true if the source reads from the decoded data of the donut TextureData
+    virtual bool UsesTextureData() const = 0;
+
+    // Returns the file range holding a tile in its upload layout, if the tile can be read with one file read and decoded on its own
+    virtual bool GetStoredTile(const nvfeedback::FeedbackTextureTileInfo& tile, StoredTileRange& range) { return false; }
+
+    nvrhi::Format GetFormat() const { return m_format; }
+    uint32_t GetBlockSize() const { return m_blockSize; }
+    uint32_t GetBytesPerBlock() const { return m_bytesPerBlock; }
+
+    // Tightly packed pitch and size of a tile or a mip level
+    uint32_t GetRowPitch(uint32_t widthInTexels) const;
+    uint64_t GetSizeInBytes(uint32_t widthInTexels, uint32_t heightInTexels) const;
+    uint64_t GetMipSizeInBytes(uint32_t mip) const;
+    uint32_t GetMipWidth(uint32_t mip) const;
+    uint32_t GetMipHeight(uint32_t mip) const;
+    uint32_t GetMipDepth(uint32_t mip) const;
+
+protected:
+    void SetFormat(nvrhi::Format format);
+
+    // Copies the rows of blocks of a tile from a mip level stored with the given row and depth pitch
+    void CopyTileRows(const uint8_t* mipBase, uint64_t mipRowPitch, uint64_t mipDepthPitch, const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch) const;
+
+    // Returns the block of a tile whose blocks in a mip level stored with the given row pitch are all the same
+    bool FindUniformBlock(const uint8_t* mipBase, uint64_t mipRowPitch, const nvfeedback::FeedbackTextureTileInfo& tile, std::vector<uint8_t>& block) const;
+
+    nvrhi::Format m_format;
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_depth;
+    uint32_t m_arraySize;
+    uint32_t m_mipLevels;
+    uint32_t m_blockSize;
+    uint32_t m_bytesPerBlock;
+};
+
+// Reads tiles from the fully decoded texture data kept in RAM by the texture cache
+class TextureDataTileSource : public TileDataSource
+{
+public:
+    TextureDataTileSource(std::shared_ptr<donut::engine::TextureData> textureData);
+
+    bool ReadTile(const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch) override;
+    bool UsesTextureData() const override { return true; }
+    bool GetUniformTileBlock(const nvfeedback::FeedbackTextureTileInfo& tile, std::vector<uint8_t>& block) override;
+
+private:
+    std::shared_ptr<donut::engine::TextureData> m_textureData;
+};
+
+// Reads tiles directly from a memory mapped DDS file. Only the pages containing the rows of
+// requested tiles are read from disk, so the decoded texture does not need to stay in RAM.
+class MappedDdsTileSource : public TileDataSource
+{
+public:
+    // Returns nullptr if the file can't be mapped or doesn't match the layout of the texture
+    static std::shared_ptr<MappedDdsTileSource> Create(const std::filesystem::path& path, const donut::engine::TextureData& textureData);
+
+    MappedDdsTileSource(nvrhi::Format format, uint32_t width, uint32_t height, uint32_t depth, uint32_t arraySize, uint32_t mipLevels);
+
+    bool ReadTile(const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch) override;
+    bool UsesTextureData() const override { return false; }
+
+private:
+    tilestream::MappedFile m_file;
+    tilestream::DdsTextureInfo m_ddsInfo;
+};
+
+// Reads tiles from a tile pack created by the tilepack tool. Tiles matching the stored tiles take one contiguous read.
+// Packs transcoded from an RGBA8 texture provide the tiles in their BC format, see GetFormat.
+class TilePackTileSource : public TileDataSource
+{
+public:
+    // Returns nullptr if the file can't be opened or doesn't match the layout of the texture
+    static std::shared_ptr<TilePackTileSource> Create(const std::filesystem::path& path, const donut::engine::TextureData& textureData);
+
+    TilePackTileSource(nvrhi::Format format, uint32_t width, uint32_t height, uint32_t depth, uint32_t arraySize, uint32_t mipLevels);
+
+    bool ReadTile(const nvfeedback::FeedbackTextureTileInfo& tile, uint8_t* dest, uint32_t destRowPitch, uint64_t destDepthPitch) override;
+    bool UsesTextureData() const override { return false; }
+    bool GetStoredTile(const nvfeedback::FeedbackTextureTileInfo& tile, StoredTileRange& range) override;
+    bool GetTileContentHash(const nvfeedback::FeedbackTextureTileInfo& tile, uint64_t& contentHash) override;
+    bool GetUniformTileBlock(const nvfeedback::FeedbackTextureTileInfo& tile, std::vector<uint8_t>& block) override;
+
+private:
+    tilestream::TilePackReader m_reader;
+};
+
+// Creates the source for a tiled texture. A tile pack next to the texture file is preferred, then the memory
+// mapped texture file, falling back to the texture data.
+std::shared_ptr<TileDataSource> CreateTileDataSource(std::shared_ptr<donut::engine::TextureData> textureData, const std::filesystem::path& nativePath);
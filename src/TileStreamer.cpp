@@ -0,0 +1,338 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "TileStreamer.h"
+#include "TileDataSource.h"
+#include "tilestream/TileCodec.h"
+#include "tilestream/TileTranscoder.h"
+
+#include <chrono>
+#include <string.h>
+
+TileStreamer::TileStreamer(const tilestream::IoSchedulerDesc& desc)
+    : m_scheduler(desc)
+{
+}
+
+TileStreamer::~TileStreamer()
+{
+    std::vector<std::unique_ptr<StreamedTiles>> discarded;
+    Flush(discarded);
+}
+
+uint32_t TileStreamer::GetRowPitch(nvfeedback::FeedbackTexture* texture, uint32_t widthInTexels)
+{
+    const nvrhi::FormatInfo& formatInfo = nvrhi::getFormatInfo(texture->GetReservedTexture()->getDesc().format);
+    return ((widthInTexels + formatInfo.blockSize - 1) / formatInfo.blockSize) * formatInfo.bytesPerBlock;
+}
+
+uint64_t TileStreamer::GetSizeInBytes(nvfeedback::FeedbackTexture* texture, uint32_t widthInTexels, uint32_t heightInTexels, uint32_t depthInTexels)
+{
+    const nvrhi::FormatInfo& formatInfo = nvrhi::getFormatInfo(texture->GetReservedTexture()->getDesc().format);
+    return uint64_t(GetRowPitch(texture, widthInTexels)) * ((heightInTexels + formatInfo.blockSize - 1) / formatInfo.blockSize) * depthInTexels;
+}
+
+void TileStreamer::RequestTile(nvfeedback::FeedbackTexture* texture, uint32_t tileIndex, uint32_t uploadSlot, uint8_t* uploadData)
+{
+    Request* request = new Request();
+    request->provider = texture->GetTileDataProvider();
+    request->tiles = std::make_unique<StreamedTiles>();
+
+    StreamedTiles& tiles = *request->tiles;
+    tiles.texture = texture;
+    tiles.tileIndices.push_back(tileIndex);
+    tiles.uploadSlot = uploadSlot;
+
+    // Tile info comes from the tiled texture manager which is only used on this thread
+    texture->GetTileInfo(tileIndex, tiles.tiles);
+    const nvfeedback::FeedbackTextureTileInfo& tile = tiles.tiles[0];
+    tiles.rowPitch = GetRowPitch(texture, tile.widthInTexels);
+    tiles.depthPitch = GetSizeInBytes(texture, tile.widthInTexels, tile.heightInTexels);
+    uint32_t size = uint32_t(GetSizeInBytes(texture, tile.widthInTexels, tile.heightInTexels, tile.depthInTexels));
+
+    // Copies out of the upload buffer need aligned rows. The rows of standard 2D tiles are, the shorter rows of volume
+    // tiles are padded, and the tile is read into memory of its own when that no longer fits in the slot.
+    if (texture->IsVolume() && tiles.rowPitch % UploadRowPitchAlignment != 0)
+    {
+        uint64_t rowsOfBlocks = tiles.depthPitch / tiles.rowPitch;
+        tiles.rowPitch = (tiles.rowPitch + UploadRowPitchAlignment - 1) / UploadRowPitchAlignment * UploadRowPitchAlignment;
+        tiles.depthPitch = tiles.rowPitch * rowsOfBlocks;
+        size = uint32_t(tiles.depthPitch * tile.depthInTexels);
+        if (size > UploadSlotSizeInBytes)
+        {
+            tiles.stagedData.resize(size);
+            uploadData = tiles.stagedData.data();
+        }
+    }
+
+    tilestream::IoRequest& ioRequest = request->ioRequest;
+    ioRequest.dest = uploadData;
+    ioRequest.size = size;
+
+    if (!request->provider)
+    {
+        ioRequest.task = []() { return false; };
+        Submit(request);
+        return;
+    }
+
+    nvfeedback::TileDataRequest& tileRequest = request->tileRequest;
+    tileRequest.texture = texture;
+    tileRequest.tileIndex = tileIndex;
+    tileRequest.tile = tile;
+    tileRequest.dest = uploadData;
+    tileRequest.destRowPitch = tiles.rowPitch;
+    tileRequest.destDepthPitch = tiles.depthPitch;
+    tileRequest.destSizeInBytes = size;
+
+    // Asks the provider for the tile on a worker thread. With a tile cache the tile is gathered in memory owned
+    // by the request first, the upload slot is write combined and slow to read back from.
+    nvfeedback::FeedbackManager* tileCache = m_tileCache;
+    auto requestFromProvider = [this, request, tileCache](tilestream::IoRequest* ioRequest)
+    {
+        nvfeedback::TileDataRequest tileRequest = request->tileRequest;
+        if (tileCache)
+        {
+            request->storedData.resize(size_t(tileRequest.destSizeInBytes));
+            tileRequest.dest = request->storedData.data();
+        }
+
+        request->provider->RequestTile(tileRequest, [this, request, ioRequest, tileCache](bool success)
+        {
+            const nvfeedback::TileDataRequest& tileRequest = request->tileRequest;
+            if (success && tileCache)
+            {
+                memcpy(tileRequest.dest, request->storedData.data(), request->storedData.size());
+                tileCache->WriteCachedTile(tileRequest.texture, tileRequest.tileIndex, tileRequest.tile.mip, request->refetchCost, std::move(request->storedData));
+            }
+            m_scheduler.CompleteRequest(ioRequest, success);
+        });
+    };
+
+    // Tiles from decoded texture data kept in memory are cheap to read again, others come from a file
+    TileDataSource* source = dynamic_cast<TileDataSource*>(request->provider.get());
+    request->refetchCost = source && source->UsesTextureData() ? nvfeedback::TileRefetchCost::Memory : nvfeedback::TileRefetchCost::Disk;
+
+    // Tiles evicted recently are copied from the system memory tile cache, falling back to the provider if they were dropped meanwhile
+    if (tileCache && tileCache->LookupCachedTile(texture, tileIndex, tile.mip))
+    {
+        ioRequest.asyncTask = [this, request, tileCache, requestFromProvider](tilestream::IoRequest* ioRequest)
+        {
+            const nvfeedback::TileDataRequest& tileRequest = request->tileRequest;
+            if (tileCache->ReadCachedTile(tileRequest.texture, tileRequest.tileIndex, tileRequest.dest, size_t(tileRequest.destSizeInBytes)))
+            {
+                m_tilesFromCache++;
+                m_scheduler.CompleteRequest(ioRequest, true);
+                return;
+            }
+            requestFromProvider(ioRequest);
+        };
+
+        Submit(request);
+        return;
+    }
+
+    // Tiles stored contiguously in a file are read by the scheduler, which merges neighbouring reads
+    StoredTileRange range;
+    if (source && source->GetStoredTile(tile, range))
+    {
+        ioRequest.file = range.file;
+        ioRequest.offset = range.offset;
+        ioRequest.size = range.storedSize;
+
+        if (range.flags != 0 || tileCache)
+        {
+            // Compressed tiles and tiles to keep in the tile cache are read into memory owned by the request,
+            // then decoded or copied on a worker thread into the upload slot
+            request->storedData.resize(range.storedSize);
+            ioRequest.dest = request->storedData.data();
+            ioRequest.postProcess = [this, tileCache, texture, tileIndex, mip = tile.mip, range, storedData = &request->storedData, uploadData, elementSize = source->GetBytesPerBlock()]()
+            {
+                // Without a tile cache, compressed tiles are decoded straight into the upload slot
+                std::vector<uint8_t> data;
+                if (range.flags != 0)
+                {
+                    uint8_t* dest = uploadData;
+                    if (tileCache)
+                    {
+                        data.resize(range.size);
+                        dest = data.data();
+                    }
+
+                    auto startTime = std::chrono::steady_clock::now();
+                    bool success;
+                    if (range.flags & tilestream::TileFlagTranscode)
+                    {
+                        success = tilestream::TranscodeTile(range.flags, range.dxgiFormat, m_transcodeQuality, storedData->data(), range.storedSize, dest, range.size);
+                        m_tilesTranscoded++;
+                    }
+                    else
+                        success = tilestream::DecodeTile(range.flags, elementSize, storedData->data(), range.storedSize, dest, range.size);
+                    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+
+                    m_decodeNanoseconds += uint64_t(duration.count());
+                    m_tilesDecoded++;
+                    m_bytesDecoded += range.size;
+                    if (!success)
+                        return false;
+                }
+                else
+                {
+                    // Uncompressed tiles are only read into memory to be cached, hand it over as is
+                    data = std::move(*storedData);
+                }
+
+                if (tileCache)
+                {
+                    memcpy(uploadData, data.data(), data.size());
+                    nvfeedback::TileRefetchCost cost = nvfeedback::TileRefetchCost::Disk;
+                    if (range.flags & tilestream::TileFlagTranscode)
+                        cost = nvfeedback::TileRefetchCost::Transcode;
+                    else if (range.flags != 0)
+                        cost = nvfeedback::TileRefetchCost::Decode;
+                    tileCache->WriteCachedTile(texture, tileIndex, mip, cost, std::move(data));
+                }
+                return true;
+            };
+        }
+    }
+    else
+    {
+        ioRequest.asyncTask = requestFromProvider;
+    }
+
+    Submit(request);
+}
+
+void TileStreamer::RequestPackedMips(nvfeedback::FeedbackTexture* texture, const std::vector<uint32_t>& tileIndices)
+{
+    Request* request = new Request();
+    request->provider = texture->GetTileDataProvider();
+    request->tiles = std::make_unique<StreamedTiles>();
+
+    StreamedTiles& tiles = *request->tiles;
+    tiles.texture = texture;
+    tiles.tileIndices = tileIndices;
+    tiles.isPacked = true;
+
+    // All packed tiles share the same mips, so the mips of the first one cover all of them
+    texture->GetTileInfo(tileIndices[0], tiles.tiles);
+
+    uint64_t sizeInBytes = 0;
+    for (const nvfeedback::FeedbackTextureTileInfo& tile : tiles.tiles)
+    {
+        tiles.packedOffsets.push_back(sizeInBytes);
+        tiles.packedRowPitches.push_back(GetRowPitch(texture, tile.widthInTexels));
+        sizeInBytes += GetSizeInBytes(texture, tile.widthInTexels, tile.heightInTexels, tile.depthInTexels);
+    }
+    tiles.packedData.resize(sizeInBytes);
+
+    tilestream::IoRequest& ioRequest = request->ioRequest;
+    ioRequest.size = uint32_t(sizeInBytes);
+
+    if (!request->provider || tiles.tiles.empty())
+    {
+        ioRequest.task = []() { return false; };
+        Submit(request);
+        return;
+    }
+
+    // Every packed mip is a request to the provider, the last one to complete finishes the read
+    ioRequest.asyncTask = [this, request](tilestream::IoRequest* ioRequest)
+    {
+        StreamedTiles& tiles = *request->tiles;
+        request->numPendingParts = uint32_t(tiles.tiles.size());
+
+        for (size_t i = 0; i < tiles.tiles.size(); i++)
+        {
+            uint64_t partEnd = i + 1 < tiles.tiles.size() ? tiles.packedOffsets[i + 1] : tiles.packedData.size();
+
+            nvfeedback::TileDataRequest tileRequest = {};
+            tileRequest.texture = tiles.texture;
+            tileRequest.tileIndex = tiles.tileIndices[0];
+            tileRequest.tile = tiles.tiles[i];
+            tileRequest.dest = tiles.packedData.data() + tiles.packedOffsets[i];
+            tileRequest.destRowPitch = tiles.packedRowPitches[i];
+            tileRequest.destDepthPitch = GetSizeInBytes(tiles.texture, tileRequest.tile.widthInTexels, tileRequest.tile.heightInTexels);
+            tileRequest.destSizeInBytes = partEnd - tiles.packedOffsets[i];
+
+            request->provider->RequestTile(tileRequest, [this, request, ioRequest](bool success)
+            {
+                if (!success)
+                    request->partFailed = true;
+                if (--request->numPendingParts == 0)
+                    m_scheduler.CompleteRequest(ioRequest, !request->partFailed);
+            });
+        }
+    };
+
+    Submit(request);
+}
+
+void TileStreamer::Submit(Request* request)
+{
+    request->ioRequest.userData = request;
+    m_scheduler.Submit(&request->ioRequest);
+    m_numRequests++;
+}
+
+void TileStreamer::Dispatch()
+{
+    m_scheduler.Dispatch();
+}
+
+void TileStreamer::GetCompletedTiles(std::vector<std::unique_ptr<StreamedTiles>>& completed)
+{
+    tilestream::IoRequest* ioRequest = m_scheduler.PopCompleted();
+    while (ioRequest)
+    {
+        tilestream::IoRequest* next = ioRequest->next;
+
+        Request* request = static_cast<Request*>(ioRequest->userData);
+        request->tiles->success = ioRequest->success;
+        completed.push_back(std::move(request->tiles));
+        delete request;
+        m_numRequests--;
+
+        ioRequest = next;
+    }
+}
+
+void TileStreamer::Flush(std::vector<std::unique_ptr<StreamedTiles>>& completed)
+{
+    m_scheduler.CancelPending();
+    m_scheduler.WaitIdle();
+    GetCompletedTiles(completed);
+}
+
+TileStreamerStats TileStreamer::GetStats() const
+{
+    tilestream::IoSchedulerStats schedulerStats = m_scheduler.GetStats();
+
+    TileStreamerStats stats;
+    stats.bytesInFlight = schedulerStats.bytesInFlight;
+    stats.requestsPending = schedulerStats.requestsPending;
+    stats.requestsInFlight = m_numRequests - schedulerStats.requestsPending;
+    stats.readsIssued = schedulerStats.readsIssued;
+    stats.requestsCoalesced = schedulerStats.requestsCoalesced;
+    stats.requestsFailed = schedulerStats.requestsFailed;
+    stats.tilesDecoded = m_tilesDecoded;
+    stats.bytesDecoded = m_bytesDecoded;
+    stats.tilesTranscoded = m_tilesTranscoded;
+    stats.tilesFromCache = m_tilesFromCache;
+    return stats;
+}
+
+double TileStreamer::TakeDecodeTime()
+{
+    return double(m_decodeNanoseconds.exchange(0)) * 1e-9;
+}
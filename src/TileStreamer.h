@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "feedbackmanager/include/FeedbackManager.h"
+#include "tilestream/BcEncoder.h"
+#include "tilestream/IoScheduler.h"
+
+// A tile, or all packed mips of a texture, read by the TileStreamer
+struct StreamedTiles
+{
+    nvfeedback::FeedbackTexture* texture = nullptr;
+    std::vector<uint32_t> tileIndices;
+    std::vector<nvfeedback::FeedbackTextureTileInfo> tiles;
+    bool isPacked = false;
+    bool success = false;
+
+    // Regular tiles are read into an upload slot
+    uint32_t uploadSlot = 0;
+    uint32_t rowPitch = 0;
+    uint64_t depthPitch = 0; // Volume tiles hold their depth slices one after another
+    std::vector<uint8_t> stagedData; // Volume tiles too large for a slot with aligned rows are read here instead
+
+    // Packed mips are read into memory, one tightly packed subresource after the other
+    std::vector<uint8_t> packedData;
+    std::vector<uint64_t> packedOffsets;
+    std::vector<uint32_t> packedRowPitches;
+};
+
+struct TileStreamerStats
+{
+    uint64_t bytesInFlight = 0;
+    uint32_t requestsPending = 0;
+    uint32_t requestsInFlight = 0;
+    uint64_t readsIssued = 0;
+    uint64_t requestsCoalesced = 0;
+    uint64_t requestsFailed = 0;
+    uint64_t tilesDecoded = 0;
+    uint64_t bytesDecoded = 0;
+    uint64_t tilesTranscoded = 0;
+    uint64_t tilesFromCache = 0;
+};
+
+// Reads tile data asynchronously between the tile requests of the FeedbackManager and UpdateTileMappings.
+// Tiles come from the TileDataProvider registered with each FeedbackTexture, which is called on the I/O worker threads.
+// Tiles of TileDataSources stored contiguously in a file are read by the I/O scheduler instead, which merges neighbouring
+// reads. Compressed tiles are decoded on the worker threads before going to their upload slot, tiles stored in an
+// intermediate form are transcoded to the BC format of the texture there as well.
+// With a tile cache set, every tile read is also kept in system memory and later requests for it are copied from there.
+// Tiles are handed back to the render thread once their data has arrived.
+class TileStreamer
+{
+public:
+    TileStreamer(const tilestream::IoSchedulerDesc& desc);
+    ~TileStreamer();
+
+    // Sets the FeedbackManager whose tile cache regular tiles are read from and written to, nullptr disables caching.
+    // Must be changed only while no tiles are in flight.
+    void SetTileCache(nvfeedback::FeedbackManager* feedbackManager) { m_tileCache = feedbackManager; }
+
+    // Encoding quality of stored tiles transcoded from an intermediate form, applies to the tiles decoded from then on.
+    // Packed mips and other regions read through the tile data provider use the quality of their TilePackReader.
+    void SetTranscodeQuality(tilestream::BcQuality quality) { m_transcodeQuality = quality; }
+
+    // Size of the upload slots, one tiled resource tile
+    static constexpr uint32_t UploadSlotSizeInBytes = 64 * 1024;
+
+    // Row pitch alignment of texture copies from a buffer, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+    static constexpr uint32_t UploadRowPitchAlignment = 256;
+
+    // Reads a regular tile into the memory of an upload slot
+    void RequestTile(nvfeedback::FeedbackTexture* texture, uint32_t tileIndex, uint32_t uploadSlot, uint8_t* uploadData);
+
+    // Reads all packed mips of a texture
+    void RequestPackedMips(nvfeedback::FeedbackTexture* texture, const std::vector<uint32_t>& tileIndices);
+
+    // Issues the requested reads, as allowed by the cap of bytes in flight
+    void Dispatch();
+
+    // Appends the tiles whose reads completed, successfully or not, since the last call
+    void GetCompletedTiles(std::vector<std::unique_ptr<StreamedTiles>>& completed);
+
+    // Cancels all requests which haven't been issued and waits for the others, then returns all of them
+    void Flush(std::vector<std::unique_ptr<StreamedTiles>>& completed);
+
+    // Tightly packed rows of blocks of a tile or mip level, the layout tiles are read in
+    static uint32_t GetRowPitch(nvfeedback::FeedbackTexture* texture, uint32_t widthInTexels);
+    static uint64_t GetSizeInBytes(nvfeedback::FeedbackTexture* texture, uint32_t widthInTexels, uint32_t heightInTexels, uint32_t depthInTexels = 1);
+
+    const char* GetBackendName() const { return m_scheduler.GetBackendName(); }
+    TileStreamerStats GetStats() const;
+
+    // Returns the time spent decoding and transcoding tiles on all worker threads since the last call, in seconds
+    double TakeDecodeTime();
+
+private:
+    struct Request
+    {
+        tilestream::IoRequest ioRequest;
+        std::unique_ptr<StreamedTiles> tiles;
+        std::shared_ptr<nvfeedback::TileDataProvider> provider;
+        nvfeedback::TileDataRequest tileRequest = {};
+        std::vector<uint8_t> storedData; // Tiles read into memory before decoding or caching
+        nvfeedback::TileRefetchCost refetchCost = nvfeedback::TileRefetchCost::Disk;
+
+        // Packed mips are requested from the provider one mip level at a time
+        std::atomic<uint32_t> numPendingParts = 0;
+        std::atomic<bool> partFailed = false;
+    };
+
+    void Submit(Request* request);
+
+    tilestream::IoScheduler m_scheduler;
+    uint32_t m_numRequests = 0;
+    nvfeedback::FeedbackManager* m_tileCache = nullptr;
+
+    // Updated by the worker threads
+    std::atomic<uint64_t> m_decodeNanoseconds = 0;
+    std::atomic<uint64_t> m_tilesDecoded = 0;
+    std::atomic<uint64_t> m_bytesDecoded = 0;
+    std::atomic<uint64_t> m_tilesTranscoded = 0;
+    std::atomic<uint64_t> m_tilesFromCache = 0;
+    std::atomic<tilestream::BcQuality> m_transcodeQuality = tilestream::BcQuality::Normal;
+};
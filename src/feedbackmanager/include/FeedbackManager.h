@@ -15,30 +15,102 @@
 #include <stdint.h>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <nvrhi/nvrhi.h>
 
 namespace nvfeedback
 {
+    class FeedbackTexture;
     class FeedbackTextureSet;
 
     struct FeedbackTextureTileInfo
     {
+        uint32_t arraySlice;
         uint32_t mip;
         uint32_t xInTexels;
         uint32_t yInTexels;
+        uint32_t zInTexels = 0;      // Only volume textures have tiles deeper than one texel
         uint32_t widthInTexels;
         uint32_t heightInTexels;
+        uint32_t depthInTexels = 1;
 
         bool operator==(const FeedbackTextureTileInfo& b) const
         {
-            return mip == b.mip &&
+            return arraySlice == b.arraySlice &&
+                mip == b.mip &&
                 xInTexels == b.xInTexels &&
                 yInTexels == b.yInTexels &&
+                zInTexels == b.zInTexels &&
                 widthInTexels == b.widthInTexels &&
-                heightInTexels == b.heightInTexels;
+                heightInTexels == b.heightInTexels &&
+                depthInTexels == b.depthInTexels;
         }
     };
 
+    // A rectangle in normalized texture coordinates
+    struct FeedbackUvRect
+    {
+        float minU = 0.0f;
+        float minV = 0.0f;
+        float maxU = 1.0f;
+        float maxV = 1.0f;
+    };
+
+    // A view contributing feedback, such as a split-screen player, a planar reflection or a shadow map
+    struct FeedbackViewDesc
+    {
+        float weight = 1.0f;      // Detail relative to the main view, requests of the view are made log2(1 / weight) mips coarser
+        float budgetShare = 1.0f; // Relative share of the tiles to stream when several views request tiles
+    };
+
+    // Relative cost of reading a tile again once it is dropped from the tile cache
+    enum class TileRefetchCost : uint8_t
+    {
+        Memory,     // Copied from texture data kept in memory
+        Disk,       // Read from a file
+        Decode,     // Read from a file and decompressed
+        Transcode   // Read from a file and transcoded to the BC format of the texture
+    };
+
+    // Mip levels tracked separately in statistics, coarser mips are counted in the last one
+    constexpr uint32_t StatsMipLevels = 16;
+
+    // Views contributing feedback, including the main view 0
+    constexpr uint32_t MaxFeedbackViews = 256;
+
+    // A request for the texel data of a regular tile, or of one packed mip level
+    struct TileDataRequest
+    {
+        FeedbackTexture* texture;
+        uint32_t tileIndex;
+        FeedbackTextureTileInfo tile; // Mip level and texel rectangle, from FeedbackTexture::GetTileInfo
+        uint8_t* dest;                // Staging memory receiving the rows of blocks of the tile
+        uint32_t destRowPitch;        // Bytes between rows of blocks in dest
+        uint64_t destDepthPitch;      // Bytes between depth slices in dest, for volume textures
+        uint64_t destSizeInBytes;
+    };
+
+    // Signals the end of a TileDataRequest, called exactly once per request from any thread
+    typedef std::function<void(bool success)> TileDataCompletion;
+
+    // Produces the texel data of a FeedbackTexture on demand, for example from files, procedurally or by transcoding.
+    // The streaming code calls it from its worker threads, requests may complete before returning or later.
+    class TileDataProvider
+    {
+    public:
+        virtual ~TileDataProvider() {}
+
+        virtual void RequestTile(const TileDataRequest& request, const TileDataCompletion& onComplete) = 0;
+
+        // Returns a hash of the content of a regular tile if it is known without reading the tile, called on the render thread.
+        // Tiles with the same hash are treated as identical and may be filled by copying each other on the GPU.
+        virtual bool GetTileContentHash(const FeedbackTextureTileInfo& tile, uint64_t& contentHash) { return false; }
+
+        // Returns the block repeated over a regular tile of a single color, if known without reading the whole tile.
+        // Called on the render thread for every tile when the provider is set.
+        virtual bool GetUniformTileBlock(const FeedbackTextureTileInfo& tile, std::vector<uint8_t>& block) { return false; }
+    };
+
     // A tiled texture with sampler feedback
     class FeedbackTexture
     {
@@ -48,12 +120,38 @@ namespace nvfeedback
 
         virtual nvrhi::TextureHandle GetReservedTexture() = 0;
         virtual nvrhi::SamplerFeedbackTextureHandle GetSamplerFeedbackTexture() = 0;
-        virtual nvrhi::TextureHandle GetMinMipTexture() = 0;
+        virtual nvrhi::TextureHandle GetMinMipTexture() = 0; // One array slice per slice of the reserved texture
         virtual bool IsTilePacked(uint32_t tileIndex) = 0;
+
+        // Tile indices span all array slices, the tiles of each slice follow those of the previous one.
+        // Each slice has its own packed mip tiles after its regular tiles.
         virtual void GetTileInfo(uint32_t tileIndex, std::vector<FeedbackTextureTileInfo>& tiles) = 0;
 
+        // Returns true if the most recent sampler feedback readback requested any part of this texture
+        virtual bool IsVisible() = 0;
+
         virtual uint32_t GetNumTextureSets() const = 0;
         virtual FeedbackTextureSet* GetTextureSet(uint32_t index) const = 0;
+
+        // The provider of the texel data of this texture, used by the application to stream tiles
+        virtual void SetTileDataProvider(std::shared_ptr<TileDataProvider> provider) = 0;
+        virtual std::shared_ptr<TileDataProvider> GetTileDataProvider() const = 0;
+
+        // Volume textures have no sampler feedback, their tiles are requested with FeedbackManager::RequestVolumeRegion
+        virtual bool IsVolume() const = 0;
+
+        // Uniform tiles repeat a single block, as reported by the provider. The FeedbackManager maps them to a constant
+        // tile holding that block instead of returning them to be streamed.
+        virtual bool IsTileUniform(uint32_t tileIndex) = 0;
+
+        // Keeps every tile of this mip level and the coarser ones resident. They are requested right away and never evicted,
+        // bounding the quality of the fallback for missing finer tiles. Levels past the regular mips only keep the packed mips.
+        virtual void SetResidentMipFloor(uint32_t mip) = 0;
+        virtual uint32_t GetResidentMipFloor() const = 0;
+
+        // Feedback regions per array slice, the layout of the min mip grids of FeedbackManager::InjectFeedbackMinMips
+        virtual uint32_t GetFeedbackRegionsX() const = 0;
+        virtual uint32_t GetFeedbackRegionsY() const = 0;
     };
 
     // A collection of FeedbackTextures with shared lifetime
@@ -81,6 +179,24 @@ namespace nvfeedback
         uint32_t tilesTotal;            // Total number of tiles tracked in all textures
         uint32_t tilesAllocated;        // Number of tiles allocated in heaps
         uint32_t tilesStandby;          // Number of tiles in the standby queue
+        uint64_t tileCacheSizeInBytes;  // Tile data held in the system memory tile cache
+        uint32_t tileCacheTiles;        // Number of tiles held in the system memory tile cache
+        uint64_t tileCacheHits;         // Total tile cache lookups which found the tile
+        uint64_t tileCacheMisses;       // Total tile cache lookups which did not find the tile
+        uint64_t tileCacheHitsByMip[StatsMipLevels];   // Tile cache hits by mip level of the tile
+        uint64_t tileCacheMissesByMip[StatsMipLevels]; // Tile cache misses by mip level of the tile
+        uint32_t tilesDuplicate;        // Resident tiles with the same content as another resident tile
+        uint64_t tilesShared;           // Total tiles filled by copying a resident tile with the same content instead of reading them
+        uint32_t tilesUniform;          // Resident uniform tiles mapped to a constant tile instead of being uploaded
+        uint32_t constantTiles;         // Constant tiles holding the blocks of uniform tiles, per format and block
+        uint32_t tilesVolume;           // Tiles of volume textures allocated in heaps
+        uint32_t smallTextures;         // Fully resident small textures placed in shared pages
+        uint64_t smallTexturePageBytes; // Memory of the shared pages holding small textures
+        uint64_t tilesThrashed;         // Total tiles requested again within thrashWindowFrames of being unmapped
+        uint64_t tilesThrashedByMip[StatsMipLevels]; // Thrashed tiles by mip level
+        uint64_t tilesPrefetched;       // Total tiles returned as prefetch requests, which sampler feedback did not request
+        uint32_t tilesPinned;           // Regular tiles kept resident by the resident mip floor of their texture
+        uint32_t prefetchHints;         // Prefetch hints which have not expired yet
 
         double cputimeBeginFrame;
         double cputimeUpdateTileMappings;
@@ -92,16 +208,24 @@ namespace nvfeedback
         uint32_t frameIndex; // Current frame index, must fall within the range of 0-numFramesInFlight
         uint32_t maxTexturesToUpdate; // Max textures to update, 0=unlimited
         float tileTimeoutSeconds; // Timeout of tile allocation in seconds
+        std::vector<float> tileTimeoutSecondsByMip; // Timeout of tiles by mip level, mips past the end use tileTimeoutSeconds
+        uint32_t mipHysteresisLevels; // Regions whose requested mip coarsens by up to this many levels keep their finer tiles for twice the timeout
+        uint32_t thrashWindowFrames; // Tiles requested again within this many frames of being unmapped are counted as thrashed, 0=disabled
         bool defragmentHeaps; // Enable defragmentation of heaps
         bool trimStandbyTiles; // Enables trimming of standby tiles to the target number
         bool releaseEmptyHeaps; // Release empty heaps
         uint32_t numExtraStandbyTiles; // Target number of tiles to keep in standby before being evicted
+        bool predictTiles; // Requests tiles ahead of the motion of each texture's feedback as prefetch tiles while the camera moves
+        float cameraPosition[3]; // World space camera position, the predictor only runs on frames it changes
     };
 
     struct FeedbackTextureUpdate
     {
         FeedbackTexture* texture;
         std::vector<uint32_t> tileIndices;
+        bool isPrefetch = false; // Tiles only requested ahead of time, stream them with a lower priority than the others
+        float deadlineSeconds = 0.0f; // Prefetch tiles are due in this many seconds, FLT_MAX for tiles without a prefetch hint
+        uint32_t view = 0; // The view with the finest request for the tiles, see FeedbackManager::CreateFeedbackView
     };
 
     struct FeedbackTextureCollection
@@ -113,6 +237,10 @@ namespace nvfeedback
     {
         uint32_t numFramesInFlight; // Number of frames in flight, affects the latency of readback
         uint32_t heapSizeInTiles; // The size of each heap in tiles
+        uint64_t tileCacheSizeInBytes; // Capacity of the system memory tile cache, 0=disabled
+        uint64_t smallTextureSizeInBytes; // Textures whose mip chain is no larger are small textures, 0=disabled
+        uint32_t residentMipLevels; // Coarsest regular mips of every new texture kept resident, see FeedbackTexture::SetResidentMipFloor
+        uint32_t cameraCutBurstFrames; // Frames of streaming burst after NotifyCameraCut
     };
 
     // FeedbackManager interfaces between application code using NVRHI and the RTXTS library
@@ -121,16 +249,24 @@ namespace nvfeedback
     public:
         virtual ~FeedbackManager() {};
 
-        // Creates a FeedbackTexture
+        // Creates a FeedbackTexture, fails if the format is not supported by IsTiledFormatSupported.
+        // Texture3D descs create volume textures, which can't be part of texture sets.
         virtual bool CreateTexture(const nvrhi::TextureDesc& desc, FeedbackTexture** ppTex) = 0;
 
+        // Small textures gain nothing from streaming. CreateSmallTexture creates them fully resident, placed in shared heap
+        // pages owned by the FeedbackManager, and returns nullptr if that fails. The caller uploads their data. Their memory
+        // is reused a few frames after the last reference held by the application is released.
+        virtual bool IsSmallTexture(const nvrhi::TextureDesc& desc) = 0;
+        virtual nvrhi::TextureHandle CreateSmallTexture(const nvrhi::TextureDesc& desc) = 0;
+
         // Creates an empty FeedbackTextureSet
         virtual bool CreateTextureSet(FeedbackTextureSet** ppTexSet) = 0;
 
         // Call at the beginning of the frame. Reads back the feedback resources from N frames ago.
         virtual void BeginFrame(nvrhi::ICommandList* commandList, const FeedbackUpdateConfig& config, FeedbackTextureCollection* results) = 0;
 
-        // Call for tiles which ready to have their data filled on this frame's GPU timeline
+        // Call for tiles which ready to have their data filled on this frame's GPU timeline.
+        // Also maps the tiles accepted by ShareTile and records the copies filling them.
         virtual void UpdateTileMappings(nvrhi::ICommandList* commandList, FeedbackTextureCollection* tilesReady) = 0;
 
         // After rendering, resolve the sampler feedback maps
@@ -141,8 +277,83 @@ namespace nvfeedback
 
         // Returns statistics of the operations performed during this frame
         virtual FeedbackManagerStats GetStats() = 0;
+
+        // System memory tile cache. Keeps recently loaded tile data so that tiles evicted from the heaps
+        // can be restored without reading them again. These functions may be called from any thread.
+
+        // Returns true if the tile data is cached and counts a cache hit or miss for the mip level of the tile
+        virtual bool LookupCachedTile(FeedbackTexture* texture, uint32_t tileIndex, uint32_t mip) = 0;
+
+        // Copies the cached tile data to dest, returns false if it is no longer cached or the size does not match
+        virtual bool ReadCachedTile(FeedbackTexture* texture, uint32_t tileIndex, void* dest, size_t size) = 0;
+
+        // Stores the tile data. When the cache is full, the tile cheapest to bring back among the least recently used ones
+        // is evicted first, weighing the cost of reading it again, its mip level and the time since it was last used.
+        virtual void WriteCachedTile(FeedbackTexture* texture, uint32_t tileIndex, uint32_t mip, TileRefetchCost cost, std::vector<uint8_t>&& data) = 0;
+
+        // Tile sharing. Mapped tiles whose TileDataProvider knows their content hash are registered, requested tiles with the
+        // same content as a resident tile are then filled with a GPU copy of it. Heap space is still reserved for every tile.
+
+        // Returns true if a resident tile of another subresource has the same content as the requested tile. The tile is then
+        // mapped and copied by the next UpdateTileMappings call and must not be requested from the provider.
+        virtual bool ShareTile(FeedbackTexture* texture, uint32_t tileIndex) = 0;
+
+        // Call for tiles returned by BeginFrame whose data could not be read. They stay allocated and a BeginFrame at least
+        // a second later returns them again, unless they are unmapped first.
+        virtual void RetryTiles(FeedbackTexture* texture, const std::vector<uint32_t>& tileIndices) = 0;
+
+        // Requests the tiles of a volume texture covering a box of one mip level, and the tiles of the coarser mips below it.
+        // This takes the place of sampler feedback for volume textures and is called every frame the region is needed,
+        // the next BeginFrame returns the tiles to stream. Tiles no longer requested for tileTimeoutSeconds are unmapped.
+        virtual void RequestVolumeRegion(FeedbackTexture* texture, const FeedbackTextureTileInfo& region) = 0;
+
+        // Prefetch hints request tiles ahead of time, for example along a scripted camera path or before a level transition.
+        // The tiles covering the UV rectangle at the mip level and the coarser mips, of all array slices, stay requested until
+        // the deadline in seconds from now plus the tile timeout, and are then released unless sampler feedback requests them.
+        // They are returned as prefetch tiles, ordered by deadline. Volume textures cover their full depth.
+        virtual void PrefetchRegion(FeedbackTexture* texture, uint32_t mip, const FeedbackUvRect& uvRect, float deadlineSeconds) = 0;
+        virtual void PrefetchTexture(FeedbackTexture* texture, uint32_t mip, float deadlineSeconds) = 0;
+
+        // Residency snapshots warm start streaming in a later session. SaveResidencySnapshot writes the mips mapped or requested
+        // per feedback region of every texture created with a unique debug name, such as the texture path, and
+        // LoadResidencySnapshot requests them again as prefetch hints due in deadlineSeconds for the textures with the same
+        // debug name and size. Textures sharing a debug name are left out.
+        // Returns the number of textures restored, volume textures are not part of snapshots.
+        virtual void SaveResidencySnapshot(std::vector<uint8_t>& data) = 0;
+        virtual uint32_t LoadResidencySnapshot(const std::vector<uint8_t>& data, float deadlineSeconds) = 0;
+
+        // Injected feedback requests tiles for texture accesses without sampler feedback, such as shadow, reflection, compute
+        // or ray tracing passes and gameplay queries. Until the next BeginFrame requests are merged as the finest mip per
+        // feedback region, then with the last sampler feedback of the texture, and are held for the tile timeout like it.
+        // InjectFeedback requests the UV rectangle at the mip level in all array slices, volume textures cover their full depth.
+        // InjectFeedbackMinMips takes one mip per feedback region of every array slice, row major, 0xFF if not requested.
+        virtual void InjectFeedback(FeedbackTexture* texture, uint32_t mip, const FeedbackUvRect& uvRect) = 0;
+        virtual void InjectFeedbackMinMips(FeedbackTexture* texture, const uint8_t* minMipData, size_t regionsNum) = 0;
+
+        // Several views can request tiles of the same texture without multiplying the readback cost. View 0 is the main view.
+        // Views drawn with sampler feedback write into the same feedback textures as the main view. They pass their mip bias
+        // to WriteSamplerFeedbackBias and count as view 0. Views without sampler feedback, or whose feedback the application
+        // reads back itself at a lower resolution, merge their min mip grids on the CPU with InjectViewFeedbackMinMips.
+        // Tiles to stream are returned per view, with the views interleaved by their budget shares.
+        virtual bool CreateFeedbackView(const FeedbackViewDesc& desc, uint32_t* pView) = 0;
+        virtual void SetFeedbackViewDesc(uint32_t view, const FeedbackViewDesc& desc) = 0;
+        virtual void DestroyFeedbackView(uint32_t view) = 0;
+        virtual float GetFeedbackViewMipBias(uint32_t view) = 0;
+        virtual void InjectViewFeedbackMinMips(uint32_t view, FeedbackTexture* texture, const uint8_t* minMipData, size_t regionsNum) = 0;
+
+        // Call before BeginFrame on the first frame rendered from a new viewpoint. Feedback resolved before the cut is discarded,
+        // all textures are read back at once, tiles held for the previous view are released on their next readback, and for
+        // cameraCutBurstFrames the tiles to stream are returned coarsest mips first across all textures.
+        virtual void NotifyCameraCut() = 0;
+
+        // Returns true while the burst after a camera cut lasts, the application should raise its upload budget meanwhile
+        virtual bool IsCameraCutBurst() = 0;
     };
 
+    // Returns true if textures of the format can be created with FeedbackManager::CreateTexture. This needs a standard
+    // 64 KiB tile shape, which all block compressed and most uncompressed color formats have except 96 bit ones.
+    bool IsTiledFormatSupported(nvrhi::Format format);
+
     // Creates a FeedbackManager
     FeedbackManager* CreateFeedbackManager(nvrhi::IDevice* device, const FeedbackManagerDesc& desc);
 }
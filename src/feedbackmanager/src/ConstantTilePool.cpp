@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "ConstantTilePool.h"
+
+#include <d3d12.h>
+#include <string.h>
+
+namespace nvfeedback
+{
+    namespace
+    {
+        // Atlas textures are this many tiles wide
+        constexpr uint32_t AtlasTilesX = 8;
+    }
+
+    ConstantTilePool::ConstantTilePool(nvrhi::IDevice* device, uint32_t tilesPerFormat) :
+        m_device(device),
+        m_tilesPerFormat((tilesPerFormat + AtlasTilesX - 1) / AtlasTilesX * AtlasTilesX)
+    {
+    }
+
+    void ConstantTilePool::CreateFormatPool(nvrhi::Format format, FormatPool& pool)
+    {
+        const nvrhi::FormatInfo& formatInfo = nvrhi::getFormatInfo(format);
+        pool.bytesPerBlock = formatInfo.bytesPerBlock;
+
+        // 64 KiB standard tiles are square in blocks, or twice as wide as high
+        uint32_t blocksPerTile = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES / pool.bytesPerBlock;
+        uint32_t log2Blocks = 0;
+        while ((1u << (log2Blocks + 1)) <= blocksPerTile)
+            log2Blocks++;
+        pool.tileHeightInBlocks = 1u << (log2Blocks / 2);
+        pool.tileWidthInBlocks = blocksPerTile / pool.tileHeightInBlocks;
+
+        uint32_t atlasTilesY = m_tilesPerFormat / AtlasTilesX;
+        nvrhi::TextureDesc textureDesc = {};
+        textureDesc.width = pool.tileWidthInBlocks * formatInfo.blockSize * AtlasTilesX;
+        textureDesc.height = pool.tileHeightInBlocks * formatInfo.blockSize * atlasTilesY;
+        textureDesc.format = format;
+        textureDesc.isTiled = true;
+        textureDesc.initialState = nvrhi::ResourceStates::ShaderResource;
+        textureDesc.keepInitialState = true;
+        textureDesc.debugName = "Constant tile atlas";
+        pool.atlas = m_device->createTexture(textureDesc);
+        if (!pool.atlas)
+            return;
+
+        // The formula above must match the tiling of the device, else the pool stays disabled for the format
+        uint32_t numTiles = 0;
+        uint32_t mipLevels = 1;
+        nvrhi::PackedMipDesc packedMipDesc = {};
+        nvrhi::TileShape tileShape = {};
+        nvrhi::SubresourceTiling tiling = {};
+        m_device->getTextureTiling(pool.atlas, &numTiles, &packedMipDesc, &tileShape, &mipLevels, &tiling);
+        if (tileShape.widthInTexels != pool.tileWidthInBlocks * formatInfo.blockSize ||
+            tileShape.heightInTexels != pool.tileHeightInBlocks * formatInfo.blockSize ||
+            tiling.widthInTiles != AtlasTilesX || tiling.heightInTiles != atlasTilesY)
+        {
+            pool.atlas = nullptr;
+            return;
+        }
+
+        nvrhi::HeapDesc heapDesc = {};
+        heapDesc.capacity = uint64_t(m_tilesPerFormat) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        heapDesc.type = nvrhi::HeapType::DeviceLocal;
+        heapDesc.debugName = "Constant tile heap";
+        pool.heap = m_device->createHeap(heapDesc);
+        if (!pool.heap)
+            return;
+
+        // Atlas tiles stay mapped to their heap tile for the lifetime of the pool
+        std::vector<nvrhi::TiledTextureCoordinate> tiledTextureCoordinates(m_tilesPerFormat);
+        std::vector<nvrhi::TiledTextureRegion> tiledTextureRegions(m_tilesPerFormat);
+        std::vector<uint64_t> byteOffsets(m_tilesPerFormat);
+        for (uint32_t i = 0; i < m_tilesPerFormat; i++)
+        {
+            tiledTextureCoordinates[i] = {};
+            tiledTextureCoordinates[i].x = i % AtlasTilesX;
+            tiledTextureCoordinates[i].y = i / AtlasTilesX;
+            tiledTextureRegions[i] = {};
+            tiledTextureRegions[i].tilesNum = 1;
+            byteOffsets[i] = uint64_t(i) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        }
+
+        nvrhi::TextureTilesMapping textureTilesMapping = {};
+        textureTilesMapping.numTextureRegions = m_tilesPerFormat;
+        textureTilesMapping.tiledTextureCoordinates = tiledTextureCoordinates.data();
+        textureTilesMapping.tiledTextureRegions = tiledTextureRegions.data();
+        textureTilesMapping.byteOffsets = byteOffsets.data();
+        textureTilesMapping.heap = pool.heap;
+        m_device->updateTextureTileMappings(pool.atlas, &textureTilesMapping, 1);
+
+        pool.rowPitch = pool.tileWidthInBlocks * AtlasTilesX * pool.bytesPerBlock;
+        pool.atlasData.resize(size_t(pool.rowPitch) * pool.tileHeightInBlocks * atlasTilesY);
+        pool.valid = true;
+    }
+
+    bool ConstantTilePool::GetTile(nvrhi::Format format, const std::vector<uint8_t>& block, nvrhi::HeapHandle& heap, uint64_t& byteOffset)
+    {
+        auto formatIt = m_formats.find(format);
+        if (formatIt == m_formats.end())
+        {
+            formatIt = m_formats.emplace(format, FormatPool()).first;
+            CreateFormatPool(format, formatIt->second);
+        }
+
+        FormatPool& pool = formatIt->second;
+        if (!pool.valid || block.size() != pool.bytesPerBlock)
+            return false;
+
+        auto it = pool.tiles.find(block);
+        if (it == pool.tiles.end())
+        {
+            if (pool.tiles.size() == m_tilesPerFormat)
+                return false;
+
+            // Fill the atlas tile with the block, it is uploaded before any texture samples it
+            uint32_t tileIndex = uint32_t(pool.tiles.size());
+            uint32_t blockX = (tileIndex % AtlasTilesX) * pool.tileWidthInBlocks;
+            uint32_t blockY = (tileIndex / AtlasTilesX) * pool.tileHeightInBlocks;
+            for (uint32_t y = 0; y < pool.tileHeightInBlocks; y++)
+            {
+                uint8_t* row = pool.atlasData.data() + size_t(blockY + y) * pool.rowPitch + size_t(blockX) * pool.bytesPerBlock;
+                for (uint32_t x = 0; x < pool.tileWidthInBlocks; x++)
+                    memcpy(row + x * pool.bytesPerBlock, block.data(), pool.bytesPerBlock);
+            }
+
+            it = pool.tiles.emplace(block, tileIndex).first;
+            pool.dirty = true;
+            m_numTiles++;
+        }
+
+        heap = pool.heap;
+        byteOffset = uint64_t(it->second) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        return true;
+    }
+
+    void ConstantTilePool::Update(nvrhi::ICommandList* commandList)
+    {
+        for (auto& pair : m_formats)
+        {
+            FormatPool& pool = pair.second;
+            if (!pool.dirty)
+                continue;
+
+            commandList->writeTexture(pool.atlas, 0, 0, pool.atlasData.data(), pool.rowPitch);
+            pool.dirty = false;
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+#include <nvrhi/nvrhi.h>
+
+namespace nvfeedback
+{
+    // Tiles filled with a single repeated block, one for each format and block, shared by the uniform tiles of all textures.
+    // Every format has a small heap whose tiles are mapped to a tiled atlas texture of that format, blocks are written
+    // through the atlas and the heap tiles are then mapped into the uniform tiles of the textures.
+    class ConstantTilePool
+    {
+    public:
+        ConstantTilePool(nvrhi::IDevice* device, uint32_t tilesPerFormat);
+
+        // Returns the heap tile holding the block, adding it if the pool of the format is not full
+        bool GetTile(nvrhi::Format format, const std::vector<uint8_t>& block, nvrhi::HeapHandle& heap, uint64_t& byteOffset);
+
+        // Uploads the blocks of the tiles added since the last call
+        void Update(nvrhi::ICommandList* commandList);
+
+        uint32_t GetNumTiles() const { return m_numTiles; }
+
+    private:
+        struct FormatPool
+        {
+            bool valid = false;
+            nvrhi::HeapHandle heap;
+            nvrhi::TextureHandle atlas;
+            uint32_t tileWidthInBlocks = 0;
+            uint32_t tileHeightInBlocks = 0;
+            uint32_t bytesPerBlock = 0;
+            uint32_t rowPitch = 0;
+            std::vector<uint8_t> atlasData;
+            std::map<std::vector<uint8_t>, uint32_t> tiles;
+            bool dirty = false;
+        };
+
+        void CreateFormatPool(nvrhi::Format format, FormatPool& pool);
+
+        nvrhi::DeviceHandle m_device;
+        uint32_t m_tilesPerFormat;
+        uint32_t m_numTiles = 0;
+        std::map<nvrhi::Format, FormatPool> m_formats;
+    };
+}
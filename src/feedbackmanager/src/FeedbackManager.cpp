@@ -12,7 +12,12 @@
 
 #include "../include/FeedbackManager.h"
 #include "FeedbackManagerInternal.h"
+#include "FeedbackMerge.h"
+#include "ResidencySnapshot.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <map>
 #include <assert.h>
 
@@ -21,18 +26,48 @@ namespace nvfeedback
     FeedbackManagerImpl::FeedbackManagerImpl(nvrhi::IDevice* device, const FeedbackManagerDesc& desc) :
         m_device(device),
         m_desc(desc),
+        m_updateConfigThisFrame(),
         m_numFramesInFlight(desc.numFramesInFlight),
         m_frameIndex(0),
-        m_statsLastFrame()
+        m_frameNumber(0),
+        m_statsLastFrame(),
+        m_tilesShared(0),
+        m_tilesUniform(0),
+        m_tilesThrashed(0),
+        m_tilesThrashedByMip(),
+        m_tilesPrefetched(0),
+        m_tilesPinned(0),
+        m_cameraPosition(),
+        m_cameraMoved(false),
+        m_staleReadbackFrames(0),
+        m_cameraCutBurstFramesLeft(0),
+        m_cameraCutBurst(false),
+        m_readbackAllTextures(false)
     {
         m_texturesToReadback.resize(m_numFramesInFlight);
         ZeroMemory(&m_statsLastFrame, sizeof(FeedbackManagerStats));
 
+        // The main view always exists, sampler feedback and InjectFeedback request tiles for it
+        m_views.push_back({ FeedbackViewDesc(), true });
+
         m_heapAllocator = std::make_shared<HeapAllocator>(m_device, desc.heapSizeInTiles * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES, desc.numFramesInFlight);
 
         rtxts::TiledTextureManagerDesc tiledTextureManagerDesc = {};
         tiledTextureManagerDesc.heapTilesCapacity = desc.heapSizeInTiles;
         m_tiledTextureManager = std::shared_ptr<rtxts::TiledTextureManager>(CreateTiledTextureManager(tiledTextureManagerDesc));
+        m_volumeTiles = std::make_unique<VolumeTileAllocator>(m_heapAllocator.get(), desc.heapSizeInTiles);
+
+        // Shard the tile cache so I/O threads filling it in parallel rarely wait on each other
+        const uint32_t tileCacheShards = 16;
+        m_tileCache = std::make_unique<TileCache>(desc.tileCacheSizeInBytes, tileCacheShards);
+
+        // Uniform tiles rarely have more than a few distinct blocks per format
+        const uint32_t constantTilesPerFormat = 64;
+        m_constantTiles = std::make_unique<ConstantTilePool>(m_device, constantTilesPerFormat);
+
+        // Pages of 4 MiB, holding 64 small textures at the usual 64 KiB placement alignment
+        const uint64_t smallTexturePageSizeInBytes = 64 * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        m_smallTextures = std::make_unique<SmallTexturePool>(m_device, smallTexturePageSizeInBytes, m_numFramesInFlight);
     }
 
     FeedbackManagerImpl::~FeedbackManagerImpl()
@@ -41,13 +76,47 @@ namespace nvfeedback
 
     bool FeedbackManagerImpl::CreateTexture(const nvrhi::TextureDesc& desc, FeedbackTexture** ppTex)
     {
+        if (!IsTiledFormatSupported(desc.format))
+        {
+            *ppTex = nullptr;
+            return false;
+        }
+
         FeedbackTextureImpl* feedbackTexture = new FeedbackTextureImpl(desc, this, m_tiledTextureManager.get(), m_device, m_numFramesInFlight);
         m_textures.push_back(feedbackTexture);
-        m_texturesRingbuffer.push_back(feedbackTexture);
+        if (!feedbackTexture->IsVolume())
+            m_texturesRingbuffer.push_back(feedbackTexture);
+
+        if (m_desc.residentMipLevels > 0)
+        {
+            uint32_t numStandardMips = feedbackTexture->GetPackedMipInfo().numStandardMips;
+            feedbackTexture->SetResidentMipFloor(numStandardMips - std::min(m_desc.residentMipLevels, numStandardMips));
+        }
         *ppTex = feedbackTexture;
         return true;
     }
 
+    bool FeedbackManagerImpl::IsSmallTexture(const nvrhi::TextureDesc& desc)
+    {
+        if (m_desc.smallTextureSizeInBytes == 0 || desc.dimension == nvrhi::TextureDimension::Texture3D)
+            return false;
+
+        const nvrhi::FormatInfo& formatInfo = nvrhi::getFormatInfo(desc.format);
+        uint64_t sizeInBytes = 0;
+        for (uint32_t mip = 0; mip < desc.mipLevels; mip++)
+        {
+            uint32_t widthInBlocks = (std::max(desc.width >> mip, 1u) + formatInfo.blockSize - 1) / formatInfo.blockSize;
+            uint32_t heightInBlocks = (std::max(desc.height >> mip, 1u) + formatInfo.blockSize - 1) / formatInfo.blockSize;
+            sizeInBytes += uint64_t(widthInBlocks) * heightInBlocks * formatInfo.bytesPerBlock;
+        }
+        return sizeInBytes * std::max(desc.arraySize, 1u) <= m_desc.smallTextureSizeInBytes;
+    }
+
+    nvrhi::TextureHandle FeedbackManagerImpl::CreateSmallTexture(const nvrhi::TextureDesc& desc)
+    {
+        return m_smallTextures->CreateTexture(desc);
+    }
+
     bool FeedbackManagerImpl::CreateTextureSet(FeedbackTextureSet** ppTexSet)
     {
         if (!ppTexSet)
@@ -77,6 +146,45 @@ namespace nvfeedback
         auto it = std::find(m_minMipDirtyTextures.begin(), m_minMipDirtyTextures.end(), feedbackTexture);
         if (it != m_minMipDirtyTextures.end())
             m_minMipDirtyTextures.erase(it);
+
+        // Volume textures have no sampler feedback and no resolve buffers
+        if (!feedbackTexture->IsVolume())
+        {
+            for (uint32_t i = 0; i < m_numFramesInFlight; i++)
+                ReleaseResolveBuffer(feedbackTexture->TakeFeedbackResolveBuffer(i));
+        }
+
+        m_tileCache->RemoveTexture(feedbackTexture);
+
+        m_sharedTiles.RemoveTexture(feedbackTexture);
+        m_uniformTilesToMap.erase(feedbackTexture);
+        m_tilesPinned -= feedbackTexture->GetNumResidentFloorTiles();
+        m_prefetchHints.erase(std::remove_if(m_prefetchHints.begin(), m_prefetchHints.end(), [feedbackTexture](const PrefetchHint& hint)
+            {
+                return hint.texture == feedbackTexture;
+            }), m_prefetchHints.end());
+        m_injectedTextures.erase(feedbackTexture);
+        for (auto it = m_retryTiles.begin(); it != m_retryTiles.end();)
+            it = it->first.first == feedbackTexture ? m_retryTiles.erase(it) : std::next(it);
+        for (uint32_t tileIndex = 0; tileIndex < feedbackTexture->GetNumTiles(); tileIndex++)
+        {
+            if (feedbackTexture->IsTileMappedToConstant(tileIndex))
+                m_tilesUniform--;
+        }
+        if (feedbackTexture->IsVolume())
+        {
+            for (uint32_t tileIndex = 0; tileIndex < feedbackTexture->GetNumTiles(); tileIndex++)
+            {
+                VolumeTile& tile = feedbackTexture->GetVolumeTile(tileIndex);
+                if (tile.state != VolumeTileState::Unmapped)
+                    m_volumeTiles->Free(tile.heapId, tile.heapTileIndex);
+            }
+        }
+
+        m_sharedTileCopies.erase(std::remove_if(m_sharedTileCopies.begin(), m_sharedTileCopies.end(), [feedbackTexture](const SharedTileCopy& copy)
+            {
+                return copy.texture == feedbackTexture || copy.sourceTexture == feedbackTexture;
+            }), m_sharedTileCopies.end());
     }
 
     void FeedbackManagerImpl::UpdateTextureRingBufferState(FeedbackTextureImpl* pTex, bool includeInRingBuffer)
@@ -97,65 +205,129 @@ namespace nvfeedback
         m_timerBeginFrame.Begin();
 
         m_frameIndex = config.frameIndex % m_numFramesInFlight;
+        m_frameNumber++;
 
         m_updateConfigThisFrame = config;
 
+        // Predictions only run while the camera moves, a still camera has settled feedback
+        m_cameraMoved = false;
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            m_cameraMoved |= config.cameraPosition[i] != m_cameraPosition[i];
+            m_cameraPosition[i] = config.cameraPosition[i];
+        }
+
+        m_cameraCutBurst = m_cameraCutBurstFramesLeft > 0;
+        if (m_cameraCutBurst)
+            m_cameraCutBurstFramesLeft--;
+
+        // Feedback resolved before a camera cut is read back during the following frames in flight and describes the old view
+        bool discardReadbacks = m_staleReadbackFrames > 0;
+        if (discardReadbacks)
+            m_staleReadbackFrames--;
+
         rtxts::TiledTextureManagerConfig tiledTextureManagerConfig = {};
         tiledTextureManagerConfig.numExtraStandbyTiles = config.numExtraStandbyTiles;
         m_tiledTextureManager->SetConfig(tiledTextureManagerConfig);
 
+        ExpirePrefetchHints(float(GetTickCount64()) / 1000.0f);
+
         auto& readbackTextures = m_texturesToReadback[m_frameIndex];
         if (!readbackTextures.empty())
         {
             float timeStamp = float(GetTickCount64()) / 1000.0f;
+            std::vector<uint8_t> requestedMips;
+            std::vector<uint8_t> heldMipData;
             uint32_t texturesNum = uint32_t(readbackTextures.size());
             for (uint32_t iReadbackTexture = 0; iReadbackTexture < texturesNum; ++iReadbackTexture)
             {
                 FeedbackTextureImpl* readbackTexture = readbackTextures[iReadbackTexture];
-                uint8_t* pReadbackData = (uint8_t*)m_device->mapBuffer(readbackTexture->GetFeedbackResolveBuffer(m_frameIndex), nvrhi::CpuAccessMode::Read);
+                if (discardReadbacks)
+                {
+                    ReleaseResolveBuffer(readbackTexture->TakeFeedbackResolveBuffer(m_frameIndex));
+                    continue;
+                }
 
-                rtxts::SamplerFeedbackDesc samplerFeedbackDesc = {};
-                samplerFeedbackDesc.pMinMipData = (uint8_t*)(pReadbackData);
-                m_tiledTextureManager->UpdateWithSamplerFeedback(readbackTexture->GetTiledTextureId(), samplerFeedbackDesc, timeStamp, m_updateConfigThisFrame.tileTimeoutSeconds);
+                nvrhi::BufferHandle resolveBuffer = readbackTexture->GetFeedbackResolveBuffer(m_frameIndex);
+                uint8_t* pReadbackData = (uint8_t*)m_device->mapBuffer(resolveBuffer, nvrhi::CpuAccessMode::Read);
+
+                // The feedback of every array slice updates the tiled texture of that slice. Timeouts are applied per mip
+                // by the held region mips, so the tiled texture manager releases every tile they no longer request.
+                size_t regionsNum = size_t(resolveBuffer->getDesc().byteSize);
+                size_t sliceRegionsNum = regionsNum / readbackTexture->GetNumSlices();
+                readbackTexture->SetFeedbackMips(pReadbackData, regionsNum);
+                requestedMips.assign(pReadbackData, pReadbackData + regionsNum);
+                MergeInjectedMips(readbackTexture, requestedMips);
+                m_injectedTextures.erase(readbackTexture);
+                if (m_updateConfigThisFrame.predictTiles && m_cameraMoved)
+                    PredictRequestedMips(readbackTexture, requestedMips);
+                HoldRequestedMips(readbackTexture, requestedMips.data(), regionsNum, timeStamp, heldMipData);
+                for (uint32_t slice = 0; slice < readbackTexture->GetNumSlices(); slice++)
+                {
+                    rtxts::SamplerFeedbackDesc samplerFeedbackDesc = {};
+                    samplerFeedbackDesc.pMinMipData = heldMipData.data() + slice * sliceRegionsNum;
+                    m_tiledTextureManager->UpdateWithSamplerFeedback(readbackTexture->GetTiledTextureId(slice), samplerFeedbackDesc, timeStamp, 0.0f);
+                }
+
+                // Any region with a requested mip level means the texture was sampled on screen
+                bool isVisible = std::any_of(pReadbackData, pReadbackData + regionsNum, [](uint8_t minMip) { return minMip != 0xFF; });
+                readbackTexture->SetVisible(isVisible);
 
-                m_device->unmapBuffer(readbackTexture->GetFeedbackResolveBuffer(m_frameIndex));
+                m_device->unmapBuffer(resolveBuffer);
+                ReleaseResolveBuffer(readbackTexture->TakeFeedbackResolveBuffer(m_frameIndex));
 
                 // If this is a primary texture, make followers match its state
-                if (readbackTexture->IsPrimaryTexture())
+                UpdateFollowerTextures(readbackTexture, timeStamp);
+            }
+        }
+
+        // Feedback injected for textures not read back on this frame is merged with their last readback
+        if (!m_injectedTextures.empty())
+        {
+            float timeStamp = float(GetTickCount64()) / 1000.0f;
+            std::vector<uint8_t> requestedMips;
+            std::vector<uint8_t> heldMipData;
+            for (auto texture : m_injectedTextures)
+            {
+                size_t regionsNum = size_t(texture->GetFeedbackRegionsX()) * texture->GetFeedbackRegionsY() * texture->GetNumSlices();
+                size_t sliceRegionsNum = regionsNum / texture->GetNumSlices();
+                const std::vector<uint8_t>& feedbackMips = texture->GetFeedbackMips();
+                if (feedbackMips.size() == regionsNum)
+                    requestedMips.assign(feedbackMips.begin(), feedbackMips.end());
+                else
+                    requestedMips.assign(regionsNum, 0xFF);
+                MergeInjectedMips(texture, requestedMips);
+
+                HoldRequestedMips(texture, requestedMips.data(), regionsNum, timeStamp, heldMipData);
+                for (uint32_t slice = 0; slice < texture->GetNumSlices(); slice++)
                 {
-                    auto textureSets = readbackTexture->GetPrimaryTextureSets();
-                    for (auto textureSet : textureSets)
-                    {
-                        uint32_t numTextures = textureSet->GetNumTextures();
-                        uint32_t primaryTextureIndex = textureSet->GetPrimaryTextureIndex();
-                        for (uint32_t iTextureSet = 0; iTextureSet < numTextures; ++iTextureSet)
-                        {
-                            if (iTextureSet == primaryTextureIndex)
-                                continue;
-
-                            // Make the follower texture match the primary texture requested tile state
-                            FeedbackTexture* follower = textureSet->GetTexture(iTextureSet);
-                            FeedbackTextureImpl* followerImpl = static_cast<FeedbackTextureImpl*>(follower);
-                            m_tiledTextureManager->MatchPrimaryTexture(
-                                readbackTexture->GetTiledTextureId(),
-                                followerImpl->GetTiledTextureId(),
-                                timeStamp,
-                                m_updateConfigThisFrame.tileTimeoutSeconds);
-                        }
-                    }
+                    rtxts::SamplerFeedbackDesc samplerFeedbackDesc = {};
+                    samplerFeedbackDesc.pMinMipData = heldMipData.data() + slice * sliceRegionsNum;
+                    m_tiledTextureManager->UpdateWithSamplerFeedback(texture->GetTiledTextureId(slice), samplerFeedbackDesc, timeStamp, 0.0f);
                 }
+
+                UpdateFollowerTextures(texture, timeStamp);
             }
+            m_injectedTextures.clear();
         }
 
-        // Collect textures to read back
+        // Collect textures to read back, all of them on the first frame after a camera cut
         readbackTextures.clear();
         {
-            uint32_t updatesLeft = m_updateConfigThisFrame.maxTexturesToUpdate;
+            uint32_t maxTexturesToUpdate = m_readbackAllTextures ? 0 : m_updateConfigThisFrame.maxTexturesToUpdate;
+            m_readbackAllTextures = false;
+            uint32_t updatesLeft = maxTexturesToUpdate;
             for (auto& feedbackTexture : m_texturesRingbuffer)
             {
-                if (m_updateConfigThisFrame.maxTexturesToUpdate > 0 && updatesLeft == 0)
+                if (maxTexturesToUpdate > 0 && updatesLeft == 0)
                     break;
+
+                // Textures which were never bound for drawing have no feedback to read back
+                if (!feedbackTexture->HasSamplerFeedbackTexture())
+                    continue;
+
                 commandList->clearSamplerFeedbackTexture(feedbackTexture->GetSamplerFeedbackTexture());
+                feedbackTexture->SetFeedbackResolveBuffer(m_frameIndex, AcquireResolveBuffer(feedbackTexture->GetFeedbackResolveBufferSize()));
                 readbackTextures.push_back(feedbackTexture);
                 updatesLeft--;
             }
@@ -167,11 +339,11 @@ namespace nvfeedback
             m_tiledTextureManager->TrimStandbyTiles();
         }
 
-        // Now check how many heaps the tiled texture manager needs
+        // Now check how many heaps the tiled texture manager needs, the heap allocator also holds the volume tile heaps
         uint32_t numRequiredHeaps = m_tiledTextureManager->GetNumDesiredHeaps();
-        if (numRequiredHeaps > m_heapAllocator->GetNumHeaps())
+        if (numRequiredHeaps > m_heapAllocator->GetNumHeaps() - m_volumeTiles->GetNumHeaps())
         {
-            while (m_heapAllocator->GetNumHeaps() < numRequiredHeaps)
+            while (m_heapAllocator->GetNumHeaps() - m_volumeTiles->GetNumHeaps() < numRequiredHeaps)
             {
                 uint32_t heapId;
                 m_heapAllocator->AllocateHeap(heapId);
@@ -187,6 +359,7 @@ namespace nvfeedback
                 m_tiledTextureManager->RemoveHeap(heapId);
                 m_heapAllocator->ReleaseHeap(heapId, m_frameIndex);
             }
+            m_volumeTiles->ReleaseEmptyHeaps(m_frameIndex);
         }
 
         // Now let the tiled texture manager allocate
@@ -195,14 +368,28 @@ namespace nvfeedback
         // Get tiles to unmap and map from the tiled texture manager
         // TODO: The current code does not merge unmapping and mapping tiles for the same textures. It would be more optimal.
         std::vector<uint32_t> tilesRequestedNew;
+        std::vector<FeedbackTextureUpdate> viewUpdates;
         std::vector<uint32_t> tilesToUnmap;
+        std::vector<uint32_t> sliceTiles;
+        float volumeTimeStamp = float(GetTickCount64()) / 1000.0f;
         for (auto& feedbackTexture : m_textures)
         {
+            if (feedbackTexture->IsVolume())
+            {
+                UpdateVolumeTiles(feedbackTexture, volumeTimeStamp, results);
+                continue;
+            }
+
             // Unmap tiles
-            m_tiledTextureManager->GetTilesToUnmap(feedbackTexture->GetTiledTextureId(), tilesToUnmap);
+            tilesToUnmap.clear();
+            for (uint32_t slice = 0; slice < feedbackTexture->GetNumSlices(); slice++)
+            {
+                m_tiledTextureManager->GetTilesToUnmap(feedbackTexture->GetTiledTextureId(slice), sliceTiles);
+                for (auto sliceTileIndex : sliceTiles)
+                    tilesToUnmap.push_back(feedbackTexture->GetTileIndex(slice, sliceTileIndex));
+            }
             if (!tilesToUnmap.empty())
             {
-                const auto& tilesCoordinates = m_tiledTextureManager->GetTileCoordinates(feedbackTexture->GetTiledTextureId());
                 uint32_t tileToUnmapNum = (uint32_t)tilesToUnmap.size();
 
                 nvrhi::TiledTextureRegion tiledTextureRegion = {};
@@ -219,12 +406,21 @@ namespace nvfeedback
                 for (auto& tileIndex : tilesToUnmap)
                 {
                     // Process only unpacked tiles
-                    nvrhi::TiledTextureCoordinate& tiledTextureCoordinate = tiledTextureCoordinates[tilesProcessedNum];
-                    tiledTextureCoordinate.mipLevel = tilesCoordinates[tileIndex].mipLevel;
-                    tiledTextureCoordinate.arrayLevel = 0;
-                    tiledTextureCoordinate.x = tilesCoordinates[tileIndex].x;
-                    tiledTextureCoordinate.y = tilesCoordinates[tileIndex].y;
-                    tiledTextureCoordinate.z = 0;
+                    tiledTextureCoordinates[tilesProcessedNum] = feedbackTexture->GetTiledTextureCoordinate(tileIndex);
+
+                    // Evicted tiles are the most likely to be requested again soon, keep their cached data around
+                    m_tileCache->Touch(feedbackTexture, tileIndex);
+                    feedbackTexture->SetTileUnmapFrame(tileIndex, m_frameNumber);
+
+                    // Their heap tiles may be reused for other data, so they can't be shared anymore
+                    m_sharedTiles.Remove(feedbackTexture, tileIndex);
+                    m_retryTiles.erase(std::make_pair(feedbackTexture, tileIndex));
+
+                    if (feedbackTexture->IsTileMappedToConstant(tileIndex))
+                    {
+                        feedbackTexture->SetTileMappedToConstant(tileIndex, false);
+                        m_tilesUniform--;
+                    }
 
                     tilesProcessedNum++;
                 }
@@ -234,23 +430,80 @@ namespace nvfeedback
                 m_minMipDirtyTextures.insert(feedbackTexture);
             }
 
-            // Collect new tiles to stream in
-            m_tiledTextureManager->GetTilesToMap(feedbackTexture->GetTiledTextureId(), tilesRequestedNew);
+            // Collect new tiles to stream in, prefetch tiles are due by the nearest deadline of the prefetch hints of the texture
+            tilesRequestedNew.clear();
+            for (uint32_t slice = 0; slice < feedbackTexture->GetNumSlices(); slice++)
+            {
+                m_tiledTextureManager->GetTilesToMap(feedbackTexture->GetTiledTextureId(slice), sliceTiles);
+                for (auto sliceTileIndex : sliceTiles)
+                    tilesRequestedNew.push_back(feedbackTexture->GetTileIndex(slice, sliceTileIndex));
+            }
             if (!tilesRequestedNew.empty())
             {
-                FeedbackTextureUpdate update;
-                update.texture = feedbackTexture;
+                // Tiles requested by feedback are returned per view
+                viewUpdates.resize(m_views.size());
+                for (uint32_t view = 0; view < uint32_t(viewUpdates.size()); view++)
+                {
+                    viewUpdates[view].texture = feedbackTexture;
+                    viewUpdates[view].tileIndices.clear();
+                    viewUpdates[view].view = view;
+                }
+                FeedbackTextureUpdate prefetchUpdate;
+                prefetchUpdate.texture = feedbackTexture;
+                prefetchUpdate.isPrefetch = true;
+                prefetchUpdate.deadlineSeconds = feedbackTexture->GetPrefetchMips().empty() ? FLT_MAX :
+                    std::max(feedbackTexture->GetPrefetchDeadline() - volumeTimeStamp, 0.0f);
                 for (auto& tileIndex : tilesRequestedNew)
                 {
 #if _DEBUG
-                    assert(std::find(update.tileIndices.begin(), update.tileIndices.end(), tileIndex) == update.tileIndices.end());
+                    for (const auto& update : viewUpdates)
+                        assert(std::find(update.tileIndices.begin(), update.tileIndices.end(), tileIndex) == update.tileIndices.end());
 #endif
-                    update.tileIndices.push_back(tileIndex);
+                    // Tiles moved by defragmentation are mapped again and have no valid content until then
+                    m_sharedTiles.Remove(feedbackTexture, tileIndex);
+                    CountThrashedTile(feedbackTexture, tileIndex);
+
+                    // Uniform tiles are mapped to their constant tile by UpdateTileMappings, with nothing to stream
+                    nvrhi::HeapHandle heap;
+                    uint64_t byteOffset;
+                    if (feedbackTexture->IsTileUniform(tileIndex) && GetConstantTile(feedbackTexture, tileIndex, heap, byteOffset))
+                        m_uniformTilesToMap[feedbackTexture].push_back(tileIndex);
+                    else if (feedbackTexture->IsTileRequestedByFeedback(tileIndex))
+                    {
+                        uint32_t view = feedbackTexture->GetTileView(tileIndex);
+                        viewUpdates[view < viewUpdates.size() && m_views[view].inUse ? view : 0].tileIndices.push_back(tileIndex);
+                    }
+                    else
+                        prefetchUpdate.tileIndices.push_back(tileIndex);
+                }
+                for (auto& update : viewUpdates)
+                {
+                    if (!update.tileIndices.empty())
+                        results->textures.push_back(update);
+                }
+                if (!prefetchUpdate.tileIndices.empty())
+                {
+                    m_tilesPrefetched += prefetchUpdate.tileIndices.size();
+                    results->textures.push_back(prefetchUpdate);
                 }
-                results->textures.push_back(update);
             }
         }
 
+        if (!m_retryTiles.empty())
+            ReturnRetryTiles(volumeTimeStamp, results);
+
+        if (m_views.size() > 1)
+            InterleaveViewUpdates(results);
+
+        // Prefetch tiles are streamed in the order of their deadlines
+        std::stable_sort(results->textures.begin(), results->textures.end(), [](const FeedbackTextureUpdate& a, const FeedbackTextureUpdate& b)
+            {
+                return (a.isPrefetch ? a.deadlineSeconds : -1.0f) < (b.isPrefetch ? b.deadlineSeconds : -1.0f);
+            });
+
+        if (m_cameraCutBurst)
+            SortTilesCoarseFirst(results);
+
         // Defragmentation phase
         if (m_updateConfigThisFrame.defragmentHeaps)
         {
@@ -262,68 +515,896 @@ namespace nvfeedback
         m_timerBeginFrame.End();
     }
 
-    void FeedbackManagerImpl::UpdateTileMappings(nvrhi::ICommandList* commandList, FeedbackTextureCollection* tilesReady)
+    void FeedbackManagerImpl::UpdateVolumeTiles(FeedbackTextureImpl* texture, float timeStamp, FeedbackTextureCollection* results)
     {
-        m_timerUpdateTileMappings.Begin();
+        // Packed tiles stay resident, regular tiles are kept while requested within the timeout
+        FeedbackTextureUpdate update;
+        update.texture = texture;
+        std::vector<nvrhi::TiledTextureCoordinate> tiledTextureCoordinates;
+        for (uint32_t tileIndex = 0; tileIndex < texture->GetNumTiles(); tileIndex++)
+        {
+            VolumeTile& tile = texture->GetVolumeTile(tileIndex);
+            bool isRequested = texture->IsTilePacked(tileIndex) || tile.mip >= texture->GetResidentMipFloor() ||
+                (tile.requestTime >= 0.0f && timeStamp - tile.requestTime <= GetTileTimeout(tile.mip));
 
-        for (auto& texUpdate : tilesReady->textures)
+            if (isRequested && tile.state == VolumeTileState::Unmapped)
+            {
+                m_volumeTiles->Allocate(tile.heapId, tile.heapTileIndex);
+                tile.state = VolumeTileState::Pending;
+                update.tileIndices.push_back(tileIndex);
+                CountThrashedTile(texture, tileIndex);
+            }
+            else if (!isRequested && tile.state == VolumeTileState::Mapped)
+            {
+                m_volumeTiles->Free(tile.heapId, tile.heapTileIndex);
+                tile.state = VolumeTileState::Unmapped;
+                m_retryTiles.erase(std::make_pair(texture, tileIndex));
+                tiledTextureCoordinates.push_back(texture->GetTiledTextureCoordinate(tileIndex));
+                m_tileCache->Touch(texture, tileIndex);
+                texture->SetTileUnmapFrame(tileIndex, m_frameNumber);
+            }
+        }
+
+        if (!tiledTextureCoordinates.empty())
         {
-            FeedbackTextureImpl* texture = dynamic_cast<FeedbackTextureImpl*>(texUpdate.texture);
+            nvrhi::TiledTextureRegion tiledTextureRegion = {};
+            tiledTextureRegion.tilesNum = 1;
+            std::vector<nvrhi::TiledTextureRegion> tiledTextureRegions(tiledTextureCoordinates.size(), tiledTextureRegion);
+
+            nvrhi::TextureTilesMapping textureTilesMapping = {};
+            textureTilesMapping.numTextureRegions = (uint32_t)tiledTextureCoordinates.size();
+            textureTilesMapping.tiledTextureCoordinates = tiledTextureCoordinates.data();
+            textureTilesMapping.tiledTextureRegions = tiledTextureRegions.data();
+            m_device->updateTextureTileMappings(texture->GetReservedTexture(), &textureTilesMapping, 1);
+
             m_minMipDirtyTextures.insert(texture);
+        }
 
-            uint32_t tiledTextureId = texture->GetTiledTextureId();
-            m_tiledTextureManager->UpdateTilesMapping(tiledTextureId, texUpdate.tileIndices);
+        if (!update.tileIndices.empty())
+            results->textures.push_back(update);
+    }
 
-            const auto& tilesCoordinates = m_tiledTextureManager->GetTileCoordinates(tiledTextureId);
-            const auto& tilesAllocations = m_tiledTextureManager->GetTileAllocations(tiledTextureId);
+    float FeedbackManagerImpl::GetTileTimeout(uint32_t mip) const
+    {
+        const std::vector<float>& timeouts = m_updateConfigThisFrame.tileTimeoutSecondsByMip;
+        return mip < timeouts.size() ? timeouts[mip] : m_updateConfigThisFrame.tileTimeoutSeconds;
+    }
 
-            std::map<nvrhi::HeapHandle, std::vector<uint32_t>> heapTilesMapping;
-            for (auto tileIndex : texUpdate.tileIndices)
+    void FeedbackManagerImpl::HoldRequestedMips(FeedbackTextureImpl* texture, const uint8_t* minMipData, size_t regionsNum, float timeStamp, std::vector<uint8_t>& heldMipData)
+    {
+        // Finer requests take effect at once, a region only moves to a coarser mip once the timeout of its held mip runs out.
+        // Requests a few mips coarser, such as a camera bobbing around a LOD boundary, hold the finer mip for longer.
+        const float hysteresisTimeoutScale = 2.0f;
+
+        // Every region also requests the resident mips, which are never released
+        uint8_t residentMip = texture->GetResidentRegionMip();
+
+        std::vector<HeldRegionMip>& heldMips = texture->GetHeldRegionMips();
+        heldMips.resize(regionsNum);
+        heldMipData.resize(regionsNum);
+        for (size_t region = 0; region < regionsNum; region++)
+        {
+            HeldRegionMip& held = heldMips[region];
+            uint8_t mip = minMipData[region];
+            if (mip > held.mip)
             {
-                nvrhi::HeapHandle heap = m_heapAllocator->GetHeapHandle(tilesAllocations[tileIndex].heapId);
-                if (heapTilesMapping.find(heap) == heapTilesMapping.end())
-                    heapTilesMapping[heap] = std::vector<uint32_t>();
-                heapTilesMapping[heap].push_back(tileIndex);
+                float timeout = GetTileTimeout(held.mip);
+                if (mip - held.mip <= m_updateConfigThisFrame.mipHysteresisLevels)
+                    timeout *= hysteresisTimeoutScale;
+                if (timeStamp - held.requestTime <= timeout)
+                {
+                    heldMipData[region] = std::min(held.mip, residentMip);
+                    continue;
+                }
             }
 
-            // Now loop heaps
-            for (auto& pair : heapTilesMapping)
+            held.mip = mip;
+            held.requestTime = timeStamp;
+            heldMipData[region] = std::min(mip, residentMip);
+        }
+
+        // Prefetch hints keep their tiles requested until they expire
+        const std::vector<uint8_t>& prefetchMips = texture->GetPrefetchMips();
+        if (prefetchMips.size() == regionsNum)
+            MergeMinMips(heldMipData.data(), prefetchMips.data(), regionsNum);
+    }
+
+    void FeedbackManagerImpl::UpdateResidentTiles(FeedbackTextureImpl* texture, uint32_t previousResidentTiles)
+    {
+        m_tilesPinned += texture->GetNumResidentFloorTiles() - previousResidentTiles;
+
+        // Resident tiles are allocated and returned to stream by the next BeginFrame, volume tiles are handled by UpdateVolumeTiles.
+        // Tiles above a raised floor are released once sampler feedback no longer requests them.
+        if (!texture->IsVolume())
+            RequestPinnedTiles(texture, float(GetTickCount64()) / 1000.0f, FLT_MAX);
+    }
+
+    void FeedbackManagerImpl::RequestPinnedTiles(FeedbackTextureImpl* texture, float timeStamp, float timeout)
+    {
+        uint8_t residentMip = texture->GetResidentRegionMip();
+        const std::vector<uint8_t>& prefetchMips = texture->GetPrefetchMips();
+        if (residentMip == 0xFF && prefetchMips.empty() && timeout == FLT_MAX)
+            return;
+
+        size_t sliceRegionsNum = size_t(texture->GetFeedbackRegionsX()) * texture->GetFeedbackRegionsY();
+        std::vector<uint8_t> pinnedMipData(sliceRegionsNum);
+        for (uint32_t slice = 0; slice < texture->GetNumSlices(); slice++)
+        {
+            for (size_t region = 0; region < sliceRegionsNum; region++)
             {
-                nvrhi::HeapHandle heap = pair.first;
-                auto& heapTiles = pair.second;
-                uint32_t numTiles = (uint32_t)heapTiles.size();
+                uint8_t prefetchMip = prefetchMips.empty() ? 0xFF : prefetchMips[slice * sliceRegionsNum + region];
+                pinnedMipData[region] = std::min(residentMip, prefetchMip);
+            }
+
+            rtxts::SamplerFeedbackDesc samplerFeedbackDesc = {};
+            samplerFeedbackDesc.pMinMipData = pinnedMipData.data();
+            m_tiledTextureManager->UpdateWithSamplerFeedback(texture->GetTiledTextureId(slice), samplerFeedbackDesc, timeStamp, timeout);
+        }
+    }
+
+    void FeedbackManagerImpl::PrefetchRegion(FeedbackTexture* texture, uint32_t mip, const FeedbackUvRect& uvRect, float deadlineSeconds)
+    {
+        FeedbackTextureImpl* textureImpl = static_cast<FeedbackTextureImpl*>(texture);
+        float timeStamp = float(GetTickCount64()) / 1000.0f;
+        float deadline = timeStamp + std::max(deadlineSeconds, 0.0f);
+
+        // Volume tiles stay requested for the tile timeout after their request time, which is moved to the deadline
+        if (textureImpl->IsVolume())
+        {
+            textureImpl->RequestVolumeRegion(textureImpl->GetUvRectVolumeRegion(mip, uvRect), deadline);
+            return;
+        }
+
+        // The packed mips are always resident
+        if (mip >= textureImpl->GetPackedMipInfo().numStandardMips)
+            return;
 
-                std::vector<nvrhi::TiledTextureCoordinate> tiledTextureCoordinates;
-                std::vector<nvrhi::TiledTextureRegion> tiledTextureRegions;
-                std::vector<uint64_t> byteOffsets;
+        PrefetchHint hint;
+        hint.texture = textureImpl;
+        hint.mip = uint8_t(mip);
+        textureImpl->GetUvRectRegions(uvRect, hint.regionX0, hint.regionY0, hint.regionX1, hint.regionY1);
+        hint.deadline = deadline;
+        m_prefetchHints.push_back(hint);
 
-                for (UINT i = 0; i < numTiles; i++)
+        UpdatePrefetchMips(textureImpl);
+        RequestPinnedTiles(textureImpl, timeStamp, FLT_MAX);
+    }
+
+    void FeedbackManagerImpl::PrefetchTexture(FeedbackTexture* texture, uint32_t mip, float deadlineSeconds)
+    {
+        PrefetchRegion(texture, mip, FeedbackUvRect(), deadlineSeconds);
+    }
+
+    void FeedbackManagerImpl::UpdateFollowerTextures(FeedbackTextureImpl* primaryTexture, float timeStamp)
+    {
+        if (!primaryTexture->IsPrimaryTexture())
+            return;
+
+        auto textureSets = primaryTexture->GetPrimaryTextureSets();
+        for (auto textureSet : textureSets)
+        {
+            uint32_t numTextures = textureSet->GetNumTextures();
+            uint32_t primaryTextureIndex = textureSet->GetPrimaryTextureIndex();
+            for (uint32_t iTextureSet = 0; iTextureSet < numTextures; ++iTextureSet)
+            {
+                if (iTextureSet == primaryTextureIndex)
+                    continue;
+
+                // Make the follower texture match the primary texture requested tile state, slice by slice
+                FeedbackTexture* follower = textureSet->GetTexture(iTextureSet);
+                FeedbackTextureImpl* followerImpl = static_cast<FeedbackTextureImpl*>(follower);
+                followerImpl->SetVisible(primaryTexture->IsVisible());
+                uint32_t numSlices = std::min(primaryTexture->GetNumSlices(), followerImpl->GetNumSlices());
+                for (uint32_t slice = 0; slice < numSlices; slice++)
                 {
-                    uint32_t tileIndex = heapTiles[i];
+                    m_tiledTextureManager->MatchPrimaryTexture(
+                        primaryTexture->GetTiledTextureId(slice),
+                        followerImpl->GetTiledTextureId(slice),
+                        timeStamp,
+                        m_updateConfigThisFrame.tileTimeoutSeconds);
+                }
+
+                // Followers may keep more mips resident than the primary texture requests
+                RequestPinnedTiles(followerImpl, timeStamp, FLT_MAX);
+            }
+        }
+    }
+
+    void FeedbackManagerImpl::InjectFeedback(FeedbackTexture* texture, uint32_t mip, const FeedbackUvRect& uvRect)
+    {
+        FeedbackTextureImpl* textureImpl = static_cast<FeedbackTextureImpl*>(texture);
+        if (textureImpl->IsVolume())
+        {
+            textureImpl->RequestVolumeRegion(textureImpl->GetUvRectVolumeRegion(mip, uvRect), float(GetTickCount64()) / 1000.0f);
+            return;
+        }
+
+        // The packed mips are always resident
+        if (mip >= textureImpl->GetPackedMipInfo().numStandardMips)
+            return;
 
-                    nvrhi::TiledTextureCoordinate tiledTextureCoordinate = {};
-                    tiledTextureCoordinate.mipLevel = tilesCoordinates[tileIndex].mipLevel;
-                    tiledTextureCoordinate.x = tilesCoordinates[tileIndex].x;
-                    tiledTextureCoordinate.y = tilesCoordinates[tileIndex].y;
-                    tiledTextureCoordinate.z = 0;
-                    tiledTextureCoordinates.push_back(tiledTextureCoordinate);
+        uint32_t regionsX = textureImpl->GetFeedbackRegionsX();
+        size_t sliceRegionsNum = size_t(regionsX) * textureImpl->GetFeedbackRegionsY();
+        std::vector<uint8_t>& injectedMips = textureImpl->GetInjectedMips();
+        injectedMips.resize(sliceRegionsNum * textureImpl->GetNumSlices(), 0xFF);
+
+        uint32_t x0, y0, x1, y1;
+        textureImpl->GetUvRectRegions(uvRect, x0, y0, x1, y1);
+        for (uint32_t slice = 0; slice < textureImpl->GetNumSlices(); slice++)
+            MergeMinMipRect(injectedMips.data() + slice * sliceRegionsNum, regionsX, x0, y0, x1, y1, uint8_t(mip));
+        m_injectedTextures.insert(textureImpl);
+    }
+
+    void FeedbackManagerImpl::InjectFeedbackMinMips(FeedbackTexture* texture, const uint8_t* minMipData, size_t regionsNum)
+    {
+        FeedbackTextureImpl* textureImpl = static_cast<FeedbackTextureImpl*>(texture);
+        size_t textureRegionsNum = size_t(textureImpl->GetFeedbackRegionsX()) * textureImpl->GetFeedbackRegionsY() * textureImpl->GetNumSlices();
+        if (textureImpl->IsVolume() || regionsNum != textureRegionsNum)
+            return;
+
+        std::vector<uint8_t>& injectedMips = textureImpl->GetInjectedMips();
+        if (injectedMips.empty())
+            injectedMips.assign(minMipData, minMipData + regionsNum);
+        else
+            MergeMinMips(injectedMips.data(), minMipData, regionsNum);
+        m_injectedTextures.insert(textureImpl);
+    }
+
+    bool FeedbackManagerImpl::CreateFeedbackView(const FeedbackViewDesc& desc, uint32_t* pView)
+    {
+        uint32_t view = 1;
+        while (view < m_views.size() && m_views[view].inUse)
+            view++;
+        if (view >= MaxFeedbackViews)
+            return false;
+
+        if (view == m_views.size())
+            m_views.push_back({ desc, true });
+        else
+            m_views[view] = { desc, true };
+        *pView = view;
+        return true;
+    }
+
+    void FeedbackManagerImpl::SetFeedbackViewDesc(uint32_t view, const FeedbackViewDesc& desc)
+    {
+        if (view < m_views.size() && m_views[view].inUse)
+            m_views[view].desc = desc;
+    }
+
+    void FeedbackManagerImpl::DestroyFeedbackView(uint32_t view)
+    {
+        // The main view can't be destroyed
+        if (view == 0 || view >= m_views.size() || !m_views[view].inUse)
+            return;
 
-                    nvrhi::TiledTextureRegion tiledTextureRegion = {};
-                    tiledTextureRegion.tilesNum = 1;
-                    tiledTextureRegions.push_back(tiledTextureRegion);
+        // Drop the requests injected for the view, the slot may be reused before the next update
+        for (auto texture : m_injectedTextures)
+            texture->GetInjectedViewMips().erase(view);
 
-                    byteOffsets.push_back(tilesAllocations[tileIndex].heapTileIndex * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
+        m_views[view].inUse = false;
+        while (m_views.size() > 1 && !m_views.back().inUse)
+            m_views.pop_back();
+    }
+
+    float FeedbackManagerImpl::GetFeedbackViewMipBias(uint32_t view)
+    {
+        if (view >= m_views.size() || !m_views[view].inUse)
+            return 0.0f;
+        return -std::log2(std::max(m_views[view].desc.weight, 1.0f / 256.0f));
+    }
+
+    int32_t FeedbackManagerImpl::GetViewMipBias(uint32_t view)
+    {
+        // Rounded from the bias given to WriteSamplerFeedbackBias, so that merged and sampled requests agree
+        return int32_t(std::lround(GetFeedbackViewMipBias(view)));
+    }
+
+    void FeedbackManagerImpl::InjectViewFeedbackMinMips(uint32_t view, FeedbackTexture* texture, const uint8_t* minMipData, size_t regionsNum)
+    {
+        if (view == 0)
+        {
+            InjectFeedbackMinMips(texture, minMipData, regionsNum);
+            return;
+        }
+
+        FeedbackTextureImpl* textureImpl = static_cast<FeedbackTextureImpl*>(texture);
+        size_t textureRegionsNum = size_t(textureImpl->GetFeedbackRegionsX()) * textureImpl->GetFeedbackRegionsY() * textureImpl->GetNumSlices();
+        if (view >= m_views.size() || !m_views[view].inUse || textureImpl->IsVolume() || regionsNum != textureRegionsNum)
+            return;
+
+        std::vector<uint8_t>& viewMips = textureImpl->GetInjectedViewMips()[view];
+        if (viewMips.empty())
+            viewMips.assign(minMipData, minMipData + regionsNum);
+        else
+            MergeMinMips(viewMips.data(), minMipData, regionsNum);
+        m_injectedTextures.insert(textureImpl);
+    }
+
+    void FeedbackManagerImpl::MergeInjectedMips(FeedbackTextureImpl* texture, std::vector<uint8_t>& requestedMips)
+    {
+        size_t regionsNum = requestedMips.size();
+        std::vector<uint8_t>& injectedMips = texture->GetInjectedMips();
+        if (injectedMips.size() == regionsNum)
+            MergeMinMips(requestedMips.data(), injectedMips.data(), regionsNum);
+        injectedMips.clear();
+
+        // Regions keep view 0 unless another view requests a finer mip
+        std::vector<uint8_t>& regionViews = texture->GetRegionViews();
+        regionViews.clear();
+        auto& injectedViewMips = texture->GetInjectedViewMips();
+        for (auto& viewMips : injectedViewMips)
+        {
+            uint32_t view = viewMips.first;
+            if (view >= m_views.size() || !m_views[view].inUse || viewMips.second.size() != regionsNum)
+                continue;
+
+            regionViews.resize(regionsNum, 0);
+            MergeViewMinMips(requestedMips.data(), regionViews.data(), viewMips.second.data(), regionsNum, GetViewMipBias(view), uint8_t(view));
+        }
+        injectedViewMips.clear();
+
+        texture->SetRequestedMips(requestedMips);
+    }
+
+    void FeedbackManagerImpl::InterleaveViewUpdates(FeedbackTextureCollection* results)
+    {
+        std::vector<std::vector<FeedbackTextureUpdate>> viewQueues(m_views.size());
+        std::vector<FeedbackTextureUpdate> prefetchUpdates;
+        for (auto& update : results->textures)
+        {
+            if (update.isPrefetch)
+                prefetchUpdates.push_back(std::move(update));
+            else
+                viewQueues[update.view].push_back(std::move(update));
+        }
+        results->textures.clear();
+
+        // Weighted fair queuing, the next update is taken from the view furthest below its share of the tiles
+        std::vector<size_t> queuePositions(m_views.size(), 0);
+        std::vector<double> tilesServed(m_views.size(), 0.0);
+        while (true)
+        {
+            uint32_t nextView = UINT32_MAX;
+            double nextServed = DBL_MAX;
+            for (uint32_t view = 0; view < uint32_t(viewQueues.size()); view++)
+            {
+                if (queuePositions[view] >= viewQueues[view].size())
+                    continue;
+                double served = tilesServed[view] / std::max(double(m_views[view].desc.budgetShare), 1e-3);
+                if (served < nextServed)
+                {
+                    nextView = view;
+                    nextServed = served;
                 }
+            }
+            if (nextView == UINT32_MAX)
+                break;
 
-                nvrhi::TextureTilesMapping textureTilesMapping = {};
-                textureTilesMapping.numTextureRegions = (uint32_t)tiledTextureCoordinates.size();
-                textureTilesMapping.tiledTextureCoordinates = tiledTextureCoordinates.data();
-                textureTilesMapping.tiledTextureRegions = tiledTextureRegions.data();
-                textureTilesMapping.byteOffsets = byteOffsets.data();
-                textureTilesMapping.heap = heap;
+            FeedbackTextureUpdate& update = viewQueues[nextView][queuePositions[nextView]++];
+            tilesServed[nextView] += double(update.tileIndices.size());
+            results->textures.push_back(std::move(update));
+        }
+
+        for (auto& update : prefetchUpdates)
+            results->textures.push_back(std::move(update));
+    }
+
+    void FeedbackManagerImpl::SaveResidencySnapshot(std::vector<uint8_t>& data)
+    {
+        // Textures sharing a key can't be told apart when the snapshot is loaded, so none of them is saved
+        std::map<std::string, uint32_t> keyCounts;
+        for (auto texture : m_textures)
+            keyCounts[texture->GetResidencyKey()]++;
+
+        std::vector<ResidencySnapshotTexture> snapshotTextures;
+        std::vector<uint8_t> minMipData;
+        for (auto texture : m_textures)
+        {
+            const std::string& key = texture->GetResidencyKey();
+            if (texture->IsVolume() || key.empty() || keyCounts[key] > 1)
+                continue;
+
+            ResidencySnapshotTexture snapshotTexture;
+            snapshotTexture.key = key;
+            snapshotTexture.numSlices = texture->GetNumSlices();
+            snapshotTexture.regionsX = texture->GetFeedbackRegionsX();
+            snapshotTexture.regionsY = texture->GetFeedbackRegionsY();
+            size_t sliceRegionsNum = size_t(snapshotTexture.regionsX) * snapshotTexture.regionsY;
+            snapshotTexture.regionMips.resize(sliceRegionsNum * snapshotTexture.numSlices, 0xFF);
+
+            // Mapped tiles, from the finest mip with all tiles mapped per tile of the first mip
+            uint32_t numStandardMips = texture->GetPackedMipInfo().numStandardMips;
+            for (uint32_t slice = 0; slice < snapshotTexture.numSlices; slice++)
+            {
+                rtxts::TextureDesc minMipDesc = m_tiledTextureManager->GetTextureDesc(texture->GetTiledTextureId(slice), rtxts::TextureTypes::eMinMipTexture);
+                minMipData.resize(size_t(minMipDesc.textureOrMipRegionWidth) * minMipDesc.textureOrMipRegionHeight);
+                m_tiledTextureManager->WriteMinMipData(texture->GetTiledTextureId(slice), minMipData.data());
+
+                for (uint32_t y = 0; y < snapshotTexture.regionsY; y++)
+                {
+                    uint32_t minMipY = y * minMipDesc.textureOrMipRegionHeight / snapshotTexture.regionsY;
+                    for (uint32_t x = 0; x < snapshotTexture.regionsX; x++)
+                    {
+                        uint32_t minMipX = x * minMipDesc.textureOrMipRegionWidth / snapshotTexture.regionsX;
+                        uint8_t mip = minMipData[size_t(minMipY) * minMipDesc.textureOrMipRegionWidth + minMipX];
+                        if (mip < numStandardMips)
+                            snapshotTexture.regionMips[slice * sliceRegionsNum + size_t(y) * snapshotTexture.regionsX + x] = mip;
+                    }
+                }
+            }
+
+            // Requested tiles which may not be mapped yet
+            const std::vector<HeldRegionMip>& heldMips = texture->GetHeldRegionMips();
+            const std::vector<uint8_t>& prefetchMips = texture->GetPrefetchMips();
+            for (size_t region = 0; region < snapshotTexture.regionMips.size(); region++)
+            {
+                uint8_t& mip = snapshotTexture.regionMips[region];
+                if (region < heldMips.size())
+                    mip = std::min(mip, heldMips[region].mip);
+                if (region < prefetchMips.size())
+                    mip = std::min(mip, prefetchMips[region]);
+            }
+
+            if (std::all_of(snapshotTexture.regionMips.begin(), snapshotTexture.regionMips.end(), [](uint8_t mip) { return mip == 0xFF; }))
+                continue;
+
+            snapshotTextures.push_back(std::move(snapshotTexture));
+        }
+
+        WriteResidencySnapshot(snapshotTextures, data);
+    }
 
-                m_device->updateTextureTileMappings(texture->GetReservedTexture(), &textureTilesMapping, 1);
+    uint32_t FeedbackManagerImpl::LoadResidencySnapshot(const std::vector<uint8_t>& data, float deadlineSeconds)
+    {
+        std::vector<ResidencySnapshotTexture> snapshotTextures;
+        if (!ReadResidencySnapshot(data, snapshotTextures))
+            return 0;
+
+        // Keys found more than once, in the snapshot or among the textures, are ambiguous and skipped
+        std::map<std::string, uint32_t> keyCounts;
+        for (auto texture : m_textures)
+            keyCounts[texture->GetResidencyKey()]++;
+
+        std::map<std::string, const ResidencySnapshotTexture*> snapshotTexturesByKey;
+        for (auto& snapshotTexture : snapshotTextures)
+        {
+            auto inserted = snapshotTexturesByKey.emplace(snapshotTexture.key, &snapshotTexture);
+            if (!inserted.second)
+                inserted.first->second = nullptr;
+        }
+
+        float timeStamp = float(GetTickCount64()) / 1000.0f;
+        uint32_t texturesRestored = 0;
+        for (auto texture : m_textures)
+        {
+            const std::string& key = texture->GetResidencyKey();
+            if (texture->IsVolume() || key.empty() || keyCounts[key] > 1)
+                continue;
+            auto it = snapshotTexturesByKey.find(key);
+            if (it == snapshotTexturesByKey.end() || !it->second)
+                continue;
+
+            // Textures changed since the snapshot was taken are left alone
+            const ResidencySnapshotTexture& snapshotTexture = *it->second;
+            if (snapshotTexture.numSlices != texture->GetNumSlices() || snapshotTexture.regionsX != texture->GetFeedbackRegionsX() ||
+                snapshotTexture.regionsY != texture->GetFeedbackRegionsY())
+                continue;
+
+            PrefetchHint hint = {};
+            hint.texture = texture;
+            hint.mip = 0xFF;
+            hint.deadline = timeStamp + std::max(deadlineSeconds, 0.0f);
+            hint.regionMips = snapshotTexture.regionMips;
+            uint8_t numStandardMips = uint8_t(texture->GetPackedMipInfo().numStandardMips);
+            for (auto& mip : hint.regionMips)
+            {
+                if (mip >= numStandardMips)
+                    mip = 0xFF;
+            }
+            m_prefetchHints.push_back(std::move(hint));
+
+            UpdatePrefetchMips(texture);
+            RequestPinnedTiles(texture, timeStamp, FLT_MAX);
+            texturesRestored++;
+        }
+
+        return texturesRestored;
+    }
+
+    void FeedbackManagerImpl::UpdatePrefetchMips(FeedbackTextureImpl* texture)
+    {
+        std::vector<uint8_t>& prefetchMips = texture->GetPrefetchMips();
+        prefetchMips.clear();
+
+        uint32_t regionsX = texture->GetFeedbackRegionsX();
+        size_t sliceRegionsNum = size_t(regionsX) * texture->GetFeedbackRegionsY();
+        float nearestDeadline = FLT_MAX;
+        for (auto& hint : m_prefetchHints)
+        {
+            if (hint.texture != texture)
+                continue;
+
+            prefetchMips.resize(sliceRegionsNum * texture->GetNumSlices(), 0xFF);
+            nearestDeadline = std::min(nearestDeadline, hint.deadline);
+            if (!hint.regionMips.empty())
+            {
+                MergeMinMips(prefetchMips.data(), hint.regionMips.data(), prefetchMips.size());
+                continue;
+            }
+
+            for (uint32_t slice = 0; slice < texture->GetNumSlices(); slice++)
+                MergeMinMipRect(prefetchMips.data() + slice * sliceRegionsNum, regionsX, hint.regionX0, hint.regionY0, hint.regionX1, hint.regionY1, hint.mip);
+        }
+        texture->SetPrefetchDeadline(nearestDeadline);
+    }
+
+    void FeedbackManagerImpl::ExpirePrefetchHints(float timeStamp)
+    {
+        // Hints may be issued before the first BeginFrame, so the timeout is only known once they are checked here
+        std::set<FeedbackTextureImpl*> expiredTextures;
+        for (auto it = m_prefetchHints.begin(); it != m_prefetchHints.end();)
+        {
+            if (timeStamp > it->deadline + m_updateConfigThisFrame.tileTimeoutSeconds)
+            {
+                expiredTextures.insert(it->texture);
+                it = m_prefetchHints.erase(it);
+            }
+            else
+                ++it;
+        }
+
+        for (auto texture : expiredTextures)
+        {
+            UpdatePrefetchMips(texture);
+
+            // Textures with sampler feedback release the expired tiles on their next readback and texture set followers when
+            // they next match their primary texture. Other textures have neither and release them here.
+            if (!texture->HasSamplerFeedbackTexture() && texture->GetNumTextureSets() == 0)
+                RequestPinnedTiles(texture, timeStamp, 0.0f);
+        }
+    }
+
+    void FeedbackManagerImpl::NotifyCameraCut()
+    {
+        m_staleReadbackFrames = m_numFramesInFlight;
+        m_cameraCutBurstFramesLeft = m_desc.cameraCutBurstFrames;
+        m_readbackAllTextures = true;
+
+        for (auto& texture : m_textures)
+            texture->ResetFeedbackHistory();
+    }
+
+    void FeedbackManagerImpl::SortTilesCoarseFirst(FeedbackTextureCollection* results)
+    {
+        struct SortedTile
+        {
+            uint32_t mip;
+            uint32_t updateIndex;
+            uint32_t tileIndex;
+        };
+
+        std::vector<SortedTile> sortedTiles;
+        std::vector<FeedbackTextureTileInfo> tiles;
+        for (uint32_t updateIndex = 0; updateIndex < uint32_t(results->textures.size()); updateIndex++)
+        {
+            FeedbackTextureUpdate& update = results->textures[updateIndex];
+            for (auto tileIndex : update.tileIndices)
+            {
+                update.texture->GetTileInfo(tileIndex, tiles);
+                sortedTiles.push_back({ tiles[0].mip, updateIndex, tileIndex });
+            }
+        }
+
+        // The order of textures is kept within a mip level, and the packed tiles of a texture stay together
+        std::stable_sort(sortedTiles.begin(), sortedTiles.end(), [](const SortedTile& a, const SortedTile& b) { return a.mip > b.mip; });
+
+        // Every sorted update keeps the prefetch deadline and view of the tiles it holds
+        std::vector<FeedbackTextureUpdate> sortedUpdates;
+        for (size_t i = 0; i < sortedTiles.size(); i++)
+        {
+            const SortedTile& sortedTile = sortedTiles[i];
+            const FeedbackTextureUpdate& update = results->textures[sortedTile.updateIndex];
+            const FeedbackTextureUpdate* previousUpdate = i == 0 ? nullptr : &results->textures[sortedTiles[i - 1].updateIndex];
+            if (!previousUpdate || sortedTile.mip != sortedTiles[i - 1].mip || sortedTile.updateIndex != sortedTiles[i - 1].updateIndex ||
+                update.deadlineSeconds != previousUpdate->deadlineSeconds || update.view != previousUpdate->view)
+            {
+                FeedbackTextureUpdate sortedUpdate;
+                sortedUpdate.texture = update.texture;
+                sortedUpdate.isPrefetch = update.isPrefetch;
+                sortedUpdate.deadlineSeconds = update.deadlineSeconds;
+                sortedUpdate.view = update.view;
+                sortedUpdates.push_back(sortedUpdate);
+            }
+            sortedUpdates.back().tileIndices.push_back(sortedTile.tileIndex);
+        }
+        results->textures = std::move(sortedUpdates);
+    }
+
+    void FeedbackManagerImpl::PredictRequestedMips(FeedbackTextureImpl* texture, std::vector<uint8_t>& requestedMips)
+    {
+        const std::vector<uint8_t>& feedbackMips = texture->GetFeedbackMips();
+        const std::vector<uint8_t>& previousMips = texture->GetPreviousFeedbackMips();
+        if (previousMips.size() != feedbackMips.size())
+            return;
+
+        // Regions requested further ahead than this are left to the next readbacks
+        const int maxLookaheadRegions = 4;
+
+        int regionsX = int(texture->GetFeedbackRegionsX());
+        int regionsY = int(texture->GetFeedbackRegionsY());
+        size_t sliceRegionsNum = size_t(regionsX) * regionsY;
+        for (uint32_t slice = 0; slice < texture->GetNumSlices(); slice++)
+        {
+            const uint8_t* current = feedbackMips.data() + slice * sliceRegionsNum;
+            const uint8_t* previous = previousMips.data() + slice * sliceRegionsNum;
+            uint8_t* requested = requestedMips.data() + slice * sliceRegionsNum;
+
+            // The requested area moves by the distance between the centers of the regions requested by the last two readbacks
+            double currentX = 0.0, currentY = 0.0, previousX = 0.0, previousY = 0.0;
+            uint32_t currentNum = 0, previousNum = 0;
+            for (int y = 0; y < regionsY; y++)
+            {
+                for (int x = 0; x < regionsX; x++)
+                {
+                    size_t region = size_t(y) * regionsX + x;
+                    if (current[region] != 0xFF)
+                    {
+                        currentX += x;
+                        currentY += y;
+                        currentNum++;
+                    }
+                    if (previous[region] != 0xFF)
+                    {
+                        previousX += x;
+                        previousY += y;
+                        previousNum++;
+                    }
+
+                    // Regions getting finer are being approached, request the next finer mip
+                    if (current[region] != 0xFF && previous[region] != 0xFF && current[region] < previous[region] && current[region] > 0)
+                        requested[region] = std::min(requested[region], uint8_t(current[region] - 1));
+                }
+            }
+            if (currentNum == 0 || previousNum == 0)
+                continue;
+
+            int moveX = std::clamp(int(std::lround(currentX / currentNum - previousX / previousNum)), -maxLookaheadRegions, maxLookaheadRegions);
+            int moveY = std::clamp(int(std::lround(currentY / currentNum - previousY / previousNum)), -maxLookaheadRegions, maxLookaheadRegions);
+            int steps = std::max(std::abs(moveX), std::abs(moveY));
+            if (steps == 0)
+                continue;
+
+            // Every requested region also requests its mip in the regions ahead of it along the motion
+            for (int y = 0; y < regionsY; y++)
+            {
+                for (int x = 0; x < regionsX; x++)
+                {
+                    uint8_t mip = current[size_t(y) * regionsX + x];
+                    if (mip == 0xFF)
+                        continue;
+
+                    for (int step = 1; step <= steps; step++)
+                    {
+                        int aheadX = x + moveX * step / steps;
+                        int aheadY = y + moveY * step / steps;
+                        if (aheadX < 0 || aheadY < 0 || aheadX >= regionsX || aheadY >= regionsY)
+                            break;
+                        uint8_t& aheadMip = requested[size_t(aheadY) * regionsX + aheadX];
+                        aheadMip = std::min(aheadMip, mip);
+                    }
+                }
+            }
+        }
+    }
+
+    void FeedbackManagerImpl::CountThrashedTile(FeedbackTextureImpl* texture, uint32_t tileIndex)
+    {
+        // Tiles requested again shortly after being unmapped were released too early, and cost a mapping update and an upload
+        uint32_t unmapFrame = texture->GetTileUnmapFrame(tileIndex);
+        uint32_t thrashWindowFrames = m_updateConfigThisFrame.thrashWindowFrames;
+        if (thrashWindowFrames == 0 || unmapFrame == 0 || m_frameNumber - unmapFrame > thrashWindowFrames)
+            return;
+
+        m_tilesThrashed++;
+        m_tilesThrashedByMip[std::min(texture->GetTileMip(tileIndex), StatsMipLevels - 1)]++;
+    }
+
+    void FeedbackManagerImpl::MapVolumeTiles(FeedbackTextureImpl* texture, std::vector<uint32_t>& tileIndices)
+    {
+        m_minMipDirtyTextures.insert(texture);
+
+        // Heap tiles were allocated when the tiles were requested
+        std::map<uint32_t, std::vector<uint32_t>> heapTiles;
+        for (auto tileIndex : tileIndices)
+        {
+            VolumeTile& tile = texture->GetVolumeTile(tileIndex);
+            if (tile.state != VolumeTileState::Pending)
+                continue;
+            tile.state = VolumeTileState::Mapped;
+            heapTiles[tile.heapId].push_back(tileIndex);
+        }
+
+        for (auto& pair : heapTiles)
+        {
+            std::vector<nvrhi::TiledTextureCoordinate> tiledTextureCoordinates;
+            std::vector<uint64_t> byteOffsets;
+            for (auto tileIndex : pair.second)
+            {
+                tiledTextureCoordinates.push_back(texture->GetTiledTextureCoordinate(tileIndex));
+                byteOffsets.push_back(uint64_t(texture->GetVolumeTile(tileIndex).heapTileIndex) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
             }
+
+            nvrhi::TiledTextureRegion tiledTextureRegion = {};
+            tiledTextureRegion.tilesNum = 1;
+            std::vector<nvrhi::TiledTextureRegion> tiledTextureRegions(tiledTextureCoordinates.size(), tiledTextureRegion);
+
+            nvrhi::TextureTilesMapping textureTilesMapping = {};
+            textureTilesMapping.numTextureRegions = (uint32_t)tiledTextureCoordinates.size();
+            textureTilesMapping.tiledTextureCoordinates = tiledTextureCoordinates.data();
+            textureTilesMapping.tiledTextureRegions = tiledTextureRegions.data();
+            textureTilesMapping.byteOffsets = byteOffsets.data();
+            textureTilesMapping.heap = m_heapAllocator->GetHeapHandle(pair.first);
+
+            m_device->updateTextureTileMappings(texture->GetReservedTexture(), &textureTilesMapping, 1);
+        }
+    }
+
+    void FeedbackManagerImpl::MapTiles(FeedbackTextureImpl* texture, std::vector<uint32_t>& tileIndices)
+    {
+        if (texture->IsVolume())
+        {
+            MapVolumeTiles(texture, tileIndices);
+            return;
+        }
+
+        m_minMipDirtyTextures.insert(texture);
+
+        // The tiled texture manager tracks every array slice on its own
+        std::map<nvrhi::HeapHandle, std::vector<std::pair<uint32_t, uint64_t>>> heapTilesMapping;
+        std::vector<uint32_t> sliceTiles;
+        for (uint32_t slice = 0; slice < texture->GetNumSlices(); slice++)
+        {
+            sliceTiles.clear();
+            for (auto tileIndex : tileIndices)
+            {
+                if (texture->GetTileSlice(tileIndex) == slice)
+                    sliceTiles.push_back(texture->GetSliceTileIndex(tileIndex));
+            }
+            if (sliceTiles.empty())
+                continue;
+
+            uint32_t tiledTextureId = texture->GetTiledTextureId(slice);
+            m_tiledTextureManager->UpdateTilesMapping(tiledTextureId, sliceTiles);
+            const auto& tilesAllocations = m_tiledTextureManager->GetTileAllocations(tiledTextureId);
+
+            // Uniform tiles go to their constant tile instead of the heap tile allocated for them
+            for (auto sliceTileIndex : sliceTiles)
+            {
+                uint32_t tileIndex = texture->GetTileIndex(slice, sliceTileIndex);
+                nvrhi::HeapHandle heap;
+                uint64_t byteOffset;
+                if (texture->IsTileUniform(tileIndex) && GetConstantTile(texture, tileIndex, heap, byteOffset))
+                {
+                    if (!texture->IsTileMappedToConstant(tileIndex))
+                    {
+                        texture->SetTileMappedToConstant(tileIndex, true);
+                        m_tilesUniform++;
+                    }
+                }
+                else
+                {
+                    heap = m_heapAllocator->GetHeapHandle(tilesAllocations[sliceTileIndex].heapId);
+                    byteOffset = uint64_t(tilesAllocations[sliceTileIndex].heapTileIndex) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+                }
+                heapTilesMapping[heap].push_back(std::make_pair(tileIndex, byteOffset));
+            }
+        }
+
+        // Now loop heaps
+        for (auto& pair : heapTilesMapping)
+        {
+            nvrhi::HeapHandle heap = pair.first;
+            auto& heapTiles = pair.second;
+            uint32_t numTiles = (uint32_t)heapTiles.size();
+
+            std::vector<nvrhi::TiledTextureCoordinate> tiledTextureCoordinates;
+            std::vector<nvrhi::TiledTextureRegion> tiledTextureRegions;
+            std::vector<uint64_t> byteOffsets;
+
+            for (UINT i = 0; i < numTiles; i++)
+            {
+                uint32_t tileIndex = heapTiles[i].first;
+                tiledTextureCoordinates.push_back(texture->GetTiledTextureCoordinate(tileIndex));
+
+                nvrhi::TiledTextureRegion tiledTextureRegion = {};
+                tiledTextureRegion.tilesNum = 1;
+                tiledTextureRegions.push_back(tiledTextureRegion);
+
+                byteOffsets.push_back(heapTiles[i].second);
+            }
+
+            nvrhi::TextureTilesMapping textureTilesMapping = {};
+            textureTilesMapping.numTextureRegions = (uint32_t)tiledTextureCoordinates.size();
+            textureTilesMapping.tiledTextureCoordinates = tiledTextureCoordinates.data();
+            textureTilesMapping.tiledTextureRegions = tiledTextureRegions.data();
+            textureTilesMapping.byteOffsets = byteOffsets.data();
+            textureTilesMapping.heap = heap;
+
+            m_device->updateTextureTileMappings(texture->GetReservedTexture(), &textureTilesMapping, 1);
+        }
+    }
+
+    void FeedbackManagerImpl::UpdateTileMappings(nvrhi::ICommandList* commandList, FeedbackTextureCollection* tilesReady)
+    {
+        m_timerUpdateTileMappings.Begin();
+
+        for (auto& texUpdate : tilesReady->textures)
+            MapTiles(dynamic_cast<FeedbackTextureImpl*>(texUpdate.texture), texUpdate.tileIndices);
+
+        // Uniform tiles need no data, the blocks of new constant tiles are uploaded before anything samples them
+        for (auto& pair : m_uniformTilesToMap)
+            MapTiles(pair.first, pair.second);
+        m_uniformTilesToMap.clear();
+        m_constantTiles->Update(commandList);
+
+        // Shared tiles are copied from their resident source once mapped, the copies execute after the mapping updates
+        if (!m_sharedTileCopies.empty())
+        {
+            std::map<FeedbackTextureImpl*, std::vector<uint32_t>> sharedTiles;
+            for (auto& copy : m_sharedTileCopies)
+                sharedTiles[copy.texture].push_back(copy.tileIndex);
+            for (auto& pair : sharedTiles)
+                MapTiles(pair.first, pair.second);
+
+            std::vector<FeedbackTextureTileInfo> tiles;
+            std::vector<FeedbackTextureTileInfo> sourceTiles;
+            for (auto& copy : m_sharedTileCopies)
+            {
+                copy.texture->GetTileInfo(copy.tileIndex, tiles);
+                copy.sourceTexture->GetTileInfo(copy.sourceTileIndex, sourceTiles);
+
+                nvrhi::TextureSlice destSlice = {};
+                destSlice.x = tiles[0].xInTexels;
+                destSlice.y = tiles[0].yInTexels;
+                destSlice.width = tiles[0].widthInTexels;
+                destSlice.height = tiles[0].heightInTexels;
+                destSlice.depth = 1;
+                destSlice.mipLevel = tiles[0].mip;
+                destSlice.arraySlice = tiles[0].arraySlice;
+
+                nvrhi::TextureSlice sourceSlice = destSlice;
+                sourceSlice.x = sourceTiles[0].xInTexels;
+                sourceSlice.y = sourceTiles[0].yInTexels;
+                sourceSlice.mipLevel = sourceTiles[0].mip;
+                sourceSlice.arraySlice = sourceTiles[0].arraySlice;
+
+                commandList->copyTexture(copy.texture->GetReservedTexture(), destSlice, copy.sourceTexture->GetReservedTexture(), sourceSlice);
+            }
+        }
+
+        // Newly mapped tiles become sources for sharing, this frame's copies only read tiles filled on earlier frames
+        for (auto& texUpdate : tilesReady->textures)
+        {
+            FeedbackTextureImpl* texture = dynamic_cast<FeedbackTextureImpl*>(texUpdate.texture);
+            for (auto tileIndex : texUpdate.tileIndices)
+            {
+                uint64_t contentHash;
+                if (GetTileContentHash(texture, tileIndex, contentHash))
+                    m_sharedTiles.Add(texture, tileIndex, contentHash);
+            }
+        }
+        for (auto& copy : m_sharedTileCopies)
+            m_sharedTiles.Add(copy.texture, copy.tileIndex, copy.contentHash);
+        m_sharedTileCopies.clear();
+
+        // MinMip textures which don't exist yet are written once they are created
+        for (auto it = m_minMipDirtyTextures.begin(); it != m_minMipDirtyTextures.end();)
+        {
+            if (!(*it)->HasMinMipTexture())
+                it = m_minMipDirtyTextures.erase(it);
+            else
+                ++it;
         }
 
         if (!m_minMipDirtyTextures.empty())
@@ -336,25 +1417,45 @@ namespace nvfeedback
                     commandList->setTextureState(feedbackTexture->GetMinMipTexture(), nvrhi::AllSubresources, nvrhi::ResourceStates::CopyDest);
             }
 
-            std::vector<uint8_t> minMipData(4096);
-            std::vector<uint8_t> uploadData(4096 * 4);
+            // Scratch memory grows to the largest MinMip texture written this frame
+            std::vector<uint8_t> minMipData;
+            std::vector<uint8_t> uploadData;
+            std::vector<float> volumeMinMipData;
             for (auto& texture : m_minMipDirtyTextures)
             {
-                m_tiledTextureManager->WriteMinMipData(texture->GetTiledTextureId(), minMipData.data());
-                rtxts::TextureDesc desc = m_tiledTextureManager->GetTextureDesc(texture->GetTiledTextureId(), rtxts::TextureTypes::eMinMipTexture);
-                uint32_t rowPitch = (desc.textureOrMipRegionWidth * sizeof(float) + 0xFF) & ~0xFF;
+                // Volume textures have one MinMip texel per tile of the first mip
+                if (texture->IsVolume())
+                {
+                    texture->WriteVolumeMinMipData(volumeMinMipData);
+                    const nvrhi::TextureDesc& desc = texture->GetMinMipTexture()->getDesc();
+                    size_t rowPitch = desc.width * sizeof(float);
+                    size_t depthPitch = rowPitch * desc.height;
+                    commandList->writeTexture(texture->GetMinMipTexture(), 0, 0, volumeMinMipData.data(), rowPitch, depthPitch);
+                    continue;
+                }
 
-                uint8_t* pUploadData = uploadData.data();
-                for (uint32_t y = 0; y < desc.textureOrMipRegionHeight; ++y)
+                // Every array slice has its own MinMip data
+                for (uint32_t slice = 0; slice < texture->GetNumSlices(); slice++)
                 {
-                    float* pDataFloat = reinterpret_cast<float*>(pUploadData);
-                    for (uint32_t x = 0; x < desc.textureOrMipRegionWidth; ++x)
-                        pDataFloat[x] = minMipData[y * desc.textureOrMipRegionWidth + x];
+                    rtxts::TextureDesc desc = m_tiledTextureManager->GetTextureDesc(texture->GetTiledTextureId(slice), rtxts::TextureTypes::eMinMipTexture);
+                    uint32_t rowPitch = (desc.textureOrMipRegionWidth * sizeof(float) + 0xFF) & ~0xFF;
+                    minMipData.resize(std::max(minMipData.size(), size_t(desc.textureOrMipRegionWidth) * desc.textureOrMipRegionHeight));
+                    uploadData.resize(std::max(uploadData.size(), size_t(rowPitch) * desc.textureOrMipRegionHeight));
 
-                    pUploadData += rowPitch;
-                }
+                    m_tiledTextureManager->WriteMinMipData(texture->GetTiledTextureId(slice), minMipData.data());
 
-                commandList->writeTexture(texture->GetMinMipTexture(), 0, 0, uploadData.data(), rowPitch);
+                    uint8_t* pUploadData = uploadData.data();
+                    for (uint32_t y = 0; y < desc.textureOrMipRegionHeight; ++y)
+                    {
+                        float* pDataFloat = reinterpret_cast<float*>(pUploadData);
+                        for (uint32_t x = 0; x < desc.textureOrMipRegionWidth; ++x)
+                            pDataFloat[x] = minMipData[y * desc.textureOrMipRegionWidth + x];
+
+                        pUploadData += rowPitch;
+                    }
+
+                    commandList->writeTexture(texture->GetMinMipTexture(), slice, 0, uploadData.data(), rowPitch);
+                }
             }
 
             if (!useAutomaticBarriers)
@@ -412,18 +1513,25 @@ namespace nvfeedback
 
     void FeedbackManagerImpl::EndFrame()
     {
-        // Cycle textures which were updated in this frame to the back of the ringbuffer
-        if (m_texturesRingbuffer.size() > 0 && m_updateConfigThisFrame.maxTexturesToUpdate > 0)
+        // Cycle textures which were updated in this frame to the back of the ringbuffer, textures without feedback were skipped
+        if (m_texturesRingbuffer.size() > 0 && m_updateConfigThisFrame.maxTexturesToUpdate > 0 && !m_texturesToReadback[m_frameIndex].empty())
         {
-            uint32_t numTexturesToUpdate = m_updateConfigThisFrame.maxTexturesToUpdate;
-            for (uint32_t i = 0; i < numTexturesToUpdate; i++)
+            // One pass over the ringbuffer, the cycled textures keep their order
+            const std::vector<FeedbackTextureImpl*>& readbackTextures = m_texturesToReadback[m_frameIndex];
+            std::set<FeedbackTextureImpl*> cycledTextures(readbackTextures.begin(), readbackTextures.end());
+            std::list<FeedbackTextureImpl*> cycled;
+            for (auto it = m_texturesRingbuffer.begin(); it != m_texturesRingbuffer.end();)
             {
-                FeedbackTextureImpl* tex = m_texturesRingbuffer.front();
-                m_texturesRingbuffer.pop_front();
-                m_texturesRingbuffer.push_back(tex);
+                auto next = std::next(it);
+                if (cycledTextures.count(*it))
+                    cycled.splice(cycled.end(), m_texturesRingbuffer, it);
+                it = next;
             }
+            m_texturesRingbuffer.splice(m_texturesRingbuffer.end(), cycled);
         }
 
+        m_smallTextures->Update(m_frameNumber);
+
         // Save stats
         m_statsLastFrame.heapAllocationInBytes = m_heapAllocator->GetTotalAllocatedBytes();
 
@@ -438,6 +1546,33 @@ namespace nvfeedback
             m_statsLastFrame.heapTilesFree = statistics.heapFreeTilesNum;
             m_statsLastFrame.tilesStandby = statistics.standbyTilesNum;
         }
+
+        {
+            TileCacheStats tileCacheStats = m_tileCache->GetStats();
+            m_statsLastFrame.tileCacheSizeInBytes = tileCacheStats.sizeInBytes;
+            m_statsLastFrame.tileCacheTiles = tileCacheStats.numTiles;
+            m_statsLastFrame.tileCacheHits = tileCacheStats.hits;
+            m_statsLastFrame.tileCacheMisses = tileCacheStats.misses;
+            for (uint32_t mip = 0; mip < StatsMipLevels; mip++)
+            {
+                m_statsLastFrame.tileCacheHitsByMip[mip] = tileCacheStats.hitsByMip[mip];
+                m_statsLastFrame.tileCacheMissesByMip[mip] = tileCacheStats.missesByMip[mip];
+            }
+        }
+
+        m_statsLastFrame.tilesDuplicate = m_sharedTiles.GetNumDuplicateTiles();
+        m_statsLastFrame.tilesShared = m_tilesShared;
+        m_statsLastFrame.tilesUniform = m_tilesUniform;
+        m_statsLastFrame.constantTiles = m_constantTiles->GetNumTiles();
+        m_statsLastFrame.tilesVolume = m_volumeTiles->GetNumAllocatedTiles();
+        m_statsLastFrame.smallTextures = m_smallTextures->GetNumTextures();
+        m_statsLastFrame.smallTexturePageBytes = m_smallTextures->GetAllocatedBytes();
+        m_statsLastFrame.tilesThrashed = m_tilesThrashed;
+        m_statsLastFrame.tilesPrefetched = m_tilesPrefetched;
+        m_statsLastFrame.tilesPinned = m_tilesPinned;
+        m_statsLastFrame.prefetchHints = uint32_t(m_prefetchHints.size());
+        for (uint32_t mip = 0; mip < StatsMipLevels; mip++)
+            m_statsLastFrame.tilesThrashedByMip[mip] = m_tilesThrashedByMip[mip];
     }
 
     FeedbackManagerStats FeedbackManagerImpl::GetStats()
@@ -445,6 +1580,159 @@ namespace nvfeedback
         return m_statsLastFrame;
     }
 
+    bool FeedbackManagerImpl::LookupCachedTile(FeedbackTexture* texture, uint32_t tileIndex, uint32_t mip)
+    {
+        if (!m_tileCache->IsEnabled())
+            return false;
+        return m_tileCache->Lookup(static_cast<FeedbackTextureImpl*>(texture), tileIndex, mip);
+    }
+
+    bool FeedbackManagerImpl::ReadCachedTile(FeedbackTexture* texture, uint32_t tileIndex, void* dest, size_t size)
+    {
+        return m_tileCache->Read(static_cast<FeedbackTextureImpl*>(texture), tileIndex, dest, size);
+    }
+
+    void FeedbackManagerImpl::WriteCachedTile(FeedbackTexture* texture, uint32_t tileIndex, uint32_t mip, TileRefetchCost cost, std::vector<uint8_t>&& data)
+    {
+        m_tileCache->Write(static_cast<FeedbackTextureImpl*>(texture), tileIndex, mip, cost, std::move(data));
+    }
+
+    nvrhi::BufferHandle FeedbackManagerImpl::AcquireResolveBuffer(uint64_t byteSize)
+    {
+        std::vector<nvrhi::BufferHandle>& pool = m_resolveBufferPool[byteSize];
+        if (!pool.empty())
+        {
+            nvrhi::BufferHandle buffer = pool.back();
+            pool.pop_back();
+            return buffer;
+        }
+
+        nvrhi::BufferDesc bufferDesc = {};
+        bufferDesc.byteSize = byteSize;
+        bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
+        bufferDesc.initialState = nvrhi::ResourceStates::ResolveDest;
+        bufferDesc.debugName = "Resolve Buffer";
+        return m_device->createBuffer(bufferDesc);
+    }
+
+    void FeedbackManagerImpl::ReleaseResolveBuffer(nvrhi::BufferHandle buffer)
+    {
+        if (buffer)
+            m_resolveBufferPool[buffer->getDesc().byteSize].push_back(buffer);
+    }
+
+    bool FeedbackManagerImpl::GetConstantTile(FeedbackTextureImpl* texture, uint32_t tileIndex, nvrhi::HeapHandle& heap, uint64_t& byteOffset)
+    {
+        return m_constantTiles->GetTile(texture->GetReservedTexture()->getDesc().format, texture->GetUniformTileBlock(tileIndex), heap, byteOffset);
+    }
+
+    bool FeedbackManagerImpl::GetTileContentHash(FeedbackTextureImpl* texture, uint32_t tileIndex, uint64_t& contentHash)
+    {
+        std::shared_ptr<TileDataProvider> provider = texture->GetTileDataProvider();
+        if (!provider || texture->IsTilePacked(tileIndex))
+            return false;
+
+        std::vector<FeedbackTextureTileInfo> tiles;
+        texture->GetTileInfo(tileIndex, tiles);
+        return provider->GetTileContentHash(tiles[0], contentHash);
+    }
+
+    bool FeedbackManagerImpl::ShareTile(FeedbackTexture* texture, uint32_t tileIndex)
+    {
+        FeedbackTextureImpl* textureImpl = static_cast<FeedbackTextureImpl*>(texture);
+        uint64_t contentHash;
+        if (!GetTileContentHash(textureImpl, tileIndex, contentHash))
+            return false;
+
+        std::vector<FeedbackTextureTileInfo> tiles;
+        textureImpl->GetTileInfo(tileIndex, tiles);
+        const nvrhi::TextureDesc& desc = textureImpl->GetReservedTexture()->getDesc();
+
+        // The source needs the same format and tile size. A subresource can't be both source and destination of a copy.
+        std::vector<FeedbackTextureTileInfo> sourceTiles;
+        auto accept = [&](const SharedTileTable::Tile& candidate)
+        {
+            FeedbackTextureImpl* sourceTexture = static_cast<FeedbackTextureImpl*>(const_cast<void*>(candidate.texture));
+            if (sourceTexture->GetReservedTexture()->getDesc().format != desc.format)
+                return false;
+
+            sourceTexture->GetTileInfo(candidate.tileIndex, sourceTiles);
+            return sourceTiles[0].widthInTexels == tiles[0].widthInTexels && sourceTiles[0].heightInTexels == tiles[0].heightInTexels &&
+                (sourceTexture != textureImpl || sourceTiles[0].mip != tiles[0].mip || sourceTiles[0].arraySlice != tiles[0].arraySlice);
+        };
+
+        SharedTileTable::Tile source;
+        if (!m_sharedTiles.Find(contentHash, accept, source))
+            return false;
+
+        SharedTileCopy copy;
+        copy.texture = textureImpl;
+        copy.tileIndex = tileIndex;
+        copy.sourceTexture = static_cast<FeedbackTextureImpl*>(const_cast<void*>(source.texture));
+        copy.sourceTileIndex = source.tileIndex;
+        copy.contentHash = contentHash;
+        m_sharedTileCopies.push_back(copy);
+        m_tilesShared++;
+        return true;
+    }
+
+    void FeedbackManagerImpl::RetryTiles(FeedbackTexture* texture, const std::vector<uint32_t>& tileIndices)
+    {
+        // Reading the tile again right away would most likely fail the same way
+        const float retryDelaySeconds = 1.0f;
+        float retryTime = float(GetTickCount64()) / 1000.0f + retryDelaySeconds;
+        FeedbackTextureImpl* textureImpl = static_cast<FeedbackTextureImpl*>(texture);
+        for (auto tileIndex : tileIndices)
+            m_retryTiles[std::make_pair(textureImpl, tileIndex)] = retryTime;
+    }
+
+    void FeedbackManagerImpl::ReturnRetryTiles(float timeStamp, FeedbackTextureCollection* results)
+    {
+        // The tiles are ordered by texture, so each texture gets a single update
+        FeedbackTextureUpdate update;
+        for (auto it = m_retryTiles.begin(); it != m_retryTiles.end();)
+        {
+            FeedbackTextureImpl* texture = it->first.first;
+            uint32_t tileIndex = it->first.second;
+            if (it->second > timeStamp)
+            {
+                ++it;
+                continue;
+            }
+
+            // Volume tiles no longer requested have been unmapped and are not waiting for data anymore
+            if (!texture->IsVolume() || texture->GetVolumeTile(tileIndex).state == VolumeTileState::Pending)
+            {
+                if (!update.tileIndices.empty() && update.texture != texture)
+                {
+                    results->textures.push_back(update);
+                    update.tileIndices.clear();
+                }
+                update.texture = texture;
+                update.tileIndices.push_back(tileIndex);
+            }
+            it = m_retryTiles.erase(it);
+        }
+        if (!update.tileIndices.empty())
+            results->textures.push_back(update);
+    }
+
+    void FeedbackManagerImpl::RequestVolumeRegion(FeedbackTexture* texture, const FeedbackTextureTileInfo& region)
+    {
+        float timeStamp = float(GetTickCount64()) / 1000.0f;
+        static_cast<FeedbackTextureImpl*>(texture)->RequestVolumeRegion(region, timeStamp);
+    }
+
+    bool IsTiledFormatSupported(nvrhi::Format format)
+    {
+        // Standard tiles hold a power of two number of blocks, depth formats can't be reserved textures with sampler feedback
+        const nvrhi::FormatInfo& formatInfo = nvrhi::getFormatInfo(format);
+        uint32_t bytesPerBlock = formatInfo.bytesPerBlock;
+        if (format == nvrhi::Format::UNKNOWN || bytesPerBlock == 0 || (bytesPerBlock & (bytesPerBlock - 1)) != 0 || bytesPerBlock > 16)
+            return false;
+        return !formatInfo.hasDepth && !formatInfo.hasStencil;
+    }
+
     // CreateFeedbackManager
     FeedbackManager* CreateFeedbackManager(nvrhi::IDevice* device, const FeedbackManagerDesc& desc)
     {
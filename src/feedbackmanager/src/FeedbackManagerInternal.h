@@ -27,6 +27,11 @@
 #include "../include/FeedbackManager.h"
 #include "FeedbackTexture.h"
 #include "FeedbackTextureSet.h"
+#include "ConstantTilePool.h"
+#include "SharedTileTable.h"
+#include "SmallTexturePool.h"
+#include "TileCache.h"
+#include "VolumeTileAllocator.h"
 
 #include "rtxts-ttm/TiledTextureManager.h"
 
@@ -116,12 +121,33 @@ namespace nvfeedback
 
         ~FeedbackManagerImpl() override;
         bool CreateTexture(const nvrhi::TextureDesc& desc, FeedbackTexture** ppTex) override;
+        bool IsSmallTexture(const nvrhi::TextureDesc& desc) override;
+        nvrhi::TextureHandle CreateSmallTexture(const nvrhi::TextureDesc& desc) override;
         bool CreateTextureSet(FeedbackTextureSet** ppTexSet) override;
         void BeginFrame(nvrhi::ICommandList* commandList, const FeedbackUpdateConfig& config, FeedbackTextureCollection* results) override;
         void UpdateTileMappings(nvrhi::ICommandList* commandList, FeedbackTextureCollection* tilesReady) override;
         void ResolveFeedback(nvrhi::ICommandList* commandList) override;
         void EndFrame() override;
         FeedbackManagerStats GetStats() override;
+        bool LookupCachedTile(FeedbackTexture* texture, uint32_t tileIndex, uint32_t mip) override;
+        bool ReadCachedTile(FeedbackTexture* texture, uint32_t tileIndex, void* dest, size_t size) override;
+        void WriteCachedTile(FeedbackTexture* texture, uint32_t tileIndex, uint32_t mip, TileRefetchCost cost, std::vector<uint8_t>&& data) override;
+        bool ShareTile(FeedbackTexture* texture, uint32_t tileIndex) override;
+        void RetryTiles(FeedbackTexture* texture, const std::vector<uint32_t>& tileIndices) override;
+        void RequestVolumeRegion(FeedbackTexture* texture, const FeedbackTextureTileInfo& region) override;
+        void PrefetchRegion(FeedbackTexture* texture, uint32_t mip, const FeedbackUvRect& uvRect, float deadlineSeconds) override;
+        void PrefetchTexture(FeedbackTexture* texture, uint32_t mip, float deadlineSeconds) override;
+        void SaveResidencySnapshot(std::vector<uint8_t>& data) override;
+        uint32_t LoadResidencySnapshot(const std::vector<uint8_t>& data, float deadlineSeconds) override;
+        void InjectFeedback(FeedbackTexture* texture, uint32_t mip, const FeedbackUvRect& uvRect) override;
+        void InjectFeedbackMinMips(FeedbackTexture* texture, const uint8_t* minMipData, size_t regionsNum) override;
+        bool CreateFeedbackView(const FeedbackViewDesc& desc, uint32_t* pView) override;
+        void SetFeedbackViewDesc(uint32_t view, const FeedbackViewDesc& desc) override;
+        void DestroyFeedbackView(uint32_t view) override;
+        float GetFeedbackViewMipBias(uint32_t view) override;
+        void InjectViewFeedbackMinMips(uint32_t view, FeedbackTexture* texture, const uint8_t* minMipData, size_t regionsNum) override;
+        void NotifyCameraCut() override;
+        bool IsCameraCutBurst() override { return m_cameraCutBurst; }
 
         // Internal
 
@@ -129,21 +155,90 @@ namespace nvfeedback
         void UnregisterTexture(FeedbackTextureImpl* pTex);
 
         void UpdateTextureRingBufferState(FeedbackTextureImpl* pTex, bool includeInRingBuffer);
+        void SetMinMipDirty(FeedbackTextureImpl* pTex) { m_minMipDirtyTextures.insert(pTex); }
+        void UpdateResidentTiles(FeedbackTextureImpl* pTex, uint32_t previousResidentTiles);
 
         rtxts::TiledTextureManager* GetTiledTextureManager() { return m_tiledTextureManager.get(); }
 
     private:
+        // Tiles requested ahead of time until a deadline, in feedback regions of the first mip
+        struct PrefetchHint
+        {
+            FeedbackTextureImpl* texture;
+            uint8_t mip;
+            uint32_t regionX0;
+            uint32_t regionY0;
+            uint32_t regionX1;
+            uint32_t regionY1;
+            float deadline; // Expires the tile timeout after the deadline, taken from the update config when checked
+            std::vector<uint8_t> regionMips; // Per feedback region of every slice, replaces the region and mip if not empty
+        };
+
+        // A tile filled by copying a resident tile with the same content
+        struct SharedTileCopy
+        {
+            FeedbackTextureImpl* texture;
+            uint32_t tileIndex;
+            FeedbackTextureImpl* sourceTexture;
+            uint32_t sourceTileIndex;
+            uint64_t contentHash;
+        };
+
+        void MapTiles(FeedbackTextureImpl* texture, std::vector<uint32_t>& tileIndices);
+        void MapVolumeTiles(FeedbackTextureImpl* texture, std::vector<uint32_t>& tileIndices);
+        void UpdateVolumeTiles(FeedbackTextureImpl* texture, float timeStamp, FeedbackTextureCollection* results);
+        void ReturnRetryTiles(float timeStamp, FeedbackTextureCollection* results);
+        bool GetTileContentHash(FeedbackTextureImpl* texture, uint32_t tileIndex, uint64_t& contentHash);
+        bool GetConstantTile(FeedbackTextureImpl* texture, uint32_t tileIndex, nvrhi::HeapHandle& heap, uint64_t& byteOffset);
+
+        // Tile timeouts and request hysteresis
+        float GetTileTimeout(uint32_t mip) const;
+        void HoldRequestedMips(FeedbackTextureImpl* texture, const uint8_t* minMipData, size_t regionsNum, float timeStamp, std::vector<uint8_t>& heldMipData);
+        void CountThrashedTile(FeedbackTextureImpl* texture, uint32_t tileIndex);
+
+        // Updates a texture with the tiles of its resident mip floor and prefetch hints only. An infinite timeout requests
+        // them and leaves the state of all other tiles untouched, a zero timeout also releases every other tile.
+        void RequestPinnedTiles(FeedbackTextureImpl* texture, float timeStamp, float timeout);
+
+        // Prefetch hints
+        void UpdatePrefetchMips(FeedbackTextureImpl* texture);
+        void ExpirePrefetchHints(float timeStamp);
+
+        // Makes the followers in the texture sets of a primary texture match its requested tiles
+        void UpdateFollowerTextures(FeedbackTextureImpl* primaryTexture, float timeStamp);
+
+        // Merges the feedback injected since the last frame into the requested mips of a texture, by view
+        void MergeInjectedMips(FeedbackTextureImpl* texture, std::vector<uint8_t>& requestedMips);
+
+        // Mips the requests of a view merged on the CPU are moved by, from the weight of the view
+        int32_t GetViewMipBias(uint32_t view);
+
+        // Orders the tiles to stream so every view gets its budget share of the first tiles
+        void InterleaveViewUpdates(FeedbackTextureCollection* results);
+
+        // Reorders the tiles to stream by mip level, coarsest first over all textures
+        void SortTilesCoarseFirst(FeedbackTextureCollection* results);
+
+        // Adds the regions and mips the feedback of a texture is moving towards to its requested mips
+        void PredictRequestedMips(FeedbackTextureImpl* texture, std::vector<uint8_t>& requestedMips);
+
+        // Resolve buffers are shared by all textures, pooled by size
+        nvrhi::BufferHandle AcquireResolveBuffer(uint64_t byteSize);
+        void ReleaseResolveBuffer(nvrhi::BufferHandle buffer);
+
         FeedbackManagerDesc m_desc;
         FeedbackUpdateConfig m_updateConfigThisFrame;
 
         uint32_t m_numFramesInFlight;
         uint32_t m_frameIndex;
+        uint32_t m_frameNumber;
 
         nvrhi::DeviceHandle m_device;
 
         std::vector<FeedbackTextureImpl*> m_textures;
         std::list<FeedbackTextureImpl*> m_texturesRingbuffer;
         std::vector<std::vector<FeedbackTextureImpl*>> m_texturesToReadback;
+        std::map<uint64_t, std::vector<nvrhi::BufferHandle>> m_resolveBufferPool;
 
         FeedbackManagerStats m_statsLastFrame;
 
@@ -153,6 +248,35 @@ namespace nvfeedback
 
         std::shared_ptr<HeapAllocator> m_heapAllocator;
         std::shared_ptr<rtxts::TiledTextureManager> m_tiledTextureManager;
+        std::unique_ptr<VolumeTileAllocator> m_volumeTiles;
         std::set<FeedbackTextureImpl*> m_minMipDirtyTextures;
+        std::unique_ptr<TileCache> m_tileCache;
+        SharedTileTable m_sharedTiles;
+        std::unique_ptr<ConstantTilePool> m_constantTiles;
+        std::unique_ptr<SmallTexturePool> m_smallTextures;
+        std::map<FeedbackTextureImpl*, std::vector<uint32_t>> m_uniformTilesToMap;
+        uint32_t m_tilesUniform;
+        std::vector<SharedTileCopy> m_sharedTileCopies;
+        std::map<std::pair<FeedbackTextureImpl*, uint32_t>, float> m_retryTiles; // Time the tile is returned again
+        uint64_t m_tilesShared;
+        uint64_t m_tilesThrashed;
+        uint64_t m_tilesThrashedByMip[StatsMipLevels];
+        uint64_t m_tilesPrefetched;
+        uint32_t m_tilesPinned;
+        std::vector<PrefetchHint> m_prefetchHints;
+        std::set<FeedbackTextureImpl*> m_injectedTextures;
+
+        struct FeedbackView
+        {
+            FeedbackViewDesc desc;
+            bool inUse;
+        };
+        std::vector<FeedbackView> m_views;
+        float m_cameraPosition[3];
+        bool m_cameraMoved;
+        uint32_t m_staleReadbackFrames;
+        uint32_t m_cameraCutBurstFramesLeft;
+        bool m_cameraCutBurst;
+        bool m_readbackAllTextures;
     };
 }
@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+
+#include "FeedbackMerge.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FEEDBACK_MERGE_WITH_SSE2 1
+#endif
+
+namespace nvfeedback
+{
+    void MergeMinMips(uint8_t* minMips, const uint8_t* requestedMips, size_t regionsNum)
+    {
+        size_t region = 0;
+
+#ifdef FEEDBACK_MERGE_WITH_SSE2
+        for (; region + 64 <= regionsNum; region += 64)
+        {
+            for (size_t i = 0; i < 64; i += 16)
+            {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(minMips + region + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(requestedMips + region + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(minMips + region + i), _mm_min_epu8(a, b));
+            }
+        }
+#endif
+
+        for (; region < regionsNum; region++)
+            minMips[region] = requestedMips[region] < minMips[region] ? requestedMips[region] : minMips[region];
+    }
+
+    void MergeViewMinMips(uint8_t* minMips, uint8_t* regionViews, const uint8_t* viewMips, size_t regionsNum, int32_t mipBias, uint8_t view)
+    {
+        size_t region = 0;
+        int32_t bias = mipBias < -0xFE ? -0xFE : (mipBias > 0xFE ? 0xFE : mipBias);
+
+#ifdef FEEDBACK_MERGE_WITH_SSE2
+        // Saturating arithmetic moves the mips, requests which reach 0xFF stop at the coarsest mip that is not 0xFF
+        const __m128i notRequested = _mm_set1_epi8(char(0xFF));
+        const __m128i coarsest = _mm_set1_epi8(char(0xFE));
+        const __m128i biasUp = _mm_set1_epi8(char(bias > 0 ? bias : 0));
+        const __m128i biasDown = _mm_set1_epi8(char(bias < 0 ? -bias : 0));
+        const __m128i viewIndex = _mm_set1_epi8(char(view));
+        for (; region + 16 <= regionsNum; region += 16)
+        {
+            __m128i mips = _mm_loadu_si128(reinterpret_cast<const __m128i*>(viewMips + region));
+            __m128i unrequested = _mm_cmpeq_epi8(mips, notRequested);
+            __m128i biased = _mm_min_epu8(_mm_subs_epu8(_mm_adds_epu8(mips, biasUp), biasDown), coarsest);
+            biased = _mm_or_si128(biased, unrequested);
+
+            __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(minMips + region));
+            __m128i merged = _mm_min_epu8(current, biased);
+            __m128i finer = _mm_xor_si128(_mm_cmpeq_epi8(merged, current), notRequested);
+            __m128i views = _mm_loadu_si128(reinterpret_cast<const __m128i*>(regionViews + region));
+            views = _mm_or_si128(_mm_and_si128(finer, viewIndex), _mm_andnot_si128(finer, views));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(minMips + region), merged);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(regionViews + region), views);
+        }
+#endif
+
+        for (; region < regionsNum; region++)
+        {
+            if (viewMips[region] == 0xFF)
+                continue;
+
+            int32_t mip = int32_t(viewMips[region]) + bias;
+            mip = mip < 0 ? 0 : (mip > 0xFE ? 0xFE : mip);
+            if (uint8_t(mip) < minMips[region])
+            {
+                minMips[region] = uint8_t(mip);
+                regionViews[region] = view;
+            }
+        }
+    }
+
+    void MergeMinMipRect(uint8_t* minMips, uint32_t regionsX, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, uint8_t mip)
+    {
+        for (uint32_t y = y0; y < y1; y++)
+        {
+            uint8_t* row = minMips + size_t(y) * regionsX;
+            for (uint32_t x = x0; x < x1; x++)
+                row[x] = mip < row[x] ? mip : row[x];
+        }
+    }
+}
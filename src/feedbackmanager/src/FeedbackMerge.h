@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Requests of feedback regions are min mip grids as read back from sampler feedback, one byte per region with 0xFF if
+// the region is not requested. Merging requests keeps the finest mip of every region.
+// These kernels have no graphics API dependencies, tools/feedbackbench measures them on their own.
+
+namespace nvfeedback
+{
+    // minMips[i] = min(minMips[i], requestedMips[i])
+    void MergeMinMips(uint8_t* minMips, const uint8_t* requestedMips, size_t regionsNum);
+
+    // Requests a mip in the regions [x0, x1) x [y0, y1) of a grid with regionsX regions per row
+    void MergeMinMipRect(uint8_t* minMips, uint32_t regionsX, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, uint8_t mip);
+
+    // Merges the requests of a view, moved mipBias mips coarser (finer if negative) but never to 0xFF, and sets the
+    // region views to the view where its request is finer than the requests merged so far
+    void MergeViewMinMips(uint8_t* minMips, uint8_t* regionViews, const uint8_t* viewMips, size_t regionsNum, int32_t mipBias, uint8_t view);
+}
@@ -14,13 +14,17 @@
 #include "FeedbackManagerInternal.h"
 #include <nvrhi/d3d12.h>
 
-#include <array>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace nvfeedback
 {
     FeedbackTextureImpl::FeedbackTextureImpl(const nvrhi::TextureDesc& desc, FeedbackManagerImpl* pFeedbackManager, rtxts::TiledTextureManager* tiledTextureManager, nvrhi::IDevice* device, uint32_t numReadbacks) :
         m_pFeedbackManager(pFeedbackManager),
-        m_refCount(1)
+        m_device(device),
+        m_refCount(1),
+        m_residencyKey(desc.debugName)
     {
         // Reserved texture
         {
@@ -32,76 +36,125 @@ namespace nvfeedback
             m_reservedTexture = device->createTexture(textureDesc);
         }
 
-        // Get tiling info
+        // Get tiling info, all array slices share the tiling of the first one
         m_numTiles = 0;
         m_packedMipDesc = {};
         m_tileShape = {};
-        uint32_t mipLevels = desc.mipLevels;
-        std::array<nvrhi::SubresourceTiling, 16> tilingsInfo;
+        uint32_t mipLevels = std::max(desc.mipLevels, 1u);
+        std::vector<nvrhi::SubresourceTiling> tilingsInfo(mipLevels);
         device->getTextureTiling(m_reservedTexture, &m_numTiles, &m_packedMipDesc, &m_tileShape, &mipLevels, tilingsInfo.data());
 
-        rtxts::TiledLevelDesc tiledLevelDescs[16];
+        std::vector<rtxts::TiledLevelDesc> tiledLevelDescs(tilingsInfo.size());
         rtxts::TiledTextureDesc tiledTextureDesc = {};
         tiledTextureDesc.textureWidth = desc.width;
         tiledTextureDesc.textureHeight = desc.height;
-        tiledTextureDesc.tiledLevelDescs = tiledLevelDescs;
+        tiledTextureDesc.tiledLevelDescs = tiledLevelDescs.data();
         tiledTextureDesc.regularMipLevelsNum = m_packedMipDesc.numStandardMips;
         tiledTextureDesc.packedMipLevelsNum = m_packedMipDesc.numPackedMips;
         tiledTextureDesc.packedTilesNum = m_packedMipDesc.numTilesForPackedMips;
         tiledTextureDesc.tileWidth = m_tileShape.widthInTexels;
         tiledTextureDesc.tileHeight = m_tileShape.heightInTexels;
 
+        m_regularTilesPerSlice = 0;
         for (uint32_t i = 0; i < tiledTextureDesc.regularMipLevelsNum; ++i)
         {
             tiledLevelDescs[i].widthInTiles = tilingsInfo[i].widthInTiles;
             tiledLevelDescs[i].heightInTiles = tilingsInfo[i].heightInTiles;
+            m_regularTilesPerMip.push_back(tilingsInfo[i].widthInTiles * tilingsInfo[i].heightInTiles * std::max(tilingsInfo[i].depthInTiles, 1u));
+            m_regularTilesPerSlice += m_regularTilesPerMip.back();
         }
+        m_tilesPerSlice = m_regularTilesPerSlice + m_packedMipDesc.numTilesForPackedMips;
 
-        tiledTextureManager->AddTiledTexture(tiledTextureDesc, m_tiledTextureId);
-        
-        rtxts::TextureDesc feedbackDesc = tiledTextureManager->GetTextureDesc(m_tiledTextureId, rtxts::eFeedbackTexture);
-        if (device->getGraphicsAPI() == nvrhi::GraphicsAPI::D3D12)
-        {
-            nvrhi::d3d12::IDevice* deviceD3D12 = static_cast<nvrhi::d3d12::IDevice*>(device);
-            nvrhi::SamplerFeedbackTextureDesc samplerFeedbackTextureDesc = {};
-            samplerFeedbackTextureDesc.samplerFeedbackFormat = nvrhi::SamplerFeedbackFormat::MinMipOpaque;
-            samplerFeedbackTextureDesc.samplerFeedbackMipRegionX = feedbackDesc.textureOrMipRegionWidth;
-            samplerFeedbackTextureDesc.samplerFeedbackMipRegionY = feedbackDesc.textureOrMipRegionHeight;
-            samplerFeedbackTextureDesc.samplerFeedbackMipRegionZ = m_tileShape.depthInTexels;
-            samplerFeedbackTextureDesc.initialState = nvrhi::ResourceStates::UnorderedAccess;
-            samplerFeedbackTextureDesc.keepInitialState = true;
-            m_feedbackTexture = deviceD3D12->createSamplerFeedbackTexture(m_reservedTexture, samplerFeedbackTextureDesc);
-        }
+        uint32_t arraySize = std::max(desc.arraySize, 1u);
+        m_numTiles = m_tilesPerSlice * arraySize;
+        m_uniformTiles.assign(m_numTiles, false);
+        m_constantMappedTiles.assign(m_numTiles, false);
+        m_tileUnmapFrames.assign(m_numTiles, 0);
 
-        // Resolve / Readback buffer
-        uint32_t readbackBuffersNum = 1;
-        readbackBuffersNum = numReadbacks;
-        m_feedbackResolveBuffers.resize(readbackBuffersNum);
-        for (uint32_t i = 0; i < readbackBuffersNum; i++)
+        // Sampler feedback and the tiled texture manager are 2D only, volume textures track their tiles themselves
+        m_isVolume = desc.dimension == nvrhi::TextureDimension::Texture3D;
+        if (m_isVolume)
         {
-            uint32_t feedbackTilesX = (desc.width - 1) / feedbackDesc.textureOrMipRegionWidth + 1;
-            uint32_t feedbackTilesY = (desc.height - 1) / feedbackDesc.textureOrMipRegionHeight + 1;
-
-            nvrhi::BufferDesc bufferDesc = {};
-            bufferDesc.byteSize = feedbackTilesX * feedbackTilesY;
-            bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
-            bufferDesc.initialState = nvrhi::ResourceStates::ResolveDest;
-            bufferDesc.debugName = "Resolve Buffer";
-            m_feedbackResolveBuffers[i] = device->createBuffer(bufferDesc);
+            m_volumeTilings.assign(tilingsInfo.begin(), tilingsInfo.begin() + tiledTextureDesc.regularMipLevelsNum);
+            uint32_t tileIndex = 0;
+            for (uint32_t mip = 0; mip < tiledTextureDesc.regularMipLevelsNum; mip++)
+            {
+                nvrhi::SubresourceTiling& tiling = m_volumeTilings[mip];
+                tiling.depthInTiles = std::max(tiling.depthInTiles, 1u);
+                tiling.startTileIndexInOverallResource = tileIndex;
+
+                uint32_t tilesInSlice = tiling.widthInTiles * tiling.heightInTiles;
+                for (uint32_t i = 0; i < tilesInSlice * tiling.depthInTiles; i++)
+                {
+                    VolumeTile tile;
+                    tile.mip = mip;
+                    tile.x = i % tiling.widthInTiles;
+                    tile.y = (i % tilesInSlice) / tiling.widthInTiles;
+                    tile.z = i / tilesInSlice;
+                    m_volumeTiles.push_back(tile);
+                    tileIndex++;
+                }
+            }
+            for (uint32_t i = 0; i < m_packedMipDesc.numTilesForPackedMips; i++)
+            {
+                VolumeTile tile;
+                tile.mip = m_packedMipDesc.numStandardMips;
+                tile.x = i;
+                tile.y = 0;
+                tile.z = 0;
+                m_volumeTiles.push_back(tile);
+            }
+
+            // One MinMip texel per tile of the first mip
+            nvrhi::TextureDesc& textureDesc = m_minMipTextureDesc;
+            textureDesc.width = m_volumeTilings.empty() ? 1 : m_volumeTilings[0].widthInTiles;
+            textureDesc.height = m_volumeTilings.empty() ? 1 : m_volumeTilings[0].heightInTiles;
+            textureDesc.depth = m_volumeTilings.empty() ? 1 : m_volumeTilings[0].depthInTiles;
+            textureDesc.dimension = nvrhi::TextureDimension::Texture3D;
+            textureDesc.format = nvrhi::Format::R32_FLOAT;
+            textureDesc.initialState = nvrhi::ResourceStates::ShaderResource;
+            textureDesc.keepInitialState = true;
+            textureDesc.debugName = "MinMip Texture";
+            return;
         }
 
+        m_tiledTextureIds.resize(arraySize);
+        for (uint32_t slice = 0; slice < arraySize; slice++)
+            tiledTextureManager->AddTiledTexture(tiledTextureDesc, m_tiledTextureIds[slice]);
+        
+        // The sampler feedback and MinMip textures are created on first use, see GetSamplerFeedbackTexture and GetMinMipTexture
+        rtxts::TextureDesc feedbackDesc = tiledTextureManager->GetTextureDesc(m_tiledTextureIds[0], rtxts::eFeedbackTexture);
+        m_feedbackTextureDesc.samplerFeedbackFormat = nvrhi::SamplerFeedbackFormat::MinMipOpaque;
+        m_feedbackTextureDesc.samplerFeedbackMipRegionX = feedbackDesc.textureOrMipRegionWidth;
+        m_feedbackTextureDesc.samplerFeedbackMipRegionY = feedbackDesc.textureOrMipRegionHeight;
+        m_feedbackTextureDesc.samplerFeedbackMipRegionZ = m_tileShape.depthInTexels;
+        m_feedbackTextureDesc.initialState = nvrhi::ResourceStates::UnorderedAccess;
+        m_feedbackTextureDesc.keepInitialState = true;
+
+        // Resolve / Readback buffers come from a pool of the FeedbackManager while the texture is read back,
+        // they hold the decoded MinMip values of all array slices one after another
+        uint32_t feedbackTilesX = (desc.width - 1) / feedbackDesc.textureOrMipRegionWidth + 1;
+        uint32_t feedbackTilesY = (desc.height - 1) / feedbackDesc.textureOrMipRegionHeight + 1;
+        m_feedbackResolveBufferSize = uint64_t(feedbackTilesX) * feedbackTilesY * arraySize;
+        m_feedbackRegionWidth = feedbackDesc.textureOrMipRegionWidth;
+        m_feedbackRegionHeight = feedbackDesc.textureOrMipRegionHeight;
+        m_feedbackRegionsX = feedbackTilesX;
+        m_feedbackRegionsY = feedbackTilesY;
+        m_feedbackResolveBuffers.resize(numReadbacks);
+
         // MinMip texture
         {
-            rtxts::TextureDesc minMipDesc = tiledTextureManager->GetTextureDesc(m_tiledTextureId, rtxts::eMinMipTexture);
+            rtxts::TextureDesc minMipDesc = tiledTextureManager->GetTextureDesc(m_tiledTextureIds[0], rtxts::eMinMipTexture);
 
-            nvrhi::TextureDesc textureDesc = {};
+            nvrhi::TextureDesc& textureDesc = m_minMipTextureDesc;
             textureDesc.width = minMipDesc.textureOrMipRegionWidth;
             textureDesc.height = minMipDesc.textureOrMipRegionHeight;
+            textureDesc.arraySize = arraySize;
+            textureDesc.dimension = arraySize > 1 ? nvrhi::TextureDimension::Texture2DArray : nvrhi::TextureDimension::Texture2D;
             textureDesc.format = nvrhi::Format::R32_FLOAT;
             textureDesc.initialState = nvrhi::ResourceStates::ShaderResource;
             textureDesc.keepInitialState = true;
             textureDesc.debugName = "MinMip Texture";
-            m_minMipTexture = device->createTexture(textureDesc);
         }
     }
 
@@ -122,17 +175,87 @@ namespace nvfeedback
 
     nvrhi::SamplerFeedbackTextureHandle FeedbackTextureImpl::GetSamplerFeedbackTexture()
     {
+        // Textures which are never bound for drawing never get a sampler feedback texture
+        if (!m_feedbackTexture && !m_isVolume && m_device->getGraphicsAPI() == nvrhi::GraphicsAPI::D3D12)
+        {
+            nvrhi::d3d12::IDevice* deviceD3D12 = static_cast<nvrhi::d3d12::IDevice*>(m_device.Get());
+            m_feedbackTexture = deviceD3D12->createSamplerFeedbackTexture(m_reservedTexture, m_feedbackTextureDesc);
+        }
         return m_feedbackTexture;
     }
 
     nvrhi::TextureHandle FeedbackTextureImpl::GetMinMipTexture()
     {
+        if (!m_minMipTexture)
+        {
+            m_minMipTexture = m_device->createTexture(m_minMipTextureDesc);
+
+            // Filled with the current residency by the next UpdateTileMappings
+            m_pFeedbackManager->SetMinMipDirty(this);
+        }
         return m_minMipTexture;
     }
 
+    void FeedbackTextureImpl::SetTileDataProvider(std::shared_ptr<TileDataProvider> provider)
+    {
+        m_tileDataProvider = provider;
+
+        // Scan the regular tiles for uniform ones once, they are then never streamed
+        m_uniformTiles.assign(m_numTiles, false);
+        m_uniformTileBlocks.clear();
+        m_uniformBlocks.clear();
+        if (!provider || m_isVolume)
+            return;
+
+        std::vector<FeedbackTextureTileInfo> tiles;
+        std::vector<uint8_t> block;
+        for (uint32_t tileIndex = 0; tileIndex < m_numTiles; tileIndex++)
+        {
+            if (IsTilePacked(tileIndex))
+                continue;
+
+            GetTileInfo(tileIndex, tiles);
+            if (!provider->GetUniformTileBlock(tiles[0], block))
+                continue;
+
+            auto it = std::find(m_uniformBlocks.begin(), m_uniformBlocks.end(), block);
+            if (it == m_uniformBlocks.end())
+                it = m_uniformBlocks.insert(m_uniformBlocks.end(), block);
+
+            m_uniformTiles[tileIndex] = true;
+            m_uniformTileBlocks[tileIndex] = uint32_t(it - m_uniformBlocks.begin());
+        }
+    }
+
     bool FeedbackTextureImpl::IsTilePacked(uint32_t tileIndex)
     {
-        return tileIndex >= GetPackedMipInfo().startTileIndexInOverallResource;
+        return GetSliceTileIndex(tileIndex) >= m_regularTilesPerSlice;
+    }
+
+    nvrhi::TiledTextureCoordinate FeedbackTextureImpl::GetTiledTextureCoordinate(uint32_t tileIndex) const
+    {
+        if (m_isVolume)
+        {
+            const VolumeTile& tile = m_volumeTiles[tileIndex];
+
+            nvrhi::TiledTextureCoordinate tiledTextureCoordinate = {};
+            tiledTextureCoordinate.mipLevel = tile.mip;
+            tiledTextureCoordinate.x = tile.x;
+            tiledTextureCoordinate.y = tile.y;
+            tiledTextureCoordinate.z = tile.z;
+            return tiledTextureCoordinate;
+        }
+
+        uint32_t slice = GetTileSlice(tileIndex);
+        const auto& tileCoord = m_pFeedbackManager->GetTiledTextureManager()->GetTileCoordinates(m_tiledTextureIds[slice])[GetSliceTileIndex(tileIndex)];
+
+        nvrhi::TiledTextureCoordinate tiledTextureCoordinate = {};
+        tiledTextureCoordinate.mipLevel = tileCoord.mipLevel;
+        tiledTextureCoordinate.arrayLevel = slice;
+        tiledTextureCoordinate.x = tileCoord.x;
+        tiledTextureCoordinate.y = tileCoord.y;
+        tiledTextureCoordinate.z = 0;
+        return tiledTextureCoordinate;
     }
 
     void FeedbackTextureImpl::GetTileInfo(uint32_t tileIndex, std::vector<FeedbackTextureTileInfo>& tiles)
@@ -141,10 +264,10 @@ namespace nvfeedback
 
         auto& tileShape = GetTileShape();
         auto& packedMipInfo = GetPackedMipInfo();
-        const nvrhi::TextureDesc textureDesc = GetReservedTexture()->getDesc();
-        bool isBlockCompressed = (textureDesc.format >= nvrhi::Format::BC1_UNORM && textureDesc.format <= nvrhi::Format::BC7_UNORM_SRGB);
+        const nvrhi::TextureDesc& textureDesc = m_reservedTexture->getDesc();
+        const uint32_t blockSize = nvrhi::getFormatInfo(textureDesc.format).blockSize;
 
-        uint32_t firstPackedTileIndex = packedMipInfo.startTileIndexInOverallResource;
+        uint32_t slice = GetTileSlice(tileIndex);
 
         if (IsTilePacked(tileIndex))
         {
@@ -152,43 +275,61 @@ namespace nvfeedback
             {
                 uint32_t width = std::max(textureDesc.width >> mip, 1u);
                 uint32_t height = std::max(textureDesc.height >> mip, 1u);
+                uint32_t depth = m_isVolume ? std::max(textureDesc.depth >> mip, 1u) : 1;
 
-                // Round up subresource size for BC compressed formats to match block sizes
-                if (isBlockCompressed)
-                {
-                    // Round up to 4x4 blocks
-                    width = ((width + 3) / 4) * 4;
-                    height = ((height + 3) / 4) * 4;
-                }
+                // Round up subresource size to whole blocks, for block compressed formats
+                width = ((width + blockSize - 1) / blockSize) * blockSize;
+                height = ((height + blockSize - 1) / blockSize) * blockSize;
 
                 FeedbackTextureTileInfo tile;
+                tile.arraySlice = slice;
                 tile.xInTexels = 0;
                 tile.yInTexels = 0;
                 tile.mip = mip;
                 tile.widthInTexels = width;
                 tile.heightInTexels = height;
+                tile.depthInTexels = depth;
                 tiles.push_back(tile);
             }
         }
+        else if (m_isVolume)
+        {
+            const VolumeTile& volumeTile = m_volumeTiles[tileIndex];
+            uint32_t mip = volumeTile.mip;
+
+            uint32_t subresourceWidth = std::max(textureDesc.width >> mip, 1u);
+            uint32_t subresourceHeight = std::max(textureDesc.height >> mip, 1u);
+            uint32_t subresourceDepth = std::max(textureDesc.depth >> mip, 1u);
+            subresourceWidth = ((subresourceWidth + blockSize - 1) / blockSize) * blockSize;
+            subresourceHeight = ((subresourceHeight + blockSize - 1) / blockSize) * blockSize;
+
+            FeedbackTextureTileInfo tile;
+            tile.arraySlice = 0;
+            tile.mip = mip;
+            tile.xInTexels = volumeTile.x * tileShape.widthInTexels;
+            tile.yInTexels = volumeTile.y * tileShape.heightInTexels;
+            tile.zInTexels = volumeTile.z * tileShape.depthInTexels;
+            tile.widthInTexels = std::min(tileShape.widthInTexels, subresourceWidth - tile.xInTexels);
+            tile.heightInTexels = std::min(tileShape.heightInTexels, subresourceHeight - tile.yInTexels);
+            tile.depthInTexels = std::min(tileShape.depthInTexels, subresourceDepth - tile.zInTexels);
+            tiles.push_back(tile);
+        }
         else
         {
-            const auto& tileCoord = m_pFeedbackManager->GetTiledTextureManager()->GetTileCoordinates(m_tiledTextureId);
-            uint32_t tileX = tileCoord[tileIndex].x;
-            uint32_t tileY = tileCoord[tileIndex].y;
-            uint32_t mip = tileCoord[tileIndex].mipLevel;
+            const auto& tileCoord = m_pFeedbackManager->GetTiledTextureManager()->GetTileCoordinates(m_tiledTextureIds[slice]);
+            uint32_t sliceTileIndex = GetSliceTileIndex(tileIndex);
+            uint32_t tileX = tileCoord[sliceTileIndex].x;
+            uint32_t tileY = tileCoord[sliceTileIndex].y;
+            uint32_t mip = tileCoord[sliceTileIndex].mipLevel;
             uint32_t width = tileShape.widthInTexels;
             uint32_t height = tileShape.heightInTexels;
 
             uint32_t subresourceWidth = std::max(textureDesc.width >> mip, 1u);
             uint32_t subresourceHeight = std::max(textureDesc.height >> mip, 1u);
 
-            // Round up subresource size for BC compressed formats to match block sizes
-            if (isBlockCompressed)
-            {
-                // Round up to 4x4 blocks
-                subresourceWidth = ((subresourceWidth + 3) / 4) * 4;
-                subresourceHeight = ((subresourceHeight + 3) / 4) * 4;
-            }
+            // Round up subresource size to whole blocks, for block compressed formats
+            subresourceWidth = ((subresourceWidth + blockSize - 1) / blockSize) * blockSize;
+            subresourceHeight = ((subresourceHeight + blockSize - 1) / blockSize) * blockSize;
 
             uint32_t x = tileX * width;
             uint32_t y = tileY * height;
@@ -200,6 +341,7 @@ namespace nvfeedback
                 height = subresourceHeight - y;
 
             FeedbackTextureTileInfo tile;
+            tile.arraySlice = slice;
             tile.xInTexels = x;
             tile.yInTexels = y;
             tile.mip = mip;
@@ -209,6 +351,203 @@ namespace nvfeedback
         }
     }
 
+    void FeedbackTextureImpl::SetFeedbackMips(const uint8_t* minMipData, size_t regionsNum)
+    {
+        std::swap(m_feedbackMips, m_previousFeedbackMips);
+        m_feedbackMips.assign(minMipData, minMipData + regionsNum);
+    }
+
+    void FeedbackTextureImpl::ResetFeedbackHistory()
+    {
+        m_heldRegionMips.clear();
+        m_feedbackMips.clear();
+        m_previousFeedbackMips.clear();
+        m_requestedMips.clear();
+        m_regionViews.clear();
+    }
+
+    bool FeedbackTextureImpl::IsTileRequestedByFeedback(uint32_t tileIndex)
+    {
+        if (m_requestedMips.empty() || IsTilePacked(tileIndex))
+            return true;
+
+        GetTileInfo(tileIndex, m_tileInfoScratch);
+        const FeedbackTextureTileInfo& tile = m_tileInfoScratch[0];
+        if (tile.mip >= m_residentMipFloor)
+            return true;
+
+        // Feedback regions are measured in texels of the first mip
+        uint32_t x0 = (tile.xInTexels << tile.mip) / m_feedbackRegionWidth;
+        uint32_t y0 = (tile.yInTexels << tile.mip) / m_feedbackRegionHeight;
+        uint32_t x1 = std::min((((tile.xInTexels + tile.widthInTexels) << tile.mip) - 1) / m_feedbackRegionWidth, m_feedbackRegionsX - 1);
+        uint32_t y1 = std::min((((tile.yInTexels + tile.heightInTexels) << tile.mip) - 1) / m_feedbackRegionHeight, m_feedbackRegionsY - 1);
+
+        const uint8_t* sliceMips = m_requestedMips.data() + size_t(tile.arraySlice) * m_feedbackRegionsX * m_feedbackRegionsY;
+        for (uint32_t y = y0; y <= y1; y++)
+        {
+            for (uint32_t x = x0; x <= x1; x++)
+            {
+                if (sliceMips[y * m_feedbackRegionsX + x] <= tile.mip)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t FeedbackTextureImpl::GetTileMip(uint32_t tileIndex)
+    {
+        GetTileInfo(tileIndex, m_tileInfoScratch);
+        return m_tileInfoScratch[0].mip;
+    }
+
+    uint32_t FeedbackTextureImpl::GetTileView(uint32_t tileIndex)
+    {
+        if (m_regionViews.empty() || m_regionViews.size() != m_requestedMips.size() || IsTilePacked(tileIndex))
+            return 0;
+
+        GetTileInfo(tileIndex, m_tileInfoScratch);
+        const FeedbackTextureTileInfo& tile = m_tileInfoScratch[0];
+
+        uint32_t x0 = (tile.xInTexels << tile.mip) / m_feedbackRegionWidth;
+        uint32_t y0 = (tile.yInTexels << tile.mip) / m_feedbackRegionHeight;
+        uint32_t x1 = std::min((((tile.xInTexels + tile.widthInTexels) << tile.mip) - 1) / m_feedbackRegionWidth, m_feedbackRegionsX - 1);
+        uint32_t y1 = std::min((((tile.yInTexels + tile.heightInTexels) << tile.mip) - 1) / m_feedbackRegionHeight, m_feedbackRegionsY - 1);
+
+        size_t sliceOffset = size_t(tile.arraySlice) * m_feedbackRegionsX * m_feedbackRegionsY;
+        uint8_t finestMip = 0xFF;
+        uint32_t view = 0;
+        for (uint32_t y = y0; y <= y1; y++)
+        {
+            for (uint32_t x = x0; x <= x1; x++)
+            {
+                size_t region = sliceOffset + size_t(y) * m_feedbackRegionsX + x;
+                if (m_requestedMips[region] < finestMip)
+                {
+                    finestMip = m_requestedMips[region];
+                    view = m_regionViews[region];
+                }
+            }
+        }
+        return view;
+    }
+
+    void FeedbackTextureImpl::SetResidentMipFloor(uint32_t mip)
+    {
+        uint32_t previousTiles = GetNumResidentFloorTiles();
+        m_residentMipFloor = mip;
+        m_pFeedbackManager->UpdateResidentTiles(this, previousTiles);
+    }
+
+    uint32_t FeedbackTextureImpl::GetNumResidentFloorTiles() const
+    {
+        uint32_t numTiles = 0;
+        for (uint32_t mip = m_residentMipFloor; mip < uint32_t(m_regularTilesPerMip.size()); mip++)
+            numTiles += m_regularTilesPerMip[mip];
+        return numTiles * std::max(GetNumSlices(), 1u);
+    }
+
+    void FeedbackTextureImpl::GetUvRectRegions(const FeedbackUvRect& uvRect, uint32_t& x0, uint32_t& y0, uint32_t& x1, uint32_t& y1) const
+    {
+        float minU = std::clamp(std::min(uvRect.minU, uvRect.maxU), 0.0f, 1.0f);
+        float minV = std::clamp(std::min(uvRect.minV, uvRect.maxV), 0.0f, 1.0f);
+        float maxU = std::clamp(std::max(uvRect.minU, uvRect.maxU), 0.0f, 1.0f);
+        float maxV = std::clamp(std::max(uvRect.minV, uvRect.maxV), 0.0f, 1.0f);
+
+        x0 = std::min(uint32_t(minU * m_feedbackRegionsX), m_feedbackRegionsX - 1);
+        y0 = std::min(uint32_t(minV * m_feedbackRegionsY), m_feedbackRegionsY - 1);
+        x1 = std::max(std::min(uint32_t(std::ceil(maxU * m_feedbackRegionsX)), m_feedbackRegionsX), x0 + 1);
+        y1 = std::max(std::min(uint32_t(std::ceil(maxV * m_feedbackRegionsY)), m_feedbackRegionsY), y0 + 1);
+    }
+
+    FeedbackTextureTileInfo FeedbackTextureImpl::GetUvRectVolumeRegion(uint32_t mip, const FeedbackUvRect& uvRect) const
+    {
+        float minU = std::clamp(std::min(uvRect.minU, uvRect.maxU), 0.0f, 1.0f);
+        float minV = std::clamp(std::min(uvRect.minV, uvRect.maxV), 0.0f, 1.0f);
+        float maxU = std::clamp(std::max(uvRect.minU, uvRect.maxU), 0.0f, 1.0f);
+        float maxV = std::clamp(std::max(uvRect.minV, uvRect.maxV), 0.0f, 1.0f);
+
+        const nvrhi::TextureDesc& desc = m_reservedTexture->getDesc();
+        uint32_t width = std::max(desc.width >> mip, 1u);
+        uint32_t height = std::max(desc.height >> mip, 1u);
+        FeedbackTextureTileInfo region = {};
+        region.mip = mip;
+        region.xInTexels = std::min(uint32_t(minU * width), width - 1);
+        region.yInTexels = std::min(uint32_t(minV * height), height - 1);
+        region.widthInTexels = std::max(uint32_t(std::ceil(maxU * width)), region.xInTexels + 1) - region.xInTexels;
+        region.heightInTexels = std::max(uint32_t(std::ceil(maxV * height)), region.yInTexels + 1) - region.yInTexels;
+        region.depthInTexels = std::max(desc.depth >> mip, 1u);
+        return region;
+    }
+
+    void FeedbackTextureImpl::RequestVolumeRegion(const FeedbackTextureTileInfo& region, float timeStamp)
+    {
+        if (!m_isVolume || region.widthInTexels == 0 || region.heightInTexels == 0 || region.depthInTexels == 0)
+            return;
+
+        // The region at the requested mip and the region it shrinks to at every coarser regular mip
+        for (uint32_t mip = region.mip; mip < uint32_t(m_volumeTilings.size()); mip++)
+        {
+            uint32_t shift = mip - region.mip;
+            const nvrhi::SubresourceTiling& tiling = m_volumeTilings[mip];
+            uint32_t x0 = (region.xInTexels >> shift) / m_tileShape.widthInTexels;
+            uint32_t y0 = (region.yInTexels >> shift) / m_tileShape.heightInTexels;
+            uint32_t z0 = (region.zInTexels >> shift) / m_tileShape.depthInTexels;
+            uint32_t x1 = std::min(((region.xInTexels + region.widthInTexels - 1) >> shift) / m_tileShape.widthInTexels, tiling.widthInTiles - 1);
+            uint32_t y1 = std::min(((region.yInTexels + region.heightInTexels - 1) >> shift) / m_tileShape.heightInTexels, tiling.heightInTiles - 1);
+            uint32_t z1 = std::min(((region.zInTexels + region.depthInTexels - 1) >> shift) / m_tileShape.depthInTexels, tiling.depthInTiles - 1);
+
+            for (uint32_t z = z0; z <= z1; z++)
+            {
+                for (uint32_t y = y0; y <= y1; y++)
+                {
+                    for (uint32_t x = x0; x <= x1; x++)
+                    {
+                        uint32_t tileIndex = tiling.startTileIndexInOverallResource + (z * tiling.heightInTiles + y) * tiling.widthInTiles + x;
+                        // Prefetch hints request tiles until a deadline in the future, which a request made now doesn't shorten
+                        VolumeTile& volumeTile = m_volumeTiles[tileIndex];
+                        volumeTile.requestTime = std::max(volumeTile.requestTime, timeStamp);
+                    }
+                }
+            }
+        }
+    }
+
+    void FeedbackTextureImpl::WriteVolumeMinMipData(std::vector<float>& minMipData) const
+    {
+        minMipData.clear();
+        if (m_volumeTilings.empty())
+        {
+            minMipData.push_back(float(m_packedMipDesc.numStandardMips));
+            return;
+        }
+
+        // A mip is usable for a texel of the MinMip texture if the tile covering it is mapped in that mip and all coarser ones
+        const nvrhi::SubresourceTiling& firstTiling = m_volumeTilings[0];
+        minMipData.resize(size_t(firstTiling.widthInTiles) * firstTiling.heightInTiles * firstTiling.depthInTiles);
+        for (uint32_t z = 0; z < firstTiling.depthInTiles; z++)
+        {
+            for (uint32_t y = 0; y < firstTiling.heightInTiles; y++)
+            {
+                for (uint32_t x = 0; x < firstTiling.widthInTiles; x++)
+                {
+                    uint32_t minMip = m_packedMipDesc.numStandardMips;
+                    for (uint32_t mip = uint32_t(m_volumeTilings.size()); mip > 0; mip--)
+                    {
+                        const nvrhi::SubresourceTiling& tiling = m_volumeTilings[mip - 1];
+                        uint32_t tileX = std::min(x >> (mip - 1), tiling.widthInTiles - 1);
+                        uint32_t tileY = std::min(y >> (mip - 1), tiling.heightInTiles - 1);
+                        uint32_t tileZ = std::min(z >> (mip - 1), tiling.depthInTiles - 1);
+                        uint32_t tileIndex = tiling.startTileIndexInOverallResource + (tileZ * tiling.heightInTiles + tileY) * tiling.widthInTiles + tileX;
+                        if (m_volumeTiles[tileIndex].state != VolumeTileState::Mapped)
+                            break;
+                        minMip = mip - 1;
+                    }
+                    minMipData[(size_t(z) * firstTiling.heightInTiles + y) * firstTiling.widthInTiles + x] = float(minMip);
+                }
+            }
+        }
+    }
+
     uint32_t FeedbackTextureImpl::GetNumTextureSets() const
     {
         return (uint32_t)m_textureSets.size();
@@ -262,8 +601,9 @@ namespace nvfeedback
             }
         }
 
-        // Ensure this texture is in the ringbuffer, unless we use texture sets and are never a primary texture
-        bool needsRingBuffer = m_textureSets.size() == 0 || IsPrimaryTexture();
+        // Ensure this texture is in the ringbuffer, unless we use texture sets and are never a primary texture.
+        // Volume textures have no feedback to read back.
+        bool needsRingBuffer = !m_isVolume && (m_textureSets.size() == 0 || IsPrimaryTexture());
         m_pFeedbackManager->UpdateTextureRingBufferState(this, needsRingBuffer);
     }
     
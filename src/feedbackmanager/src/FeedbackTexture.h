@@ -19,6 +19,8 @@
 
 #include <vector>
 #include <atomic>
+#include <map>
+#include <string>
 #include <unordered_map>
 
 namespace nvfeedback
@@ -39,6 +41,33 @@ namespace nvfeedback
         }
     };
 
+    enum class VolumeTileState : uint8_t
+    {
+        Unmapped,
+        Pending, // Returned by BeginFrame, its heap tile is allocated and mapped once its data is ready
+        Mapped
+    };
+
+    // Finest mip level requested in a feedback region within its timeout, and the last time it was requested
+    struct HeldRegionMip
+    {
+        uint8_t mip = 0xFF;
+        float requestTime = 0.0f;
+    };
+
+    // A tile of a volume texture, which is not tracked by the tiled texture manager
+    struct VolumeTile
+    {
+        uint32_t mip;    // Packed tiles have the first packed mip
+        uint32_t x;      // In tiles, or the index among the packed tiles
+        uint32_t y;
+        uint32_t z;
+        float requestTime = -1.0f;
+        VolumeTileState state = VolumeTileState::Unmapped;
+        uint32_t heapId = 0;
+        uint32_t heapTileIndex = 0;
+    };
+
     class FeedbackTextureImpl : public FeedbackTexture
     {
     public:
@@ -61,20 +90,115 @@ namespace nvfeedback
         nvrhi::TextureHandle GetMinMipTexture() override;
         bool IsTilePacked(uint32_t tileIndex) override;
         void GetTileInfo(uint32_t tileIndex, std::vector<FeedbackTextureTileInfo>& tiles) override;
+        bool IsVisible() override { return m_isVisible; }
         uint32_t GetNumTextureSets() const override;
         FeedbackTextureSet* GetTextureSet(uint32_t index) const override;
+        void SetTileDataProvider(std::shared_ptr<TileDataProvider> provider) override;
+        std::shared_ptr<TileDataProvider> GetTileDataProvider() const override { return m_tileDataProvider; }
+        bool IsVolume() const override { return m_isVolume; }
+        bool IsTileUniform(uint32_t tileIndex) override { return tileIndex < m_uniformTiles.size() && m_uniformTiles[tileIndex]; }
+        void SetResidentMipFloor(uint32_t mip) override;
+        uint32_t GetResidentMipFloor() const override { return m_residentMipFloor; }
 
         // Internal methods
         FeedbackTextureImpl(const nvrhi::TextureDesc& desc, FeedbackManagerImpl* pFeedbackManager, rtxts::TiledTextureManager* tiledTextureManager, nvrhi::IDevice* device, uint32_t numReadbacks);
         ~FeedbackTextureImpl();
 
+        // Resolve buffers are only held while the texture is read back, one per frame in flight
         nvrhi::BufferHandle GetFeedbackResolveBuffer(uint32_t frameIndex) { return m_feedbackResolveBuffers[frameIndex]; }
+        void SetFeedbackResolveBuffer(uint32_t frameIndex, nvrhi::BufferHandle buffer) { m_feedbackResolveBuffers[frameIndex] = buffer; }
+        nvrhi::BufferHandle TakeFeedbackResolveBuffer(uint32_t frameIndex) { return std::move(m_feedbackResolveBuffers[frameIndex]); }
+        uint64_t GetFeedbackResolveBufferSize() const { return m_feedbackResolveBufferSize; }
+
+        // Feedback resources are created on first use
+        bool HasSamplerFeedbackTexture() const { return m_feedbackTexture != nullptr; }
+        bool HasMinMipTexture() const { return m_minMipTexture != nullptr; }
 
         uint32_t GetNumTiles() { return m_numTiles; }
         const nvrhi::TileShape& GetTileShape() const { return m_tileShape; }
         const nvrhi::PackedMipDesc& GetPackedMipInfo() const { return m_packedMipDesc; }
 
-        uint32_t GetTiledTextureId() { return m_tiledTextureId; }
+        // Debug name given to CreateTexture, the reserved texture has a generic one
+        const std::string& GetResidencyKey() const { return m_residencyKey; }
+
+        // Every array slice is a tiled texture of its own in the tiled texture manager, with the same number of tiles
+        uint32_t GetNumSlices() const { return uint32_t(m_tiledTextureIds.size()); }
+        uint32_t GetTiledTextureId(uint32_t slice) const { return m_tiledTextureIds[slice]; }
+        uint32_t GetTileSlice(uint32_t tileIndex) const { return tileIndex / m_tilesPerSlice; }
+        uint32_t GetSliceTileIndex(uint32_t tileIndex) const { return tileIndex % m_tilesPerSlice; }
+        uint32_t GetTileIndex(uint32_t slice, uint32_t sliceTileIndex) const { return slice * m_tilesPerSlice + sliceTileIndex; }
+
+        // Location of a tile in the reserved texture, as used for tile mapping updates
+        nvrhi::TiledTextureCoordinate GetTiledTextureCoordinate(uint32_t tileIndex) const;
+
+        // Volume textures keep the residency of their tiles here, requests refresh the request time of the tiles covering a region
+        VolumeTile& GetVolumeTile(uint32_t tileIndex) { return m_volumeTiles[tileIndex]; }
+        void RequestVolumeRegion(const FeedbackTextureTileInfo& region, float timeStamp);
+
+        // Writes the finest mip with all tiles mapped down the mip chain, per tile of the first mip
+        void WriteVolumeMinMipData(std::vector<float>& minMipData) const;
+
+        void SetVisible(bool isVisible) { m_isVisible = isVisible; }
+
+        // Mip levels held per feedback region of every slice, sized on the first readback
+        std::vector<HeldRegionMip>& GetHeldRegionMips() { return m_heldRegionMips; }
+
+        // Feedback regions per slice, and the mips requested by the last two readbacks of sampler feedback
+        uint32_t GetFeedbackRegionsX() const override { return m_feedbackRegionsX; }
+        uint32_t GetFeedbackRegionsY() const override { return m_feedbackRegionsY; }
+        void SetFeedbackMips(const uint8_t* minMipData, size_t regionsNum);
+        const std::vector<uint8_t>& GetFeedbackMips() const { return m_feedbackMips; }
+        const std::vector<uint8_t>& GetPreviousFeedbackMips() const { return m_previousFeedbackMips; }
+
+        // Feedback regions of the first mip covered by a UV rectangle, [x0, x1) x [y0, y1), at least one region
+        void GetUvRectRegions(const FeedbackUvRect& uvRect, uint32_t& x0, uint32_t& y0, uint32_t& x1, uint32_t& y1) const;
+
+        // Texels of a volume texture mip covered by a UV rectangle, over the full depth
+        FeedbackTextureTileInfo GetUvRectVolumeRegion(uint32_t mip, const FeedbackUvRect& uvRect) const;
+
+        // Mips requested by prefetch hints per feedback region of every slice, empty without hints, and the nearest deadline
+        std::vector<uint8_t>& GetPrefetchMips() { return m_prefetchMips; }
+        float GetPrefetchDeadline() const { return m_prefetchDeadline; }
+        void SetPrefetchDeadline(float deadline) { m_prefetchDeadline = deadline; }
+
+        // Mips injected from the CPU since the last BeginFrame per feedback region of every slice, empty without any,
+        // for the main view and for the other views by view
+        std::vector<uint8_t>& GetInjectedMips() { return m_injectedMips; }
+        std::map<uint32_t, std::vector<uint8_t>>& GetInjectedViewMips() { return m_injectedViewMips; }
+
+        // Mips requested by the last readback merged with injected feedback, and the view with the finest request per
+        // region, empty if only the main view requested any
+        void SetRequestedMips(const std::vector<uint8_t>& requestedMips) { m_requestedMips = requestedMips; }
+        std::vector<uint8_t>& GetRegionViews() { return m_regionViews; }
+
+        // The view with the finest request among the feedback regions of a tile
+        uint32_t GetTileView(uint32_t tileIndex);
+
+        // Forgets the held mips and feedback history, which describe a view that is gone after a camera cut
+        void ResetFeedbackHistory();
+
+        // Returns true if the last readback or injected feedback requested the tile, tiles requested ahead of time return false
+        bool IsTileRequestedByFeedback(uint32_t tileIndex);
+
+        // The resident mip floor as requested mip of every feedback region, 0xFF if only the packed mips are resident
+        uint8_t GetResidentRegionMip() const { return m_residentMipFloor < m_packedMipDesc.numStandardMips ? uint8_t(m_residentMipFloor) : 0xFF; }
+
+        // Regular tiles of all slices at or coarser than the resident mip floor
+        uint32_t GetNumResidentFloorTiles() const;
+
+        // Mip level of a tile, packed tiles have the first packed mip
+        uint32_t GetTileMip(uint32_t tileIndex);
+
+        // Frame number a tile was last unmapped on, 0 if it never was
+        uint32_t GetTileUnmapFrame(uint32_t tileIndex) const { return m_tileUnmapFrames[tileIndex]; }
+        void SetTileUnmapFrame(uint32_t tileIndex, uint32_t frameNumber) { m_tileUnmapFrames[tileIndex] = frameNumber; }
+
+        // The block repeated over a uniform tile
+        const std::vector<uint8_t>& GetUniformTileBlock(uint32_t tileIndex) const { return m_uniformBlocks[m_uniformTileBlocks.at(tileIndex)]; }
+
+        // Uniform tiles currently mapped to a constant tile
+        bool IsTileMappedToConstant(uint32_t tileIndex) const { return m_constantMappedTiles[tileIndex]; }
+        void SetTileMappedToConstant(uint32_t tileIndex, bool mapped) { m_constantMappedTiles[tileIndex] = mapped; }
         
         // Methods for texture set management
         bool AddToTextureSet(FeedbackTextureSetImpl* textureSet);
@@ -93,17 +217,54 @@ namespace nvfeedback
         std::atomic<unsigned long> m_refCount;
 
         FeedbackManagerImpl* m_pFeedbackManager;
+        nvrhi::DeviceHandle m_device;
 
         nvrhi::TextureHandle m_reservedTexture;
         nvrhi::SamplerFeedbackTextureHandle m_feedbackTexture;
+        nvrhi::SamplerFeedbackTextureDesc m_feedbackTextureDesc;
         std::vector<nvrhi::BufferHandle> m_feedbackResolveBuffers;
+        uint64_t m_feedbackResolveBufferSize = 0;
         nvrhi::TextureHandle m_minMipTexture;
+        nvrhi::TextureDesc m_minMipTextureDesc;
 
         uint32_t m_numTiles = 0;
+        uint32_t m_tilesPerSlice = 0;
+        uint32_t m_regularTilesPerSlice = 0;
         nvrhi::PackedMipDesc m_packedMipDesc;
         nvrhi::TileShape m_tileShape;
 
-        uint32_t m_tiledTextureId = 0;
+        std::vector<uint32_t> m_tiledTextureIds;
+        std::string m_residencyKey;
+
+        bool m_isVolume = false;
+        std::vector<VolumeTile> m_volumeTiles;
+        std::vector<nvrhi::SubresourceTiling> m_volumeTilings; // Per regular mip, with the index of its first tile
+        bool m_isVisible = false;
+        std::vector<HeldRegionMip> m_heldRegionMips;
+        uint32_t m_feedbackRegionWidth = 1;
+        uint32_t m_feedbackRegionHeight = 1;
+        uint32_t m_feedbackRegionsX = 0;
+        uint32_t m_feedbackRegionsY = 0;
+        std::vector<uint8_t> m_feedbackMips;
+        std::vector<uint8_t> m_previousFeedbackMips;
+        uint32_t m_residentMipFloor = ~0u;
+        std::vector<uint8_t> m_prefetchMips;
+        float m_prefetchDeadline = 0.0f;
+        std::vector<uint8_t> m_injectedMips;
+        std::map<uint32_t, std::vector<uint8_t>> m_injectedViewMips;
+        std::vector<uint8_t> m_requestedMips;
+        std::vector<uint8_t> m_regionViews;
+        std::vector<uint32_t> m_regularTilesPerMip; // Per slice
+        std::vector<uint32_t> m_tileUnmapFrames;
+        std::vector<FeedbackTextureTileInfo> m_tileInfoScratch; // Reused by the per tile queries of BeginFrame
+
+        std::shared_ptr<TileDataProvider> m_tileDataProvider;
+
+        // Bitmap of the regular tiles repeating a single block, found when the provider is set, and the distinct blocks
+        std::vector<bool> m_uniformTiles;
+        std::vector<bool> m_constantMappedTiles;
+        std::unordered_map<uint32_t, uint32_t> m_uniformTileBlocks;
+        std::vector<std::vector<uint8_t>> m_uniformBlocks;
         
         // Members for texture set management
         std::vector<FeedbackTextureSetImpl*> m_textureSets;
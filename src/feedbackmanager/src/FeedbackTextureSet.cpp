@@ -59,7 +59,8 @@ namespace nvfeedback
     
     bool FeedbackTextureSetImpl::AddTexture(FeedbackTexture* texture)
     {
-        if (!texture)
+        // Volume textures have no sampler feedback to share
+        if (!texture || texture->IsVolume())
         {
             return false;
         }
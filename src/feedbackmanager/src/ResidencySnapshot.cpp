@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+
+#include "ResidencySnapshot.h"
+
+#include <string.h>
+
+namespace nvfeedback
+{
+    namespace
+    {
+        void Append(std::vector<uint8_t>& data, const void* source, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(source);
+            data.insert(data.end(), bytes, bytes + size);
+        }
+
+        bool Consume(const std::vector<uint8_t>& data, size_t& offset, void* dest, size_t size)
+        {
+            if (size > data.size() - offset)
+                return false;
+            memcpy(dest, data.data() + offset, size);
+            offset += size;
+            return true;
+        }
+    }
+
+    void WriteResidencySnapshot(const std::vector<ResidencySnapshotTexture>& textures, std::vector<uint8_t>& data)
+    {
+        data.clear();
+
+        ResidencySnapshotHeader header = {};
+        header.magic = ResidencySnapshotMagic;
+        header.version = ResidencySnapshotVersion;
+        header.numTextures = uint32_t(textures.size());
+        Append(data, &header, sizeof(header));
+
+        for (auto& texture : textures)
+        {
+            ResidencySnapshotEntry entry = {};
+            entry.keyLength = uint32_t(texture.key.size());
+            entry.numSlices = texture.numSlices;
+            entry.regionsX = texture.regionsX;
+            entry.regionsY = texture.regionsY;
+            Append(data, &entry, sizeof(entry));
+            Append(data, texture.key.data(), texture.key.size());
+            Append(data, texture.regionMips.data(), texture.regionMips.size());
+        }
+    }
+
+    bool ReadResidencySnapshot(const std::vector<uint8_t>& data, std::vector<ResidencySnapshotTexture>& textures)
+    {
+        textures.clear();
+
+        size_t offset = 0;
+        ResidencySnapshotHeader header;
+        if (!Consume(data, offset, &header, sizeof(header)) || header.magic != ResidencySnapshotMagic || header.version != ResidencySnapshotVersion)
+            return false;
+
+        for (uint32_t i = 0; i < header.numTextures; i++)
+        {
+            ResidencySnapshotEntry entry;
+            if (!Consume(data, offset, &entry, sizeof(entry)))
+                return false;
+
+            uint64_t regionsNum = uint64_t(entry.numSlices) * entry.regionsX * entry.regionsY;
+            if (entry.keyLength > data.size() - offset || regionsNum > data.size() - offset - entry.keyLength)
+                return false;
+
+            ResidencySnapshotTexture texture;
+            texture.key.assign(reinterpret_cast<const char*>(data.data() + offset), entry.keyLength);
+            offset += entry.keyLength;
+            texture.numSlices = entry.numSlices;
+            texture.regionsX = entry.regionsX;
+            texture.regionsY = entry.regionsY;
+            texture.regionMips.assign(data.begin() + offset, data.begin() + offset + size_t(regionsNum));
+            offset += size_t(regionsNum);
+            textures.push_back(std::move(texture));
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Residency snapshots store the mip mapped or requested per feedback region of textures, keyed by a name such as the
+// texture path, so a later session can request the same tiles ahead of time.
+//
+//   ResidencySnapshotHeader
+//   per texture:
+//     ResidencySnapshotEntry
+//     key                        keyLength bytes, not null terminated
+//     region mips                numSlices * regionsY * regionsX bytes, row major per slice, 0xFF if not requested
+//
+// All values are little endian.
+
+namespace nvfeedback
+{
+    constexpr uint32_t ResidencySnapshotMagic = 0x53525452; // "RTRS"
+    constexpr uint32_t ResidencySnapshotVersion = 1;
+
+    struct ResidencySnapshotHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t numTextures;
+        uint32_t reserved;
+    };
+
+    struct ResidencySnapshotEntry
+    {
+        uint32_t keyLength;
+        uint32_t numSlices;
+        uint32_t regionsX;
+        uint32_t regionsY;
+    };
+
+    static_assert(sizeof(ResidencySnapshotHeader) == 16, "Unexpected residency snapshot header size");
+    static_assert(sizeof(ResidencySnapshotEntry) == 16, "Unexpected residency snapshot entry size");
+
+    struct ResidencySnapshotTexture
+    {
+        std::string key;
+        uint32_t numSlices = 0;
+        uint32_t regionsX = 0;
+        uint32_t regionsY = 0;
+        std::vector<uint8_t> regionMips;
+    };
+
+    void WriteResidencySnapshot(const std::vector<ResidencySnapshotTexture>& textures, std::vector<uint8_t>& data);
+
+    // Fails on data of another format or version and on truncated data
+    bool ReadResidencySnapshot(const std::vector<uint8_t>& data, std::vector<ResidencySnapshotTexture>& textures);
+}
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "SharedTileTable.h"
+
+#include <algorithm>
+
+namespace nvfeedback
+{
+    size_t SharedTileTable::TileHash::operator()(const Tile& tile) const
+    {
+        uint64_t value = uint64_t(reinterpret_cast<uintptr_t>(tile.texture)) ^ (uint64_t(tile.tileIndex) * 0x9E3779B97F4A7C15ull);
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        return size_t(value);
+    }
+
+    void SharedTileTable::Add(const void* texture, uint32_t tileIndex, uint64_t contentHash)
+    {
+        Remove(texture, tileIndex);
+
+        Tile tile = { texture, tileIndex };
+        std::vector<Tile>& tiles = m_tilesByContent[contentHash];
+        if (!tiles.empty())
+            m_numDuplicateTiles++;
+        tiles.push_back(tile);
+        m_contentByTile[tile] = contentHash;
+    }
+
+    void SharedTileTable::Remove(const void* texture, uint32_t tileIndex)
+    {
+        Tile tile = { texture, tileIndex };
+        auto it = m_contentByTile.find(tile);
+        if (it == m_contentByTile.end())
+            return;
+
+        auto contentIt = m_tilesByContent.find(it->second);
+        std::vector<Tile>& tiles = contentIt->second;
+        tiles.erase(std::find(tiles.begin(), tiles.end(), tile));
+        if (tiles.empty())
+            m_tilesByContent.erase(contentIt);
+        else
+            m_numDuplicateTiles--;
+
+        m_contentByTile.erase(it);
+    }
+
+    void SharedTileTable::RemoveTexture(const void* texture)
+    {
+        std::vector<uint32_t> tileIndices;
+        for (auto& pair : m_contentByTile)
+        {
+            if (pair.first.texture == texture)
+                tileIndices.push_back(pair.first.tileIndex);
+        }
+
+        for (uint32_t tileIndex : tileIndices)
+            Remove(texture, tileIndex);
+    }
+
+    bool SharedTileTable::Find(uint64_t contentHash, const std::function<bool(const Tile&)>& accept, Tile& tile) const
+    {
+        auto it = m_tilesByContent.find(contentHash);
+        if (it == m_tilesByContent.end())
+            return false;
+
+        for (const Tile& candidate : it->second)
+        {
+            if (accept(candidate))
+            {
+                tile = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+}
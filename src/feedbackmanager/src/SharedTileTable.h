@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace nvfeedback
+{
+    // Resident tiles keyed by a hash of their content. Every content counts the resident tiles holding it, so it stays
+    // available for sharing until the last of them is unmapped.
+    class SharedTileTable
+    {
+    public:
+        struct Tile
+        {
+            const void* texture;
+            uint32_t tileIndex;
+
+            bool operator==(const Tile& b) const { return texture == b.texture && tileIndex == b.tileIndex; }
+        };
+
+        // Registers a resident tile, replacing its previous content if it was registered already
+        void Add(const void* texture, uint32_t tileIndex, uint64_t contentHash);
+
+        // Unregisters a tile which is unmapped or about to receive new data
+        void Remove(const void* texture, uint32_t tileIndex);
+
+        void RemoveTexture(const void* texture);
+
+        // Returns the first resident tile with the content which is accepted by the callback
+        bool Find(uint64_t contentHash, const std::function<bool(const Tile&)>& accept, Tile& tile) const;
+
+        // Number of resident tiles whose content is also held by another resident tile
+        uint32_t GetNumDuplicateTiles() const { return m_numDuplicateTiles; }
+
+    private:
+        struct TileHash
+        {
+            size_t operator()(const Tile& tile) const;
+        };
+
+        std::unordered_map<uint64_t, std::vector<Tile>> m_tilesByContent;
+        std::unordered_map<Tile, uint64_t, TileHash> m_contentByTile;
+        uint32_t m_numDuplicateTiles = 0;
+    };
+}
@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "SmallTexturePool.h"
+
+#include <algorithm>
+
+namespace nvfeedback
+{
+    SmallTexturePool::SmallTexturePool(nvrhi::IDevice* device, uint64_t pageSizeInBytes, uint32_t framesInFlight) :
+        m_device(device),
+        m_pageSizeInBytes(pageSizeInBytes),
+        m_framesInFlight(framesInFlight)
+    {
+    }
+
+    nvrhi::TextureHandle SmallTexturePool::CreateTexture(const nvrhi::TextureDesc& desc)
+    {
+        nvrhi::TextureDesc textureDesc = desc;
+        textureDesc.isVirtual = true;
+        nvrhi::TextureHandle texture = m_device->createTexture(textureDesc);
+        if (!texture)
+            return nullptr;
+
+        nvrhi::MemoryRequirements memoryRequirements = m_device->getTextureMemoryRequirements(texture);
+        uint64_t alignment = std::max(memoryRequirements.alignment, uint64_t(1));
+        if (memoryRequirements.size > m_pageSizeInBytes)
+            return nullptr;
+
+        // First page with a free range large enough, pages are filled front to back
+        Placement placement;
+        placement.range.size = memoryRequirements.size;
+        auto it = m_pages.begin();
+        while (it != m_pages.end() && !Allocate(it->second, memoryRequirements.size, alignment, placement.range.offset))
+            ++it;
+
+        if (it == m_pages.end())
+        {
+            nvrhi::HeapDesc heapDesc = {};
+            heapDesc.capacity = m_pageSizeInBytes;
+            heapDesc.type = nvrhi::HeapType::DeviceLocal;
+            heapDesc.debugName = "Small texture page";
+            nvrhi::HeapHandle heap = m_device->createHeap(heapDesc);
+            if (!heap)
+                return nullptr;
+
+            Page page;
+            page.heap = heap;
+            page.freeRanges.push_back({ 0, m_pageSizeInBytes });
+            it = m_pages.emplace(m_nextPageId++, std::move(page)).first;
+            Allocate(it->second, memoryRequirements.size, alignment, placement.range.offset);
+        }
+
+        placement.pageId = it->first;
+        if (!m_device->bindTextureMemory(texture, it->second.heap, placement.range.offset))
+        {
+            Free(placement);
+            return nullptr;
+        }
+
+        it->second.numTextures++;
+        placement.texture = texture;
+        m_textures.push_back(placement);
+        return texture;
+    }
+
+    void SmallTexturePool::Update(uint32_t frameNumber)
+    {
+        // Textures the application no longer references wait for the frames in flight before their memory is reused
+        for (size_t i = 0; i < m_textures.size();)
+        {
+            nvrhi::ITexture* texture = m_textures[i].texture;
+            texture->AddRef();
+            if (texture->Release() == 1)
+            {
+                m_textures[i].releaseFrame = frameNumber;
+                m_releasedTextures.push_back(std::move(m_textures[i]));
+                m_textures[i] = std::move(m_textures.back());
+                m_textures.pop_back();
+            }
+            else
+                i++;
+        }
+
+        for (size_t i = 0; i < m_releasedTextures.size();)
+        {
+            if (frameNumber - m_releasedTextures[i].releaseFrame >= m_framesInFlight)
+            {
+                m_releasedTextures[i].texture = nullptr;
+                Free(m_releasedTextures[i]);
+                m_pages[m_releasedTextures[i].pageId].numTextures--;
+                m_releasedTextures[i] = std::move(m_releasedTextures.back());
+                m_releasedTextures.pop_back();
+            }
+            else
+                i++;
+        }
+
+        for (auto it = m_pages.begin(); it != m_pages.end();)
+        {
+            if (it->second.numTextures == 0)
+                it = m_pages.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    bool SmallTexturePool::Allocate(Page& page, uint64_t size, uint64_t alignment, uint64_t& offset)
+    {
+        for (size_t i = 0; i < page.freeRanges.size(); i++)
+        {
+            Range range = page.freeRanges[i];
+            uint64_t alignedOffset = (range.offset + alignment - 1) / alignment * alignment;
+            if (alignedOffset + size > range.offset + range.size)
+                continue;
+
+            // Keep what is left on either side of the placement
+            page.freeRanges.erase(page.freeRanges.begin() + i);
+            uint64_t end = alignedOffset + size;
+            if (end < range.offset + range.size)
+                page.freeRanges.insert(page.freeRanges.begin() + i, { end, range.offset + range.size - end });
+            if (alignedOffset > range.offset)
+                page.freeRanges.insert(page.freeRanges.begin() + i, { range.offset, alignedOffset - range.offset });
+            offset = alignedOffset;
+            return true;
+        }
+        return false;
+    }
+
+    void SmallTexturePool::Free(const Placement& placement)
+    {
+        std::vector<Range>& freeRanges = m_pages[placement.pageId].freeRanges;
+        auto it = std::lower_bound(freeRanges.begin(), freeRanges.end(), placement.range.offset, [](const Range& range, uint64_t offset)
+            {
+                return range.offset < offset;
+            });
+        it = freeRanges.insert(it, placement.range);
+
+        // Merge with the following and the preceding free ranges
+        auto next = it + 1;
+        if (next != freeRanges.end() && it->offset + it->size == next->offset)
+        {
+            it->size += next->size;
+            freeRanges.erase(next);
+        }
+        if (it != freeRanges.begin())
+        {
+            auto previous = it - 1;
+            if (previous->offset + previous->size == it->offset)
+            {
+                previous->size += it->size;
+                freeRanges.erase(it);
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+#include <nvrhi/nvrhi.h>
+
+namespace nvfeedback
+{
+    // Fully resident textures placed one after another in shared heap pages. Textures whose whole mip chain fits in a
+    // tile gain nothing from streaming, and this spares them a reserved resource, a packed mip tile and feedback resources.
+    // The memory of a texture is reused once the pool holds its last reference, and pages left empty are released.
+    class SmallTexturePool
+    {
+    public:
+        SmallTexturePool(nvrhi::IDevice* device, uint64_t pageSizeInBytes, uint32_t framesInFlight);
+
+        // Returns nullptr if the texture doesn't fit in a page
+        nvrhi::TextureHandle CreateTexture(const nvrhi::TextureDesc& desc);
+
+        // Call once per frame. Textures released by the application are freed after the frames in flight which may
+        // still sample them.
+        void Update(uint32_t frameNumber);
+
+        uint32_t GetNumTextures() const { return uint32_t(m_textures.size()); }
+        uint64_t GetAllocatedBytes() const { return uint64_t(m_pages.size()) * m_pageSizeInBytes; }
+
+    private:
+        struct Range
+        {
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        struct Page
+        {
+            nvrhi::HeapHandle heap;
+            std::vector<Range> freeRanges; // Ordered by offset, adjacent ranges are merged
+            uint32_t numTextures = 0;
+        };
+
+        struct Placement
+        {
+            nvrhi::TextureHandle texture;
+            uint32_t pageId;
+            Range range;
+            uint32_t releaseFrame = 0;
+        };
+
+        bool Allocate(Page& page, uint64_t size, uint64_t alignment, uint64_t& offset);
+        void Free(const Placement& placement);
+
+        nvrhi::DeviceHandle m_device;
+        uint64_t m_pageSizeInBytes;
+        uint32_t m_framesInFlight;
+        uint32_t m_nextPageId = 0;
+        std::map<uint32_t, Page> m_pages; // By page id
+        std::vector<Placement> m_textures;
+        std::vector<Placement> m_releasedTextures;
+    };
+}
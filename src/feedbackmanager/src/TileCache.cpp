@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "TileCache.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string.h>
+
+namespace nvfeedback
+{
+    namespace
+    {
+        // Least recently used tiles considered for eviction
+        constexpr uint32_t EvictionCandidates = 8;
+
+        // Relative cost of reading a tile again, by TileRefetchCost
+        constexpr float RefetchWeights[] = { 1.0f, 4.0f, 6.0f, 12.0f };
+    }
+
+    size_t TileCache::KeyHash::operator()(const Key& key) const
+    {
+        // Mix the texture pointer and the tile index so neighbouring tiles land in different shards
+        uint64_t value = uint64_t(reinterpret_cast<uintptr_t>(key.texture)) ^ (uint64_t(key.tileIndex) * 0x9E3779B97F4A7C15ull);
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        return size_t(value);
+    }
+
+    TileCache::TileCache(uint64_t capacityInBytes, uint32_t numShards)
+    {
+        numShards = std::max(numShards, 1u);
+        m_shardCapacityInBytes = capacityInBytes / numShards;
+        for (uint32_t i = 0; i < numShards; i++)
+            m_shards.push_back(std::make_unique<Shard>());
+    }
+
+    float TileCache::GetRetentionScore(const Entry& entry, uint64_t clock)
+    {
+        // Coarse mips cover more of the screen and are requested again sooner
+        float age = float(clock - entry.lastUse);
+        return RefetchWeights[uint32_t(entry.cost)] * float(entry.mip + 1) / (age + 1.0f);
+    }
+
+    bool TileCache::Lookup(const void* texture, uint32_t tileIndex, uint32_t mip)
+    {
+        Key key = { texture, tileIndex };
+        Shard& shard = GetShard(key);
+        uint32_t statsMip = std::min(mip, StatsMipLevels - 1);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        bool found = shard.lookup.find(key) != shard.lookup.end();
+        if (found)
+        {
+            shard.hits++;
+            shard.hitsByMip[statsMip]++;
+        }
+        else
+        {
+            shard.misses++;
+            shard.missesByMip[statsMip]++;
+        }
+        return found;
+    }
+
+    bool TileCache::Read(const void* texture, uint32_t tileIndex, void* dest, size_t size)
+    {
+        Key key = { texture, tileIndex };
+        Shard& shard = GetShard(key);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lookup.find(key);
+        if (it == shard.lookup.end() || it->second->data.size() != size)
+            return false;
+
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        it->second->lastUse = ++shard.clock;
+        memcpy(dest, it->second->data.data(), size);
+        return true;
+    }
+
+    void TileCache::Write(const void* texture, uint32_t tileIndex, uint32_t mip, TileRefetchCost cost, std::vector<uint8_t>&& data)
+    {
+        if (data.size() > m_shardCapacityInBytes)
+            return;
+
+        Key key = { texture, tileIndex };
+        Shard& shard = GetShard(key);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lookup.find(key);
+        if (it != shard.lookup.end())
+        {
+            shard.sizeInBytes -= it->second->data.size();
+            shard.entries.erase(it->second);
+            shard.lookup.erase(it);
+        }
+
+        while (!shard.entries.empty() && shard.sizeInBytes + data.size() > m_shardCapacityInBytes)
+        {
+            // Of the least recently used tiles, evict the one with the lowest score
+            auto evicted = std::prev(shard.entries.end());
+            float evictedScore = GetRetentionScore(*evicted, shard.clock);
+            auto candidate = evicted;
+            for (uint32_t i = 1; i < EvictionCandidates && candidate != shard.entries.begin(); i++)
+            {
+                --candidate;
+                float score = GetRetentionScore(*candidate, shard.clock);
+                if (score < evictedScore)
+                {
+                    evicted = candidate;
+                    evictedScore = score;
+                }
+            }
+
+            shard.sizeInBytes -= evicted->data.size();
+            shard.lookup.erase(evicted->key);
+            shard.entries.erase(evicted);
+            shard.evictions++;
+        }
+
+        shard.sizeInBytes += data.size();
+        shard.entries.push_front({ key, std::move(data), mip, cost, ++shard.clock });
+        shard.lookup[key] = shard.entries.begin();
+    }
+
+    void TileCache::Touch(const void* texture, uint32_t tileIndex)
+    {
+        Key key = { texture, tileIndex };
+        Shard& shard = GetShard(key);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lookup.find(key);
+        if (it != shard.lookup.end())
+        {
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            it->second->lastUse = ++shard.clock;
+        }
+    }
+
+    void TileCache::RemoveTexture(const void* texture)
+    {
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            for (auto it = shard->entries.begin(); it != shard->entries.end();)
+            {
+                if (it->key.texture == texture)
+                {
+                    shard->sizeInBytes -= it->data.size();
+                    shard->lookup.erase(it->key);
+                    it = shard->entries.erase(it);
+                }
+                else
+                    ++it;
+            }
+        }
+    }
+
+    TileCacheStats TileCache::GetStats() const
+    {
+        TileCacheStats stats;
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            stats.sizeInBytes += shard->sizeInBytes;
+            stats.numTiles += uint32_t(shard->entries.size());
+            stats.hits += shard->hits;
+            stats.misses += shard->misses;
+            stats.evictions += shard->evictions;
+            for (uint32_t mip = 0; mip < StatsMipLevels; mip++)
+            {
+                stats.hitsByMip[mip] += shard->hitsByMip[mip];
+                stats.missesByMip[mip] += shard->missesByMip[mip];
+            }
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../include/FeedbackManager.h"
+
+namespace nvfeedback
+{
+    struct TileCacheStats
+    {
+        uint64_t sizeInBytes = 0;
+        uint32_t numTiles = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t hitsByMip[StatsMipLevels] = {};
+        uint64_t missesByMip[StatsMipLevels] = {};
+    };
+
+    // System memory cache of tile data keyed by texture and tile index. Among the least recently used tiles the one
+    // cheapest to bring back is evicted first, scored by its refetch cost, its mip level and the time since its last use.
+    // Tiles are spread over shards with their own lock, so I/O threads filling the cache rarely contend.
+    class TileCache
+    {
+    public:
+        TileCache(uint64_t capacityInBytes, uint32_t numShards);
+
+        bool IsEnabled() const { return m_shardCapacityInBytes > 0; }
+
+        // Returns true if the tile is cached and counts a hit or a miss
+        bool Lookup(const void* texture, uint32_t tileIndex, uint32_t mip);
+
+        // Copies a cached tile of the given size to dest and marks it as recently used
+        bool Read(const void* texture, uint32_t tileIndex, void* dest, size_t size);
+
+        // Adds or replaces a tile, evicting tiles of its shard when over capacity
+        void Write(const void* texture, uint32_t tileIndex, uint32_t mip, TileRefetchCost cost, std::vector<uint8_t>&& data);
+
+        // Marks a tile as recently used if it is cached
+        void Touch(const void* texture, uint32_t tileIndex);
+
+        void RemoveTexture(const void* texture);
+
+        TileCacheStats GetStats() const;
+
+    private:
+        struct Key
+        {
+            const void* texture;
+            uint32_t tileIndex;
+
+            bool operator==(const Key& b) const { return texture == b.texture && tileIndex == b.tileIndex; }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const;
+        };
+
+        struct Entry
+        {
+            Key key;
+            std::vector<uint8_t> data;
+            uint32_t mip;
+            TileRefetchCost cost;
+            uint64_t lastUse;
+        };
+
+        // Entries are ordered from the most to the least recently used, the clock counts uses of the shard's tiles
+        struct Shard
+        {
+            mutable std::mutex mutex;
+            std::list<Entry> entries;
+            std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+            uint64_t sizeInBytes = 0;
+            uint64_t clock = 0;
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            uint64_t hitsByMip[StatsMipLevels] = {};
+            uint64_t missesByMip[StatsMipLevels] = {};
+        };
+
+        static float GetRetentionScore(const Entry& entry, uint64_t clock);
+
+        Shard& GetShard(const Key& key) { return *m_shards[KeyHash()(key) % m_shards.size()]; }
+
+        uint64_t m_shardCapacityInBytes;
+        std::vector<std::unique_ptr<Shard>> m_shards;
+    };
+}
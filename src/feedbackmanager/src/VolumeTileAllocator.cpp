@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "VolumeTileAllocator.h"
+#include "FeedbackManagerInternal.h"
+
+namespace nvfeedback
+{
+    VolumeTileAllocator::VolumeTileAllocator(HeapAllocator* heapAllocator, uint32_t heapSizeInTiles) :
+        m_heapAllocator(heapAllocator),
+        m_heapSizeInTiles(heapSizeInTiles)
+    {
+    }
+
+    void VolumeTileAllocator::Allocate(uint32_t& heapId, uint32_t& heapTileIndex)
+    {
+        auto it = std::find_if(m_freeTiles.begin(), m_freeTiles.end(), [](const auto& pair) { return !pair.second.empty(); });
+        if (it == m_freeTiles.end())
+        {
+            uint32_t newHeapId;
+            m_heapAllocator->AllocateHeap(newHeapId);
+
+            // Hand out the tiles of a new heap from its start
+            std::vector<uint32_t> freeTiles(m_heapSizeInTiles);
+            for (uint32_t i = 0; i < m_heapSizeInTiles; i++)
+                freeTiles[i] = m_heapSizeInTiles - 1 - i;
+            it = m_freeTiles.emplace(newHeapId, std::move(freeTiles)).first;
+        }
+
+        heapId = it->first;
+        heapTileIndex = it->second.back();
+        it->second.pop_back();
+        m_numAllocatedTiles++;
+    }
+
+    void VolumeTileAllocator::Free(uint32_t heapId, uint32_t heapTileIndex)
+    {
+        m_freeTiles[heapId].push_back(heapTileIndex);
+        m_numAllocatedTiles--;
+    }
+
+    void VolumeTileAllocator::ReleaseEmptyHeaps(uint32_t frameIndex)
+    {
+        for (auto it = m_freeTiles.begin(); it != m_freeTiles.end();)
+        {
+            if (it->second.size() == m_heapSizeInTiles)
+            {
+                m_heapAllocator->ReleaseHeap(it->first, frameIndex);
+                it = m_freeTiles.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+}
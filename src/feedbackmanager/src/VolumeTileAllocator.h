@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+namespace nvfeedback
+{
+    class HeapAllocator;
+
+    // Heap tiles for the tiles of volume textures, which the tiled texture manager can't track. Heaps are taken from the
+    // same heap allocator as the tiled texture manager's and given back once all their tiles are free.
+    class VolumeTileAllocator
+    {
+    public:
+        VolumeTileAllocator(HeapAllocator* heapAllocator, uint32_t heapSizeInTiles);
+
+        void Allocate(uint32_t& heapId, uint32_t& heapTileIndex);
+        void Free(uint32_t heapId, uint32_t heapTileIndex);
+
+        // Returns heaps without allocated tiles to the heap allocator
+        void ReleaseEmptyHeaps(uint32_t frameIndex);
+
+        uint32_t GetNumHeaps() const { return uint32_t(m_freeTiles.size()); }
+        uint32_t GetNumAllocatedTiles() const { return m_numAllocatedTiles; }
+
+    private:
+        HeapAllocator* m_heapAllocator;
+        uint32_t m_heapSizeInTiles;
+        uint32_t m_numAllocatedTiles = 0;
+
+        // Free tiles of every heap, by heap id
+        std::map<uint32_t, std::vector<uint32_t>> m_freeTiles;
+    };
+}
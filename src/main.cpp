@@ -59,6 +59,7 @@ using namespace donut::render;
 
 #include <string>
 #include <vector>
+#include <map>
 #include <memory>
 #include <chrono>
 
@@ -66,6 +67,8 @@ using namespace donut::render;
 #include "TextureCacheFeedback.h"
 #include "../shaders/feedback_cb.h"
 #include "Profiler.h"
+#include "TileDataSource.h"
+#include "TileStreamer.h"
 #include "feedbackmanager/include/feedbackmanager.h"
 #include "rtxts-ttm/tiledTextureManager.h"
 
@@ -348,88 +351,134 @@ struct UIData
     int                                 tilesPerFrame = 256;
     float                               tileTimeout = 1.0f;
     int                                 numExtraStandbyTiles = 2000;
+    int                                 mipHysteresisLevels = 1;
+    bool                                predictTiles = true;
+    int                                 prefetchTilesPerFrame = 32;
+    float                               prefetchDeadlineSeconds = 1.0f;
+    float                               residencySnapshotDeadlineSeconds = 0.5f;
+    tilestream::BcQuality               transcodeQuality = tilestream::BcQuality::Normal;
 };
 
+static_assert(TileStreamer::UploadSlotSizeInBytes == D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES, "Upload slots hold one tile");
+
 // Helper class for uploading tiles to the GPU
+// Tiles are read straight into slots of a persistently mapped upload buffer. A slot stays allocated while its data is
+// being read and until the GPU has executed the copy out of it.
 class TileUploadHelper
 {
 public:
-    TileUploadHelper(nvrhi::IDevice* device, uint32_t maxTiles, uint32_t framesInFlight)
+    static constexpr uint32_t InvalidSlot = ~0u;
+
+    TileUploadHelper(nvrhi::IDevice* device, uint32_t numSlots, uint32_t framesInFlight)
         : m_device(device)
-        , m_maxTiles(maxTiles)
     {
         m_framesInFlight = framesInFlight;
-        m_tileCount.resize(m_framesInFlight, 0);
-        m_uploadBuffers.resize(m_framesInFlight);
+        m_uploadedSlots.resize(m_framesInFlight);
+        m_stagingBuffers.resize(m_framesInFlight);
 
-        for (uint32_t i = 0; i < m_framesInFlight; ++i)
-        {
-            nvrhi::BufferDesc bufferDesc = {};
-            bufferDesc.byteSize = maxTiles * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
-            bufferDesc.debugName = "TileDataUploadBuffer";
-            bufferDesc.keepInitialState = true;
-            bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Write;
+        nvrhi::BufferDesc bufferDesc = {};
+        bufferDesc.byteSize = uint64_t(numSlots) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        bufferDesc.debugName = "TileDataUploadBuffer";
+        bufferDesc.keepInitialState = true;
+        bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Write;
 
-            m_uploadBuffers[i] = device->createBuffer(bufferDesc);
-        }
+        m_uploadBuffer = device->createBuffer(bufferDesc);
+        m_mappedData = (uint8_t*)m_device->mapBuffer(m_uploadBuffer, nvrhi::CpuAccessMode::Write);
+
+        m_freeSlots.reserve(numSlots);
+        for (uint32_t slot = numSlots; slot > 0; --slot)
+            m_freeSlots.push_back(slot - 1);
+    }
+
+    ~TileUploadHelper()
+    {
+        m_device->unmapBuffer(m_uploadBuffer);
     }
 
     void BeginFrame(uint32_t frameIndex)
     {
         m_frameIndex = frameIndex % m_framesInFlight;
-        m_tileCount[m_frameIndex] = 0;
+
+        // The copies recorded the last time this frame index was used have been executed
+        auto& uploadedSlots = m_uploadedSlots[m_frameIndex];
+        m_freeSlots.insert(m_freeSlots.end(), uploadedSlots.begin(), uploadedSlots.end());
+        uploadedSlots.clear();
+        m_stagingBuffers[m_frameIndex].clear();
     }
 
-    uint32_t NumTilesMax() const
+    uint32_t NumFreeSlots() const
     {
-        return m_maxTiles;
+        return (uint32_t)m_freeSlots.size();
     }
 
-    bool UploadTile(ID3D12GraphicsCommandList* commandList, ID3D12Resource* destTexture, nvfeedback::FeedbackTextureTileInfo tile, const char* dataMipBase, nvrhi::TileShape tileShape, uint32_t rowPitchSource)
+    uint32_t AllocateSlot()
     {
-        uint32_t& tileCount = m_tileCount[m_frameIndex];
-        if (tileCount >= m_maxTiles)
-            return false;
+        if (m_freeSlots.empty())
+            return InvalidSlot;
 
-        uint32_t bufferOffset = tileCount * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
-        ++tileCount;
+        uint32_t slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
 
-        uint8_t* mappedData = (uint8_t*)m_device->mapBuffer(m_uploadBuffers[m_frameIndex], nvrhi::CpuAccessMode::Write);
-        mappedData += bufferOffset;
+    uint8_t* GetSlotData(uint32_t slot)
+    {
+        return m_mappedData + uint64_t(slot) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    }
 
-        // Compute pitches and offsets in 4x4 blocks
-        // Note: The "tile" being copied here might be smaller than a tiled resource tile, for example non-pow2 textures
-        uint32_t tileBlocksWidth = tile.widthInTexels / 4;
-        uint32_t tileBlocksHeight = tile.heightInTexels / 4;
-        uint32_t shapeBlocksWidth = tileShape.widthInTexels / 4;
-        uint32_t shapeBlocksHeight = tileShape.heightInTexels / 4;
-        uint32_t bytesPerBlock = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES / (shapeBlocksWidth * shapeBlocksHeight);
-        uint32_t sourceBlockX = tile.xInTexels / 4;
-        uint32_t sourceBlockY = tile.yInTexels / 4;
-        uint32_t rowPitchTile = tileBlocksWidth * bytesPerBlock;
-        for (uint32_t blockRow = 0; blockRow < tileBlocksHeight; blockRow++)
-        {
-            uint32_t readOffset = (sourceBlockY + blockRow) * rowPitchSource + sourceBlockX * bytesPerBlock;
-            uint32_t writeOffset = blockRow * rowPitchTile;
-            memcpy(mappedData + writeOffset, dataMipBase + readOffset, rowPitchTile);
-        }
+    // Returns a slot which hasn't been used for an upload
+    void FreeSlot(uint32_t slot)
+    {
+        m_freeSlots.push_back(slot);
+    }
 
-        m_device->unmapBuffer(m_uploadBuffers[m_frameIndex]);
+    // Copies a tile from a slot into the texture, the slot is freed once the GPU is done with it
+    void UploadTile(ID3D12GraphicsCommandList* commandList, ID3D12Resource* destTexture, nvfeedback::FeedbackTextureTileInfo tile, uint32_t slot, uint32_t rowPitchTile)
+    {
+        ID3D12Resource* srcResource = m_uploadBuffer->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource);
+        CopyTile(commandList, srcResource, uint64_t(slot) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES, destTexture, tile, rowPitchTile);
+        m_uploadedSlots[m_frameIndex].push_back(slot);
+    }
+
+    // Copies a tile read into system memory into the texture through a staging buffer kept until the GPU is done with it.
+    // Its slot is unused and freed along with it.
+    void UploadStagedTile(ID3D12GraphicsCommandList* commandList, ID3D12Resource* destTexture, nvfeedback::FeedbackTextureTileInfo tile, uint32_t slot,
+        const std::vector<uint8_t>& data, uint32_t rowPitchTile)
+    {
+        nvrhi::BufferDesc bufferDesc = {};
+        bufferDesc.byteSize = data.size();
+        bufferDesc.debugName = "TileDataStagingBuffer";
+        bufferDesc.keepInitialState = true;
+        bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Write;
+        nvrhi::BufferHandle stagingBuffer = m_device->createBuffer(bufferDesc);
+        void* mappedData = m_device->mapBuffer(stagingBuffer, nvrhi::CpuAccessMode::Write);
+        memcpy(mappedData, data.data(), data.size());
+        m_device->unmapBuffer(stagingBuffer);
+
+        CopyTile(commandList, stagingBuffer->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource), 0, destTexture, tile, rowPitchTile);
+        m_stagingBuffers[m_frameIndex].push_back(stagingBuffer);
+        m_uploadedSlots[m_frameIndex].push_back(slot);
+    }
 
+private:
+    void CopyTile(ID3D12GraphicsCommandList* commandList, ID3D12Resource* srcResource, uint64_t srcOffset, ID3D12Resource* destTexture,
+        const nvfeedback::FeedbackTextureTileInfo& tile, uint32_t rowPitchTile)
+    {
+        // Note: The "tile" being copied here might be smaller than a tiled resource tile, for example non-pow2 textures
         D3D12_TEXTURE_COPY_LOCATION srcLocation = {};
-        srcLocation.pResource = m_uploadBuffers[m_frameIndex]->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource);
+        srcLocation.pResource = srcResource;
         srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-        srcLocation.PlacedFootprint.Offset = bufferOffset;
+        srcLocation.PlacedFootprint.Offset = srcOffset;
         srcLocation.PlacedFootprint.Footprint.Format = destTexture->GetDesc().Format;
         srcLocation.PlacedFootprint.Footprint.Width = tile.widthInTexels;
         srcLocation.PlacedFootprint.Footprint.Height = tile.heightInTexels;
-        srcLocation.PlacedFootprint.Footprint.Depth = 1;
+        srcLocation.PlacedFootprint.Footprint.Depth = tile.depthInTexels;
         srcLocation.PlacedFootprint.Footprint.RowPitch = rowPitchTile;
 
         D3D12_TEXTURE_COPY_LOCATION dstLocation = {};
         dstLocation.pResource = destTexture;
         dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-        dstLocation.SubresourceIndex = tile.mip;
+        dstLocation.SubresourceIndex = tile.mip + tile.arraySlice * destTexture->GetDesc().MipLevels;
 
         D3D12_BOX sourceBox = {};
         sourceBox.left = 0;
@@ -437,21 +486,20 @@ public:
         sourceBox.front = 0;
         sourceBox.right = tile.widthInTexels;
         sourceBox.bottom = tile.heightInTexels;
-        sourceBox.back = 1;
-
-        commandList->CopyTextureRegion(&dstLocation, tile.xInTexels, tile.yInTexels, 0, &srcLocation, &sourceBox);
+        sourceBox.back = tile.depthInTexels;
 
-        return true;
+        commandList->CopyTextureRegion(&dstLocation, tile.xInTexels, tile.yInTexels, tile.zInTexels, &srcLocation, &sourceBox);
     }
 
-private:
     nvrhi::IDevice* m_device;
-    uint32_t m_maxTiles;
 
-    std::vector<nvrhi::BufferHandle> m_uploadBuffers;
-    std::vector<uint32_t> m_tileCount;
+    nvrhi::BufferHandle m_uploadBuffer;
+    uint8_t* m_mappedData = nullptr;
+    std::vector<uint32_t> m_freeSlots;
+    std::vector<std::vector<uint32_t>> m_uploadedSlots;
+    std::vector<std::vector<nvrhi::BufferHandle>> m_stagingBuffers;
     uint32_t m_framesInFlight = 0;
-    uint32_t m_frameIndex = -1;
+    uint32_t m_frameIndex = 0;
 };
 
 struct RequestedTile
@@ -460,6 +508,14 @@ struct RequestedTile
     uint32_t tileIndex;
 };
 
+// All packed tiles of a texture are scheduled together since they are filled by the same mip uploads
+struct RequestedPackedMips
+{
+    nvfeedback::FeedbackTexture* texture;
+    std::vector<uint32_t> tileIndices;
+    uint64_t sizeInBytes;
+};
+
 // Main application class
 class SampleApp : public ApplicationBase
 {
@@ -516,15 +572,22 @@ public:
     bool m_recreateFeedbackTextureSets = true;
     bool m_textureSetsEnabled = false;
     bool m_cameraCut = false;
+    bool m_loadResidencySnapshot = false;
     std::shared_ptr<FeedbackManager> m_feedbackManager;
     FeedbackTextureMaps m_feedbackTextureMaps;
     std::queue<RequestedTile> m_requestedTiles;
+    std::queue<RequestedTile> m_prefetchTiles;
+    std::deque<RequestedPackedMips> m_requestedPackedMips;
+    std::map<std::pair<FeedbackTexture*, uint32_t>, uint32_t> m_tileReadRetries; // By texture and first tile of the read
     TileUploadHelper m_tileUploadHelper;
+    TileStreamer m_tileStreamer;
+    std::filesystem::path m_mediaPath;
 
     // Simple perf counters
     SimplePerf m_perfFeedbackBegin;
     SimplePerf m_perfFeedbackUpdateTileMappings;
     SimplePerf m_perfFeedbackResolve;
+    SimplePerf m_perfTileDecode;
 
     // GPU timing
     AveragingTimerQuery m_timerGbuffer;
@@ -536,13 +599,15 @@ public:
         : Super(deviceManager)
         , m_ui(ui)
         , m_bindingCache(deviceManager->GetDevice())
-        , m_tileUploadHelper(deviceManager->GetDevice(), m_ui.tilesPerFrame, deviceManager->GetBackBufferCount())
+        , m_tileUploadHelper(deviceManager->GetDevice(), m_ui.tilesPerFrame * (deviceManager->GetBackBufferCount() + 2), deviceManager->GetBackBufferCount())
+        , m_tileStreamer(tilestream::IoSchedulerDesc())
         , m_timerGbuffer(deviceManager->GetDevice())
         , m_timerResolve(deviceManager->GetDevice())
     { 
         std::shared_ptr<NativeFileSystem> nativeFS = std::make_shared<NativeFileSystem>();
 
         std::filesystem::path mediaPath = app::GetDirectoryWithExecutable().parent_path() / "media";
+        m_mediaPath = mediaPath;
         std::filesystem::path frameworkShaderPath = app::GetDirectoryWithExecutable() / "shaders/framework" / app::GetShaderTypeName(GetDevice()->getGraphicsAPI());
         std::filesystem::path appShaderPath = app::GetDirectoryWithExecutable() / "shaders/app" / app::GetShaderTypeName(GetDevice()->getGraphicsAPI());
 
@@ -719,6 +784,8 @@ public:
         GetDevice()->waitForIdle();
         GetDevice()->runGarbageCollection();
 
+        SaveResidencySnapshot();
+
         m_shaderFactory->ClearCache();
         m_bindingCache.Clear();
 
@@ -729,6 +796,8 @@ public:
         if (m_depthPass) m_depthPass->ResetBindingCache();
         if (m_shadowDepthPass) m_shadowDepthPass->ResetBindingCache();
 
+        FlushTileStreamer();
+
         m_sunLight.reset();
         m_ui.selectedMaterial = nullptr;
         m_ui.selectedNode = nullptr;
@@ -738,7 +807,11 @@ public:
         m_feedbackTextureMaps.m_feedbackTexturesBySource.clear();
         m_feedbackTextureMaps.m_materialConstantsFeedback.clear();
         m_requestedTiles = {};
+        m_prefetchTiles = {};
+        m_requestedPackedMips.clear();
+        m_tileReadRetries.clear();
 
+        m_tileStreamer.SetTileCache(nullptr);
         m_feedbackManager.reset();
     }
 
@@ -811,11 +884,17 @@ public:
         FeedbackManagerDesc fmDesc = {};
         fmDesc.numFramesInFlight = GetDeviceManager()->GetBackBufferCount();
         fmDesc.heapSizeInTiles = 1024; // 64MiB heap size
+        fmDesc.tileCacheSizeInBytes = 256ull * 1024 * 1024; // Keeps tiles evicted from the heaps in system memory
+        fmDesc.smallTextureSizeInBytes = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES; // Mip chains fitting in a single tile aren't streamed
+        fmDesc.residentMipLevels = 1; // The coarsest regular mip is the fallback for missing tiles instead of the packed mips
+        fmDesc.cameraCutBurstFrames = 30;
         m_feedbackManager = std::shared_ptr<FeedbackManager>(CreateFeedbackManager(GetDevice(), fmDesc));
+        m_tileStreamer.SetTileCache(fmDesc.tileCacheSizeInBytes > 0 ? m_feedbackManager.get() : nullptr);
 
         m_recreateFeedbackTextures = true;
         m_recreateFeedbackTextureSets = true;
         m_cameraCut = true;
+        m_loadResidencySnapshot = true;
 
         CopyActiveCameraToFirstPerson();
     }
@@ -825,6 +904,52 @@ public:
         return m_TextureCache;
     }
 
+    // Translates a texture path in the virtual file system to a native path, empty if the file isn't on disk
+    std::filesystem::path GetNativeTexturePath(const std::string& path)
+    {
+        const std::string mediaPrefix = "/media/";
+        const std::string nativePrefix = "/native/";
+
+        if (path.compare(0, mediaPrefix.size(), mediaPrefix) == 0)
+            return m_mediaPath / path.substr(mediaPrefix.size());
+        if (path.compare(0, nativePrefix.size(), nativePrefix) == 0)
+            return path.substr(nativePrefix.size());
+
+        return {};
+    }
+
+    // Residency snapshots are kept next to the scene file, so a session starts streaming the tiles resident when the last one ended
+    std::filesystem::path GetResidencySnapshotPath()
+    {
+        std::filesystem::path scenePath = GetNativeTexturePath(m_currentSceneName);
+        return scenePath.empty() ? scenePath : scenePath.replace_extension(".residency");
+    }
+
+    void SaveResidencySnapshot()
+    {
+        std::filesystem::path snapshotPath = GetResidencySnapshotPath();
+        if (!m_feedbackManager || snapshotPath.empty())
+            return;
+
+        std::vector<uint8_t> data;
+        m_feedbackManager->SaveResidencySnapshot(data);
+        if (!NativeFileSystem().writeFile(snapshotPath, data.data(), data.size()))
+            log::warning("Cannot write residency snapshot '%s'", snapshotPath.generic_string().c_str());
+    }
+
+    void LoadResidencySnapshot()
+    {
+        std::filesystem::path snapshotPath = GetResidencySnapshotPath();
+        std::shared_ptr<IBlob> blob = snapshotPath.empty() ? nullptr : NativeFileSystem().readFile(snapshotPath);
+        if (!blob)
+            return;
+
+        const uint8_t* blobData = static_cast<const uint8_t*>(blob->data());
+        std::vector<uint8_t> data(blobData, blobData + blob->size());
+        uint32_t texturesRestored = m_feedbackManager->LoadResidencySnapshot(data, m_ui.residencySnapshotDeadlineSeconds);
+        log::info("Residency of %u textures restored from '%s'", texturesRestored, snapshotPath.generic_string().c_str());
+    }
+
     std::shared_ptr<Scene> GetScene()
     {
         return m_scene;
@@ -965,6 +1090,8 @@ public:
         if (m_gBufferPass) m_gBufferPass->ResetBindingCache();
         if (m_gBufferReadDepthPass) m_gBufferReadDepthPass->ResetBindingCache();
 
+        FlushTileStreamer();
+
         m_feedbackTextureMaps.m_feedbackTexturesByFeedback.clear();
         m_feedbackTextureMaps.m_feedbackTexturesByName.clear();
         m_feedbackTextureMaps.m_feedbackTexturesBySource.clear();
@@ -976,6 +1103,8 @@ public:
             nvrhi::CommandListHandle commandList = device->createCommandList();
             commandList->open();
 
+            uint32_t numMappedTextures = 0;
+
             // Normal textures based on the scene
             auto& cache = GetTextureCache();
             for (auto it = cache->begin(); it != cache->end(); ++it)
@@ -986,12 +1115,10 @@ public:
                 uint textureWidth = texture->width;
                 uint textureHeight = texture->height;
 
-                bool isBlockCompressed = (texture->format >= nvrhi::Format::BC1_UNORM && texture->format <= nvrhi::Format::BC7_UNORM_SRGB);
-                if (isBlockCompressed)
-                {
-                    textureWidth = (textureWidth + 3) & ~3;
-                    textureHeight = (textureHeight + 3) & ~3;
-                }
+                // Block compressed textures are created with whole blocks
+                uint32_t blockSize = nvrhi::getFormatInfo(texture->format).blockSize;
+                textureWidth = (textureWidth + blockSize - 1) / blockSize * blockSize;
+                textureHeight = (textureHeight + blockSize - 1) / blockSize * blockSize;
 
                 nvrhi::TextureDesc textureDesc;
                 textureDesc.format = texture->format;
@@ -1004,10 +1131,32 @@ public:
                 textureDesc.debugName = texture->path;
                 textureDesc.isRenderTarget = texture->isRenderTarget;
 
-                bool useTiledTexture = isBlockCompressed && textureDesc.depth == 1 && textureDesc.arraySize == 1;
-                if (!useTiledTexture)
+                // RGBA8 textures with a tile pack transcoded to BC next to them are streamed in the format of the pack
+                std::shared_ptr<TileDataSource> tileDataSource;
+                std::filesystem::path nativePath = GetNativeTexturePath(texture->path);
+                if (blockSize == 1 && !nativePath.empty() && textureDesc.depth == 1)
+                {
+                    tileDataSource = TilePackTileSource::Create(std::filesystem::path(nativePath).replace_extension(".tilepack"), *texture);
+                    if (tileDataSource && tileDataSource->GetFormat() != texture->format)
+                    {
+                        textureDesc.format = tileDataSource->GetFormat();
+                        textureDesc.width = (textureWidth + 3) & ~3;
+                        textureDesc.height = (textureHeight + 3) & ~3;
+                    }
+                    else
+                        tileDataSource.reset();
+                }
+
+                // Any format with standard tile shapes is streamed, such as BC, RGBA8, R16 or float textures, including arrays, cube maps and volumes
+                bool useTiledTexture = nvfeedback::IsTiledFormatSupported(textureDesc.format) && !textureDesc.isRenderTarget;
+
+                // Textures whose whole mip chain fits in a tile are uploaded once into shared pages instead
+                bool isSmallTexture = useTiledTexture && !tileDataSource && texture->data && m_feedbackManager->IsSmallTexture(textureDesc);
+                if (!useTiledTexture || isSmallTexture)
                 {
-                    texture->texture = device->createTexture(textureDesc);
+                    texture->texture = isSmallTexture ? m_feedbackManager->CreateSmallTexture(textureDesc) : nullptr;
+                    if (!texture->texture)
+                        texture->texture = device->createTexture(textureDesc);
                     commandList->beginTrackingTextureState(texture->texture, nvrhi::AllSubresources, nvrhi::ResourceStates::Common);
 
                     const char* dataPointer = static_cast<const char*>(texture->data->data());
@@ -1025,12 +1174,25 @@ public:
                     continue;
                 }
 
+                if (!tileDataSource)
+                    tileDataSource = CreateTileDataSource(texture, nativePath);
+                if (!tileDataSource)
+                {
+                    log::warning("No tile data available for texture '%s'", texture->path.c_str());
+                    continue;
+                }
+                if (!tileDataSource->UsesTextureData())
+                    numMappedTextures++;
+
                 nvrhi::RefCountPtr<FeedbackTexture> feedbackTexture;
-                m_feedbackManager->CreateTexture(textureDesc, &feedbackTexture);
+                if (!m_feedbackManager->CreateTexture(textureDesc, &feedbackTexture))
+                    continue;
+                feedbackTexture->SetTileDataProvider(tileDataSource);
 
                 auto wrapper = std::make_shared<FeedbackTextureWrapper>();
                 wrapper->m_feedbackTexture = feedbackTexture;
                 wrapper->m_sourceTexture = texture;
+                wrapper->m_tileDataSource = tileDataSource;
                 m_feedbackTextureMaps.m_feedbackTexturesByName[name] = wrapper;
                 m_feedbackTextureMaps.m_feedbackTexturesByFeedback[feedbackTexture] = wrapper;
                 m_feedbackTextureMaps.m_feedbackTexturesBySource[texture.get()] = wrapper;
@@ -1040,6 +1202,7 @@ public:
             device->executeCommandList(commandList);
 
             log::info("Created %d tiled textures", m_feedbackTextureMaps.m_feedbackTexturesByName.size());
+            log::info("Tiled textures streamed from files: %u", numMappedTextures);
         }
     }
 
@@ -1113,6 +1276,7 @@ public:
                 uint32_t primaryWidth = primaryTexture->getDesc().width;
                 uint32_t primaryHeight = primaryTexture->getDesc().height;
                 uint32_t primaryMipLevels = primaryTexture->getDesc().mipLevels;
+                uint32_t primaryArraySize = primaryTexture->getDesc().arraySize;
                 uint32_t numTextures = textureSet->GetNumTextures();
                 for (uint32_t i = 0; i < numTextures; i++)
                 {
@@ -1120,10 +1284,12 @@ public:
                     uint32_t width = followerTexture->getDesc().width;
                     uint32_t height = followerTexture->getDesc().height;
                     uint32_t mipLevels = followerTexture->getDesc().mipLevels;
+                    uint32_t arraySize = followerTexture->getDesc().arraySize;
 
-                    if (width > primaryWidth || height > primaryHeight || mipLevels > primaryMipLevels)
+                    if (width > primaryWidth || height > primaryHeight || mipLevels > primaryMipLevels || arraySize != primaryArraySize)
                     {
-                        // Reject this texture set because it has a follower texture that is larger than the primary texture
+                        // Reject this texture set because it has a follower texture that is larger than the primary texture,
+                        // or with other array slices
                         rejectTextureSet = true;
                         break;
                     }
@@ -1195,6 +1361,19 @@ public:
         log::info("Unique primary textures: %zu", uniquePrimaryTextures.size());
     }
 
+    // Returns the number of bytes uploaded for the packed mips of a texture
+    uint64_t GetPackedMipsSizeInBytes(nvfeedback::FeedbackTexture* texture, uint32_t packedTileIndex)
+    {
+        std::vector<nvfeedback::FeedbackTextureTileInfo> tiles;
+        texture->GetTileInfo(packedTileIndex, tiles);
+
+        uint64_t sizeInBytes = 0;
+        for (auto& tile : tiles)
+            sizeInBytes += TileStreamer::GetSizeInBytes(texture, tile.widthInTexels, tile.heightInTexels, tile.depthInTexels);
+
+        return sizeInBytes;
+    }
+
     // At the beginning of the frame, read back and process sampler feedback
     void ProcessFeedbackBeforeRender()
     {
@@ -1202,9 +1381,20 @@ public:
 
         m_tileUploadHelper.BeginFrame(GetFrameIndex());
 
-        // Collection of packed tiles requested, typically right after loading a scene
-        // These always get uploaded using the slower but more flexible packed mip codepath
-        std::vector<RequestedTile> requestedPackedTiles;
+        // Volume textures have no sampler feedback. The scene shaders don't sample them, so the sample simply keeps them resident.
+        for (auto& pair : m_feedbackTextureMaps.m_feedbackTexturesByName)
+        {
+            FeedbackTexture* feedbackTexture = pair.second->m_feedbackTexture;
+            if (!feedbackTexture->IsVolume())
+                continue;
+
+            const nvrhi::TextureDesc& desc = feedbackTexture->GetReservedTexture()->getDesc();
+            nvfeedback::FeedbackTextureTileInfo region = {};
+            region.widthInTexels = desc.width;
+            region.heightInTexels = desc.height;
+            region.depthInTexels = desc.depth;
+            m_feedbackManager->RequestVolumeRegion(feedbackTexture, region);
+        }
 
         // Begin frame, readback feedback
         {
@@ -1219,76 +1409,211 @@ public:
             fconfig.trimStandbyTiles = m_ui.compactMemory;
             fconfig.releaseEmptyHeaps = m_ui.compactMemory;
             fconfig.numExtraStandbyTiles = m_ui.numExtraStandbyTiles;
+            fconfig.mipHysteresisLevels = std::max(m_ui.mipHysteresisLevels, 0);
+            fconfig.thrashWindowFrames = 30;
+            fconfig.predictTiles = m_ui.predictTiles;
+            dm::float3 cameraPosition = GetActiveCamera().GetPosition();
+            fconfig.cameraPosition[0] = cameraPosition.x;
+            fconfig.cameraPosition[1] = cameraPosition.y;
+            fconfig.cameraPosition[2] = cameraPosition.z;
             if (m_cameraCut)
             {
-                fconfig.maxTexturesToUpdate = 0;
+                m_feedbackManager->NotifyCameraCut();
                 m_cameraCut = false;
             }
             m_feedbackManager->BeginFrame(m_commandList, fconfig, &updatedTextures);
 
-            // Collect all tiles and store them in the queue
+            // Collect all tiles and store them in the queues
             for (FeedbackTextureUpdate& texUpdate : updatedTextures.textures)
             {
                 RequestedTile reqTile;
                 reqTile.texture = texUpdate.texture;
+
+                // Every array slice has its own packed mips, which are read as one request
+                std::map<uint32_t, RequestedPackedMips> packedMipsBySlice;
+                std::vector<nvfeedback::FeedbackTextureTileInfo> tiles;
+
                 for (uint32_t i = 0; i < texUpdate.tileIndices.size(); i++)
                 {
                     reqTile.tileIndex = texUpdate.tileIndices[i];
-                    if (texUpdate.texture->IsTilePacked(reqTile.tileIndex))
-                        requestedPackedTiles.push_back(reqTile);
+                    // Prefetch tiles due soon are streamed like tiles requested by feedback
+                    if (texUpdate.isPrefetch && texUpdate.deadlineSeconds > m_ui.prefetchDeadlineSeconds)
+                        m_prefetchTiles.push(reqTile);
+                    else if (texUpdate.texture->IsTilePacked(reqTile.tileIndex))
+                    {
+                        texUpdate.texture->GetTileInfo(reqTile.tileIndex, tiles);
+                        RequestedPackedMips& reqPackedMips = packedMipsBySlice[tiles[0].arraySlice];
+                        reqPackedMips.texture = texUpdate.texture;
+                        reqPackedMips.tileIndices.push_back(reqTile.tileIndex);
+                    }
                     else
                         m_requestedTiles.push(reqTile);
                 }
+
+                for (auto& pair : packedMipsBySlice)
+                {
+                    RequestedPackedMips& reqPackedMips = pair.second;
+                    reqPackedMips.sizeInBytes = GetPackedMipsSizeInBytes(texUpdate.texture, reqPackedMips.tileIndices[0]);
+                    m_requestedPackedMips.push_back(reqPackedMips);
+                }
             }
 
             m_commandList->close();
             device->executeCommandList(m_commandList);
         }
 
-        // Figure out which tiles to map and upload this frame
-        FeedbackTextureCollection tilesThisFrame;
-        if (!requestedPackedTiles.empty() || !m_requestedTiles.empty())
-        {
-            // Compute how many tiles we will upload this frame
-            uint32_t countUpload = std::min((uint32_t)m_requestedTiles.size(), m_tileUploadHelper.NumTilesMax());
-            countUpload = std::min(countUpload, (uint32_t)m_ui.tilesPerFrame);
+        m_tileStreamer.SetTranscodeQuality(m_ui.transcodeQuality);
 
-            // This schedules a tile to be uploaded this frame
-            auto scheduleTileForUpload = [&](const RequestedTile& reqTile)
+        // Figure out which tiles to start reading this frame
+        if (!m_requestedPackedMips.empty() || !m_requestedTiles.empty())
+        {
+            // The upload budget is shared by packed mips and regular tiles and is measured in bytes.
+            // It is raised while the working set of a new viewpoint streams in after a camera cut.
+            const uint64_t cameraCutBudgetScale = 4;
+            uint64_t uploadBudgetBytes = uint64_t(std::max(m_ui.tilesPerFrame, 1)) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+            if (m_feedbackManager->IsCameraCutBurst())
+                uploadBudgetBytes *= cameraCutBudgetScale;
+            uint64_t uploadBytes = 0;
+
+            // This starts reading the packed mips of textures in request order while they fit in the budget.
+            // The first request of a frame is always taken so that packed mips larger than the budget still make progress.
+            auto schedulePackedMipsForUpload = [&](bool visible)
             {
-                // Find if we already have this texture in tilesThisFrame
-                FeedbackTextureUpdate* pTexUpdate = nullptr;
-                for (uint32_t t = 0; t < tilesThisFrame.textures.size(); t++)
+                for (auto it = m_requestedPackedMips.begin(); it != m_requestedPackedMips.end();)
                 {
-                    if (tilesThisFrame.textures[t].texture == reqTile.texture)
+                    if (it->texture->IsVisible() != visible)
                     {
-                        pTexUpdate = &tilesThisFrame.textures[t];
-                        break;
+                        ++it;
+                        continue;
                     }
+
+                    if (uploadBytes > 0 && uploadBytes + it->sizeInBytes > uploadBudgetBytes)
+                        break;
+
+                    m_tileStreamer.RequestPackedMips(it->texture, it->tileIndices);
+
+                    uploadBytes += it->sizeInBytes;
+                    it = m_requestedPackedMips.erase(it);
                 }
+            };
+
+            // Packed mips of textures on screen go first as they are the fallback for every missing tile
+            schedulePackedMipsForUpload(true);
 
-                if (pTexUpdate == nullptr)
+            // Regular tiles use what is left of the budget, each one is read into a free upload slot.
+            // Tiles with the same content as a resident tile are copied on the GPU instead and cost neither.
+            uint64_t remainingBytes = uploadBudgetBytes - std::min(uploadBytes, uploadBudgetBytes);
+            uint32_t countUpload = std::min(m_tileUploadHelper.NumFreeSlots(), uint32_t(remainingBytes / D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES));
+            uint32_t countRequested = 0;
+            while (!m_requestedTiles.empty())
+            {
+                const RequestedTile& reqTile = m_requestedTiles.front();
+                if (!m_feedbackManager->ShareTile(reqTile.texture, reqTile.tileIndex))
                 {
-                    // First time we see this texture this frame
-                    FeedbackTextureUpdate texUpdate;
-                    texUpdate.texture = reqTile.texture;
-                    tilesThisFrame.textures.push_back(texUpdate);
-                    pTexUpdate = &tilesThisFrame.textures.back();
+                    if (countRequested == countUpload)
+                        break;
+
+                    uint32_t slot = m_tileUploadHelper.AllocateSlot();
+                    m_tileStreamer.RequestTile(reqTile.texture, reqTile.tileIndex, slot, m_tileUploadHelper.GetSlotData(slot));
+                    countRequested++;
                 }
+                m_requestedTiles.pop();
+            }
+            uploadBytes += uint64_t(countRequested) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
 
-                pTexUpdate->tileIndices.push_back(reqTile.tileIndex);
-            };
+            // Packed mips of textures which have not been seen yet are spread over the following frames
+            schedulePackedMipsForUpload(false);
+        }
 
-            // Upload all packed tiles this frame
-            for (auto& packedTile : requestedPackedTiles)
-                scheduleTileForUpload(packedTile);
+        // Prefetch tiles have a budget of their own and wait while tiles requested by feedback use all upload slots
+        if (!m_prefetchTiles.empty() && m_requestedTiles.empty())
+        {
+            uint32_t countPrefetch = std::min(m_tileUploadHelper.NumFreeSlots(), uint32_t(std::max(m_ui.prefetchTilesPerFrame, 0)));
+            uint32_t countRequested = 0;
+            while (!m_prefetchTiles.empty())
+            {
+                const RequestedTile& reqTile = m_prefetchTiles.front();
+                if (!m_feedbackManager->ShareTile(reqTile.texture, reqTile.tileIndex))
+                {
+                    if (countRequested == countPrefetch)
+                        break;
 
-            // Upload only countUpload regular tiles
-            for (uint32_t i = 0; i < countUpload; i++)
+                    uint32_t slot = m_tileUploadHelper.AllocateSlot();
+                    m_tileStreamer.RequestTile(reqTile.texture, reqTile.tileIndex, slot, m_tileUploadHelper.GetSlotData(slot));
+                    countRequested++;
+                }
+                m_prefetchTiles.pop();
+            }
+        }
+
+        m_tileStreamer.Dispatch();
+
+        // Only tiles whose data has arrived are mapped and uploaded
+        std::vector<std::unique_ptr<StreamedTiles>> streamedTiles;
+        m_tileStreamer.GetCompletedTiles(streamedTiles);
+
+        FeedbackTextureCollection tilesThisFrame;
+        for (auto& streamed : streamedTiles)
+        {
+            auto readKey = std::make_pair(streamed->texture, streamed->tileIndices[0]);
+            if (!streamed->success)
             {
-                scheduleTileForUpload(m_requestedTiles.front());
-                m_requestedTiles.pop();
+                log::warning("Failed to read tile data of texture '%s'", m_feedbackTextureMaps.m_feedbackTexturesByFeedback[streamed->texture]->m_sourceTexture->path.c_str());
+                if (!streamed->isPacked)
+                    m_tileUploadHelper.FreeSlot(streamed->uploadSlot);
+
+                // The tiles are allocated for the texture, read them again a few times and then hand them back to the
+                // feedback manager, which returns them from a later BeginFrame
+                const uint32_t maxTileReadRetries = 3;
+                uint32_t& retries = m_tileReadRetries[readKey];
+                if (retries < maxTileReadRetries)
+                {
+                    retries++;
+                    if (streamed->isPacked)
+                    {
+                        RequestedPackedMips reqPackedMips;
+                        reqPackedMips.texture = streamed->texture;
+                        reqPackedMips.tileIndices = streamed->tileIndices;
+                        reqPackedMips.sizeInBytes = GetPackedMipsSizeInBytes(streamed->texture, streamed->tileIndices[0]);
+                        m_requestedPackedMips.push_back(reqPackedMips);
+                    }
+                    else
+                    {
+                        for (auto tileIndex : streamed->tileIndices)
+                            m_requestedTiles.push({ streamed->texture, tileIndex });
+                    }
+                }
+                else
+                {
+                    m_tileReadRetries.erase(readKey);
+                    m_feedbackManager->RetryTiles(streamed->texture, streamed->tileIndices);
+                }
+                continue;
+            }
+            if (!m_tileReadRetries.empty())
+                m_tileReadRetries.erase(readKey);
+
+            // Find if we already have this texture in tilesThisFrame
+            FeedbackTextureUpdate* pTexUpdate = nullptr;
+            for (uint32_t t = 0; t < tilesThisFrame.textures.size(); t++)
+            {
+                if (tilesThisFrame.textures[t].texture == streamed->texture)
+                {
+                    pTexUpdate = &tilesThisFrame.textures[t];
+                    break;
+                }
+            }
+
+            if (pTexUpdate == nullptr)
+            {
+                // First time we see this texture this frame
+                FeedbackTextureUpdate texUpdate;
+                texUpdate.texture = streamed->texture;
+                tilesThisFrame.textures.push_back(texUpdate);
+                pTexUpdate = &tilesThisFrame.textures.back();
             }
+
+            pTexUpdate->tileIndices.insert(pTexUpdate->tileIndices.end(), streamed->tileIndices.begin(), streamed->tileIndices.end());
         }
 
         // Call UpdateTileMappings always (it might be needed for defragmentation)
@@ -1304,26 +1629,19 @@ public:
             GetDevice()->executeCommandList(m_commandList);
         }
 
-        // Upload the tiles to the GPU and copy them into the resources
+        // Copy the tiles into the resources
         if (tilesThisFrame.textures.size() > 0)
         {
             m_commandList->open();
             ID3D12GraphicsCommandList* pCommandList = m_commandList->getNativeObject(nvrhi::ObjectTypes::D3D12_GraphicsCommandList);
 
-            std::vector<nvfeedback::FeedbackTextureTileInfo> tiles;
-
-            for (FeedbackTextureUpdate& texUpdate : tilesThisFrame.textures)
+            for (auto& streamed : streamedTiles)
             {
-                auto& wrapper = m_feedbackTextureMaps.m_feedbackTexturesByFeedback[texUpdate.texture];
-                auto& reservedTexture = wrapper->m_feedbackTexture->GetReservedTexture();
+                if (!streamed->success)
+                    continue;
 
-                // Get tiling info
-                uint32_t numTiles = 0;
-                nvrhi::PackedMipDesc packedMipDesc = {};
-                nvrhi::TileShape tileShape = {};
-                uint32_t mipLevels = reservedTexture->getDesc().mipLevels;
-                std::array<nvrhi::SubresourceTiling, 16> tilingsInfo;
-                device->getTextureTiling(reservedTexture, &numTiles, &packedMipDesc, &tileShape, &mipLevels, tilingsInfo.data());
+                auto& wrapper = m_feedbackTextureMaps.m_feedbackTexturesByFeedback[streamed->texture];
+                auto& reservedTexture = wrapper->m_feedbackTexture->GetReservedTexture();
 
                 // NOTE: This is currently required to talk directly to the d3d12 commandlist for requireTextureState and commitBarriers
                 // This hack is incompatible with the NVRHI validation layer
@@ -1331,32 +1649,29 @@ public:
                 d3d12CommandList->requireTextureState(reservedTexture, nvrhi::AllSubresources, nvrhi::ResourceStates::CopyDest);
                 d3d12CommandList->commitBarriers();
 
-                auto& textureData = wrapper->m_sourceTexture;
-                ID3D12Resource* pResource = reservedTexture->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource);
-
-                for (auto& tileIndex : texUpdate.tileIndices)
+                if (streamed->isPacked)
                 {
-                    texUpdate.texture->GetTileInfo(tileIndex, tiles);
-                    for (auto& tile : tiles)
+                    // Flexible, but slower, path for uploading packed mips
+                    for (size_t i = 0; i < streamed->tiles.size(); i++)
                     {
-                        if (texUpdate.texture->IsTilePacked(tileIndex))
-                        {
-                            // Flexible, but slower, path for uploading packed mips
-                            const TextureSubresourceData& layout = textureData->dataLayout[0][tile.mip];
-                            const char* dataPointer = static_cast<const char*>(textureData->data->data());
-
-                            m_commandList->writeTexture(reservedTexture, 0, tile.mip, dataPointer + layout.dataOffset,
-                                layout.rowPitch, layout.depthPitch);
-                        }
-                        else
-                        {
-                            // More efficient path for uploading regular tiles
-                            const TextureSubresourceData& layout = textureData->dataLayout[0][tile.mip];
-                            const char* mipBase = static_cast<const char*>(textureData->data->data()) + layout.dataOffset;
-                            bool uploadSuccess = m_tileUploadHelper.UploadTile(pCommandList, pResource, tile, mipBase, tileShape,(uint32_t)layout.rowPitch);
-                            assert(uploadSuccess);
-                        }
+                        const auto& tile = streamed->tiles[i];
+                        uint64_t sizeInBytes = TileStreamer::GetSizeInBytes(streamed->texture, tile.widthInTexels, tile.heightInTexels);
+                        m_commandList->writeTexture(reservedTexture, tile.arraySlice, tile.mip, streamed->packedData.data() + streamed->packedOffsets[i], streamed->packedRowPitches[i], sizeInBytes);
                     }
+
+                    // Once the packed mips are uploaded the decoded texture is no longer needed if tiles come from a file
+                    TileDataSource* tileDataSource = wrapper->m_tileDataSource.get();
+                    if (tileDataSource && !tileDataSource->UsesTextureData())
+                        wrapper->m_sourceTexture->data.reset();
+                }
+                else
+                {
+                    // More efficient path for uploading regular tiles, the data has been read into the upload buffer
+                    ID3D12Resource* pResource = reservedTexture->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource);
+                    if (!streamed->stagedData.empty())
+                        m_tileUploadHelper.UploadStagedTile(pCommandList, pResource, streamed->tiles[0], streamed->uploadSlot, streamed->stagedData, streamed->rowPitch);
+                    else
+                        m_tileUploadHelper.UploadTile(pCommandList, pResource, streamed->tiles[0], streamed->uploadSlot, streamed->rowPitch);
                 }
             }
 
@@ -1365,6 +1680,19 @@ public:
         }
     }
 
+    // Waits for all tile reads and drops them, before feedback textures are destroyed
+    void FlushTileStreamer()
+    {
+        std::vector<std::unique_ptr<StreamedTiles>> discardedTiles;
+        m_tileStreamer.Flush(discardedTiles);
+
+        for (auto& streamed : discardedTiles)
+        {
+            if (!streamed->isPacked)
+                m_tileUploadHelper.FreeSlot(streamed->uploadSlot);
+        }
+    }
+
     // After rendering, resolve feedback and do some housekeeping
     void ProcessFeedbackAfterRender()
     {
@@ -1386,6 +1714,7 @@ public:
         m_perfFeedbackBegin.AddSample(stats.cputimeBeginFrame);
         m_perfFeedbackUpdateTileMappings.AddSample(stats.cputimeUpdateTileMappings);
         m_perfFeedbackResolve.AddSample(stats.cputimeResolve);
+        m_perfTileDecode.AddSample(m_tileStreamer.TakeDecodeTime());
 
         // Get frames per second and adjust max num samples to roughly match it
         float const frameTime = (float)GetDeviceManager()->GetAverageFrameTimeSeconds();
@@ -1395,6 +1724,7 @@ public:
         m_perfFeedbackBegin.SetMaxNumSamples(newMaxNumSamples);
         m_perfFeedbackUpdateTileMappings.SetMaxNumSamples(newMaxNumSamples);
         m_perfFeedbackResolve.SetMaxNumSamples(newMaxNumSamples);
+        m_perfTileDecode.SetMaxNumSamples(newMaxNumSamples);
     }
 
     // Main render function
@@ -1406,6 +1736,13 @@ public:
         // Make sure texture sets are created
         EnsureTextureSets();
 
+        // The tiles of the last session are requested once all textures of the scene exist
+        if (m_loadResidencySnapshot)
+        {
+            m_loadResidencySnapshot = false;
+            LoadResidencySnapshot();
+        }
+
         // Perform all the feedback/tiled code before rendering the frame
         ProcessFeedbackBeforeRender();
 
@@ -1853,6 +2190,11 @@ protected:
             ImGui::Text("BeginFrame max: %.3f ms, avg: %.3f ms", tBeginMax * 1e3, tBeginAvg * 1e3);
             ImGui::Text("UpdateTileMappings max: %.3f ms, avg: %.3f ms", tUpdateTileMappingsMax * 1e3, tUpdateTileMappingsAvg * 1e3);
             ImGui::Text("Resolve max: %.3f ms, avg: %.3f ms", tResolveMax * 1e3, tResolveAvg * 1e3);
+
+            // Summed over the I/O worker threads, not on the render thread
+            double tDecodeMax = m_app->m_perfTileDecode.GetMax();
+            double tDecodeAvg = m_app->m_perfTileDecode.GetAverage();
+            ImGui::Text("Tile Decode max: %.3f ms, avg: %.3f ms", tDecodeMax * 1e3, tDecodeAvg * 1e3);
         }
 
 #if _DEBUG
@@ -1907,6 +2249,13 @@ protected:
         ImGui::SliderInt("Tiles Per Frame", &m_ui.tilesPerFrame, 1, 100);
         ImGui::SliderFloat("Tile Timeout Seconds", &m_ui.tileTimeout, 0, 1.0f);
         ImGui::SliderInt("Extra Standby Tiles", &m_ui.numExtraStandbyTiles, 0, 2000);
+        ImGui::SliderInt("Mip Hysteresis Levels", &m_ui.mipHysteresisLevels, 0, 4);
+        ImGui::Checkbox("Predict Tiles", &m_ui.predictTiles);
+        ImGui::SliderInt("Prefetch Tiles Per Frame", &m_ui.prefetchTilesPerFrame, 0, 100);
+        ImGui::SliderFloat("Prefetch Deadline (s)", &m_ui.prefetchDeadlineSeconds, 0.0f, 5.0f);
+        if (ImGui::Button("Save Residency Snapshot"))
+            m_app->SaveResidencySnapshot();
+        ImGui::Combo("Transcode Quality", (int*)&m_ui.transcodeQuality, "Fast\0Normal\0High\0");
 
         ImGui::Separator();
         constexpr double mebibyte = 1024 * 1024;
@@ -1919,6 +2268,44 @@ protected:
         ImGui::Text("Heap Allocation: %.0f MiB", tilesHeapAllocatedMib);
         ImGui::Text("Heap Free Tiles: %d (%.0f MiB)", stats.heapTilesFree, double(uint64_t(stats.heapTilesFree)* uint64_t(D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES)) / mebibyte);
 
+        TileStreamerStats streamerStats = m_app->m_tileStreamer.GetStats();
+        ImGui::Text("Tile I/O (%s): %u in flight (%.1f MiB), %u queued", m_app->m_tileStreamer.GetBackendName(),
+            streamerStats.requestsInFlight, double(streamerStats.bytesInFlight) / mebibyte, streamerStats.requestsPending);
+        ImGui::Text("Tile Reads: %llu (%llu merged), %llu failed", streamerStats.readsIssued, streamerStats.requestsCoalesced, streamerStats.requestsFailed);
+        ImGui::Text("Tiles Decoded: %llu (%.0f MiB), %llu transcoded", streamerStats.tilesDecoded, double(streamerStats.bytesDecoded) / mebibyte,
+            streamerStats.tilesTranscoded);
+        uint64_t tileCacheLookups = stats.tileCacheHits + stats.tileCacheMisses;
+        ImGui::Text("Tile Cache: %u tiles (%.0f MiB), %.1f%% hits", stats.tileCacheTiles, double(stats.tileCacheSizeInBytes) / mebibyte,
+            tileCacheLookups ? 100.0 * double(stats.tileCacheHits) / double(tileCacheLookups) : 0.0);
+        if (tileCacheLookups && ImGui::TreeNode("Tile Cache Hits by Mip"))
+        {
+            for (uint32_t mip = 0; mip < nvfeedback::StatsMipLevels; mip++)
+            {
+                uint64_t mipLookups = stats.tileCacheHitsByMip[mip] + stats.tileCacheMissesByMip[mip];
+                if (mipLookups)
+                    ImGui::Text("Mip %u%s: %.1f%% of %llu", mip, mip + 1 == nvfeedback::StatsMipLevels ? "+" : "",
+                        100.0 * double(stats.tileCacheHitsByMip[mip]) / double(mipLookups), mipLookups);
+            }
+            ImGui::TreePop();
+        }
+        ImGui::Text("Tiles Shared: %u resident duplicates, %llu copied (%.0f MiB not read)", stats.tilesDuplicate, stats.tilesShared,
+            double(stats.tilesShared * uint64_t(D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES)) / mebibyte);
+        ImGui::Text("Tiles Uniform: %u resident on %u constant tiles", stats.tilesUniform, stats.constantTiles);
+        ImGui::Text("Small Textures: %u in %.0f MiB of pages", stats.smallTextures, double(stats.smallTexturePageBytes) / mebibyte);
+        ImGui::Text("Tiles Thrashed: %llu requested again within 30 frames of unmapping", stats.tilesThrashed);
+        ImGui::Text("Tiles Prefetched: %llu (%zu queued, %u hints)", stats.tilesPrefetched, m_app->m_prefetchTiles.size(), stats.prefetchHints);
+        ImGui::Text("Tiles Pinned: %u below the resident mip floor (%.0f MiB)", stats.tilesPinned,
+            double(uint64_t(stats.tilesPinned) * uint64_t(D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES)) / mebibyte);
+        if (stats.tilesThrashed && ImGui::TreeNode("Tiles Thrashed by Mip"))
+        {
+            for (uint32_t mip = 0; mip < nvfeedback::StatsMipLevels; mip++)
+            {
+                if (stats.tilesThrashedByMip[mip])
+                    ImGui::Text("Mip %u%s: %llu", mip, mip + 1 == nvfeedback::StatsMipLevels ? "+" : "", stats.tilesThrashedByMip[mip]);
+            }
+            ImGui::TreePop();
+        }
+
         ImGui::Separator();
 
         if (stats.tilesTotal)
@@ -2017,6 +2404,8 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         deviceManager->AddRenderPassToBack(gui.get());
 
         deviceManager->RunMessageLoop();
+
+        demo->SaveResidencySnapshot();
     }
 
     deviceManager->Shutdown();
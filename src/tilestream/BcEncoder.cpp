@@ -0,0 +1,960 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "BcEncoder.h"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TILESTREAM_WITH_SSE2 1
+#endif
+
+namespace tilestream
+{
+    namespace
+    {
+        // Texels of a block with each channel stored contiguously, so 4 texels are processed at once
+        struct BlockTexels
+        {
+            alignas(16) float channels[4][16];
+        };
+
+        void LoadBlockTexels(const uint8_t* rgba, BlockTexels& texels)
+        {
+#ifdef TILESTREAM_WITH_SSE2
+            const __m128i byteMask = _mm_set1_epi32(0xFF);
+            for (uint32_t i = 0; i < 16; i += 4)
+            {
+                __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4));
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    __m128i channel = _mm_and_si128(pixels, byteMask);
+                    _mm_store_ps(&texels.channels[c][i], _mm_cvtepi32_ps(channel));
+                    pixels = _mm_srli_epi32(pixels, 8);
+                }
+            }
+#else
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                for (uint32_t c = 0; c < 4; c++)
+                    texels.channels[c][i] = float(rgba[i * 4 + c]);
+            }
+#endif
+        }
+
+#ifdef TILESTREAM_WITH_SSE2
+        float HorizontalSum(__m128 value)
+        {
+            value = _mm_add_ps(value, _mm_movehl_ps(value, value));
+            value = _mm_add_ss(value, _mm_shuffle_ps(value, value, 1));
+            return _mm_cvtss_f32(value);
+        }
+
+        float HorizontalMin(__m128 value)
+        {
+            value = _mm_min_ps(value, _mm_movehl_ps(value, value));
+            value = _mm_min_ss(value, _mm_shuffle_ps(value, value, 1));
+            return _mm_cvtss_f32(value);
+        }
+
+        float HorizontalMax(__m128 value)
+        {
+            value = _mm_max_ps(value, _mm_movehl_ps(value, value));
+            value = _mm_max_ss(value, _mm_shuffle_ps(value, value, 1));
+            return _mm_cvtss_f32(value);
+        }
+#endif
+
+        // Mean, range and covariance of the channels of a block, only the upper triangle of the covariance is filled
+        template <uint32_t numChannels>
+        void ComputeChannelStats(const BlockTexels& texels, float* mean, float* minimum, float* maximum, float covariance[4][4])
+        {
+#ifdef TILESTREAM_WITH_SSE2
+            __m128 centered[4][4];
+            for (uint32_t c = 0; c < numChannels; c++)
+            {
+                __m128 v0 = _mm_load_ps(&texels.channels[c][0]);
+                __m128 v1 = _mm_load_ps(&texels.channels[c][4]);
+                __m128 v2 = _mm_load_ps(&texels.channels[c][8]);
+                __m128 v3 = _mm_load_ps(&texels.channels[c][12]);
+                minimum[c] = HorizontalMin(_mm_min_ps(_mm_min_ps(v0, v1), _mm_min_ps(v2, v3)));
+                maximum[c] = HorizontalMax(_mm_max_ps(_mm_max_ps(v0, v1), _mm_max_ps(v2, v3)));
+                mean[c] = HorizontalSum(_mm_add_ps(_mm_add_ps(v0, v1), _mm_add_ps(v2, v3))) * (1.0f / 16.0f);
+
+                __m128 channelMean = _mm_set1_ps(mean[c]);
+                centered[c][0] = _mm_sub_ps(v0, channelMean);
+                centered[c][1] = _mm_sub_ps(v1, channelMean);
+                centered[c][2] = _mm_sub_ps(v2, channelMean);
+                centered[c][3] = _mm_sub_ps(v3, channelMean);
+            }
+
+            for (uint32_t a = 0; a < numChannels; a++)
+            {
+                for (uint32_t b = a; b < numChannels; b++)
+                {
+                    __m128 sum = _mm_mul_ps(centered[a][0], centered[b][0]);
+                    sum = _mm_add_ps(sum, _mm_mul_ps(centered[a][1], centered[b][1]));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(centered[a][2], centered[b][2]));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(centered[a][3], centered[b][3]));
+                    covariance[a][b] = HorizontalSum(sum);
+                }
+            }
+#else
+            for (uint32_t c = 0; c < numChannels; c++)
+            {
+                mean[c] = 0.0f;
+                minimum[c] = 255.0f;
+                maximum[c] = 0.0f;
+                for (uint32_t i = 0; i < 16; i++)
+                {
+                    float value = texels.channels[c][i];
+                    mean[c] += value;
+                    minimum[c] = std::min(minimum[c], value);
+                    maximum[c] = std::max(maximum[c], value);
+                }
+                mean[c] *= 1.0f / 16.0f;
+            }
+
+            for (uint32_t a = 0; a < numChannels; a++)
+            {
+                for (uint32_t b = a; b < numChannels; b++)
+                {
+                    covariance[a][b] = 0.0f;
+                    for (uint32_t i = 0; i < 16; i++)
+                        covariance[a][b] += (texels.channels[a][i] - mean[a]) * (texels.channels[b][i] - mean[b]);
+                }
+            }
+#endif
+        }
+
+        // Assigns each texel to one of numLevels evenly spaced points between start and end by projecting it on the
+        // line between them. Faster than searching the palette, exact for evenly spaced palettes.
+        template <uint32_t numChannels>
+        void ProjectTexels(const BlockTexels& texels, const float* start, const float* end, uint32_t numLevels, uint8_t* levels)
+        {
+            float direction[4] = {};
+            float lengthSquared = 0.0f;
+            for (uint32_t c = 0; c < numChannels; c++)
+            {
+                direction[c] = end[c] - start[c];
+                lengthSquared += direction[c] * direction[c];
+            }
+
+            if (lengthSquared < 1e-6f)
+            {
+                memset(levels, 0, 16);
+                return;
+            }
+
+            float scale = float(numLevels - 1) / lengthSquared;
+            for (uint32_t c = 0; c < numChannels; c++)
+                direction[c] *= scale;
+
+#ifdef TILESTREAM_WITH_SSE2
+            const __m128 maxLevel = _mm_set1_ps(float(numLevels - 1));
+            const __m128 half = _mm_set1_ps(0.5f);
+            for (uint32_t i = 0; i < 16; i += 4)
+            {
+                __m128 t = _mm_setzero_ps();
+                for (uint32_t c = 0; c < numChannels; c++)
+                {
+                    __m128 value = _mm_sub_ps(_mm_load_ps(&texels.channels[c][i]), _mm_set1_ps(start[c]));
+                    t = _mm_add_ps(t, _mm_mul_ps(value, _mm_set1_ps(direction[c])));
+                }
+                t = _mm_min_ps(_mm_max_ps(_mm_add_ps(t, half), _mm_setzero_ps()), maxLevel);
+
+                alignas(16) int32_t result[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(result), _mm_cvttps_epi32(t));
+                for (uint32_t j = 0; j < 4; j++)
+                    levels[i + j] = uint8_t(result[j]);
+            }
+#else
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                float t = 0.5f;
+                for (uint32_t c = 0; c < numChannels; c++)
+                    t += (texels.channels[c][i] - start[c]) * direction[c];
+                levels[i] = uint8_t(std::min(std::max(t, 0.0f), float(numLevels - 1)));
+            }
+#endif
+        }
+
+        // Assigns each texel to the closest palette entry and returns the squared error of the block
+        template <uint32_t numChannels>
+        float SearchPalette(const BlockTexels& texels, const float palette[][4], uint32_t paletteSize, uint8_t* indices)
+        {
+            float totalError = 0.0f;
+#ifdef TILESTREAM_WITH_SSE2
+            for (uint32_t i = 0; i < 16; i += 4)
+            {
+                __m128 bestError = _mm_set1_ps(1e30f);
+                __m128i bestIndex = _mm_setzero_si128();
+                for (uint32_t p = 0; p < paletteSize; p++)
+                {
+                    __m128 error = _mm_setzero_ps();
+                    for (uint32_t c = 0; c < numChannels; c++)
+                    {
+                        __m128 diff = _mm_sub_ps(_mm_load_ps(&texels.channels[c][i]), _mm_set1_ps(palette[p][c]));
+                        error = _mm_add_ps(error, _mm_mul_ps(diff, diff));
+                    }
+                    __m128 better = _mm_cmplt_ps(error, bestError);
+                    bestError = _mm_min_ps(error, bestError);
+                    bestIndex = _mm_or_si128(_mm_andnot_si128(_mm_castps_si128(better), bestIndex),
+                        _mm_and_si128(_mm_castps_si128(better), _mm_set1_epi32(int32_t(p))));
+                }
+
+                alignas(16) int32_t index[4];
+                alignas(16) float error[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(index), bestIndex);
+                _mm_store_ps(error, bestError);
+                for (uint32_t j = 0; j < 4; j++)
+                {
+                    indices[i + j] = uint8_t(index[j]);
+                    totalError += error[j];
+                }
+            }
+#else
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                float bestError = 1e30f;
+                for (uint32_t p = 0; p < paletteSize; p++)
+                {
+                    float error = 0.0f;
+                    for (uint32_t c = 0; c < numChannels; c++)
+                    {
+                        float diff = texels.channels[c][i] - palette[p][c];
+                        error += diff * diff;
+                    }
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        indices[i] = uint8_t(p);
+                    }
+                }
+                totalError += bestError;
+            }
+#endif
+            return totalError;
+        }
+
+        // Finds a line through the texels: the diagonal of their bounding box, or their principal axis.
+        // Returns the two texels, or box corners, furthest apart along it.
+        template <uint32_t numChannels>
+        void FindEndpoints(const BlockTexels& texels, BcQuality quality, float* start, float* end)
+        {
+            float mean[4], minimum[4], maximum[4];
+            float covariance[4][4];
+            ComputeChannelStats<numChannels>(texels, mean, minimum, maximum, covariance);
+
+            // The channel with the largest range leads, the others follow it up or down the diagonal
+            uint32_t leading = 0;
+            for (uint32_t c = 1; c < numChannels; c++)
+            {
+                if (maximum[c] - minimum[c] > maximum[leading] - minimum[leading])
+                    leading = c;
+            }
+
+            if (quality == BcQuality::Fast)
+            {
+                for (uint32_t c = 0; c < numChannels; c++)
+                {
+                    float correlation = c < leading ? covariance[c][leading] : covariance[leading][c];
+                    bool rising = c == leading || correlation >= 0.0f;
+                    start[c] = rising ? minimum[c] : maximum[c];
+                    end[c] = rising ? maximum[c] : minimum[c];
+                }
+                return;
+            }
+
+            // Principal axis by power iteration, starting from the bounding box diagonal
+            float axis[4] = {};
+            for (uint32_t c = 0; c < numChannels; c++)
+            {
+                float correlation = c < leading ? covariance[c][leading] : covariance[leading][c];
+                axis[c] = (c == leading || correlation >= 0.0f) ? maximum[c] - minimum[c] : minimum[c] - maximum[c];
+            }
+
+            for (uint32_t iteration = 0; iteration < 4; iteration++)
+            {
+                float next[4] = {};
+                float length = 0.0f;
+                for (uint32_t a = 0; a < numChannels; a++)
+                {
+                    for (uint32_t b = 0; b < numChannels; b++)
+                        next[a] += (a <= b ? covariance[a][b] : covariance[b][a]) * axis[b];
+                    length = std::max(length, fabsf(next[a]));
+                }
+                if (length < 1e-6f)
+                    break;
+                for (uint32_t c = 0; c < numChannels; c++)
+                    axis[c] = next[c] / length;
+            }
+
+            float minProjection = 1e30f;
+            float maxProjection = -1e30f;
+            uint32_t minTexel = 0;
+            uint32_t maxTexel = 0;
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                float projection = 0.0f;
+                for (uint32_t c = 0; c < numChannels; c++)
+                    projection += texels.channels[c][i] * axis[c];
+                if (projection < minProjection)
+                {
+                    minProjection = projection;
+                    minTexel = i;
+                }
+                if (projection > maxProjection)
+                {
+                    maxProjection = projection;
+                    maxTexel = i;
+                }
+            }
+
+            for (uint32_t c = 0; c < numChannels; c++)
+            {
+                start[c] = texels.channels[c][minTexel];
+                end[c] = texels.channels[c][maxTexel];
+            }
+        }
+
+        // Moves the endpoints towards each other, which lowers the error of texels between the extremes
+        template <uint32_t numChannels>
+        void InsetEndpoints(float* start, float* end, float fraction)
+        {
+            for (uint32_t c = 0; c < numChannels; c++)
+            {
+                float inset = (end[c] - start[c]) * fraction;
+                start[c] += inset;
+                end[c] -= inset;
+            }
+        }
+
+        // Least squares refinement passes of the endpoints after the initial fit
+        uint32_t GetRefineIterations(BcQuality quality)
+        {
+            return quality == BcQuality::High ? 2 : (quality == BcQuality::Normal ? 1 : 0);
+        }
+
+        // Solves for the endpoints minimizing the squared error of the texels given the weight of the end point of each
+        template <uint32_t numChannels>
+        bool RefineEndpoints(const BlockTexels& texels, const float* weights, float* start, float* end)
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[4] = {}, bx[4] = {};
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                float b = weights[i];
+                float a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (uint32_t c = 0; c < numChannels; c++)
+                {
+                    ax[c] += a * texels.channels[c][i];
+                    bx[c] += b * texels.channels[c][i];
+                }
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (fabsf(determinant) < 1e-6f)
+                return false;
+
+            float inverse = 1.0f / determinant;
+            for (uint32_t c = 0; c < numChannels; c++)
+            {
+                start[c] = std::min(std::max((ax[c] * bb - bx[c] * ab) * inverse, 0.0f), 255.0f);
+                end[c] = std::min(std::max((bx[c] * aa - ax[c] * ab) * inverse, 0.0f), 255.0f);
+            }
+            return true;
+        }
+
+        // BC1 color block
+
+        uint16_t EncodeRgb565(const float* color)
+        {
+            uint32_t r = uint32_t(std::min(std::max(color[0] * (31.0f / 255.0f) + 0.5f, 0.0f), 31.0f));
+            uint32_t g = uint32_t(std::min(std::max(color[1] * (63.0f / 255.0f) + 0.5f, 0.0f), 63.0f));
+            uint32_t b = uint32_t(std::min(std::max(color[2] * (31.0f / 255.0f) + 0.5f, 0.0f), 31.0f));
+            return uint16_t((r << 11) | (g << 5) | b);
+        }
+
+        void DecodeRgb565(uint16_t color, uint32_t* rgb)
+        {
+            uint32_t r = (color >> 11) & 31;
+            uint32_t g = (color >> 5) & 63;
+            uint32_t b = color & 31;
+            rgb[0] = (r << 3) | (r >> 2);
+            rgb[1] = (g << 2) | (g >> 4);
+            rgb[2] = (b << 3) | (b >> 2);
+        }
+
+        void GetBc1Palette(uint16_t color0, uint16_t color1, uint32_t palette[4][4])
+        {
+            DecodeRgb565(color0, palette[0]);
+            DecodeRgb565(color1, palette[1]);
+            palette[0][3] = palette[1][3] = 255;
+            if (color0 > color1)
+            {
+                for (uint32_t c = 0; c < 3; c++)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+                palette[2][3] = palette[3][3] = 255;
+            }
+            else
+            {
+                for (uint32_t c = 0; c < 3; c++)
+                {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+                palette[2][3] = 255;
+                palette[3][3] = 0;
+            }
+        }
+
+        // Squared error of the texels against the palette entries they were assigned to
+        template <uint32_t numChannels>
+        float MeasurePaletteError(const BlockTexels& texels, const uint32_t palette[][4], const uint8_t* indices)
+        {
+            float error = 0.0f;
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                for (uint32_t c = 0; c < numChannels; c++)
+                {
+                    float diff = texels.channels[c][i] - float(palette[indices[i]][c]);
+                    error += diff * diff;
+                }
+            }
+            return error;
+        }
+
+        // Quantizes the endpoints and picks the indices, returns the squared error of the block
+        float QuantizeBc1(const BlockTexels& texels, BcQuality quality, const float* start, const float* end, uint16_t& color0, uint16_t& color1, uint32_t& indices)
+        {
+            // Four color mode requires color0 > color1, the end point is color0 so indices run from color1 up
+            color0 = EncodeRgb565(end);
+            color1 = EncodeRgb565(start);
+            if (color0 < color1)
+                std::swap(color0, color1);
+
+            if (color0 == color1)
+            {
+                indices = 0;
+                return 0.0f;
+            }
+
+            uint32_t palette[4][4];
+            GetBc1Palette(color0, color1, palette);
+
+            uint8_t levels[16];
+            float error = 0.0f;
+            if (quality == BcQuality::High)
+            {
+                float paletteFloat[4][4];
+                for (uint32_t p = 0; p < 4; p++)
+                {
+                    for (uint32_t c = 0; c < 3; c++)
+                        paletteFloat[p][c] = float(palette[p][c]);
+                }
+                error = SearchPalette<3>(texels, paletteFloat, 4, levels);
+            }
+            else
+            {
+                // Levels from color1 to color0 map to the indices 1, 3, 2, 0
+                static const uint8_t levelToIndex[4] = { 1, 3, 2, 0 };
+                float from[3] = { float(palette[1][0]), float(palette[1][1]), float(palette[1][2]) };
+                float to[3] = { float(palette[0][0]), float(palette[0][1]), float(palette[0][2]) };
+                ProjectTexels<3>(texels, from, to, 4, levels);
+                for (uint32_t i = 0; i < 16; i++)
+                    levels[i] = levelToIndex[levels[i]];
+                if (quality != BcQuality::Fast)
+                    error = MeasurePaletteError<3>(texels, palette, levels);
+            }
+
+            indices = 0;
+            for (uint32_t i = 0; i < 16; i++)
+                indices |= uint32_t(levels[i]) << (i * 2);
+            return error;
+        }
+
+        void EncodeBc1Color(const BlockTexels& texels, BcQuality quality, uint8_t* dest)
+        {
+            float start[4], end[4];
+            FindEndpoints<3>(texels, quality, start, end);
+            InsetEndpoints<3>(start, end, 1.0f / 16.0f);
+
+            uint16_t color0, color1;
+            uint32_t indices;
+            float error = QuantizeBc1(texels, quality, start, end, color0, color1, indices);
+
+            {
+                static const float indexWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+                for (uint32_t iteration = 0; iteration < GetRefineIterations(quality) && error > 0.0f && color0 != color1; iteration++)
+                {
+                    float weights[16];
+                    for (uint32_t i = 0; i < 16; i++)
+                        weights[i] = indexWeights[(indices >> (i * 2)) & 3];
+                    if (!RefineEndpoints<3>(texels, weights, start, end))
+                        break;
+
+                    uint16_t refined0, refined1;
+                    uint32_t refinedIndices;
+                    float refinedError = QuantizeBc1(texels, quality, start, end, refined0, refined1, refinedIndices);
+                    if (refinedError >= error)
+                        break;
+
+                    error = refinedError;
+                    color0 = refined0;
+                    color1 = refined1;
+                    indices = refinedIndices;
+                }
+            }
+
+            memcpy(dest, &color0, 2);
+            memcpy(dest + 2, &color1, 2);
+            memcpy(dest + 4, &indices, 4);
+        }
+
+        // BC4 single channel block, used for the alpha of BC3 and both channels of BC5
+
+        void GetBc4Palette(uint32_t value0, uint32_t value1, uint32_t palette[8])
+        {
+            palette[0] = value0;
+            palette[1] = value1;
+            if (value0 > value1)
+            {
+                for (uint32_t i = 2; i < 8; i++)
+                    palette[i] = ((8 - i) * value0 + (i - 1) * value1) / 7;
+            }
+            else
+            {
+                for (uint32_t i = 2; i < 6; i++)
+                    palette[i] = ((6 - i) * value0 + (i - 1) * value1) / 5;
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        void EncodeBc4(const uint8_t* rgba, uint32_t channel, BcQuality quality, uint8_t* dest)
+        {
+            uint32_t minimum = 255;
+            uint32_t maximum = 0;
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                minimum = std::min(minimum, uint32_t(rgba[i * 4 + channel]));
+                maximum = std::max(maximum, uint32_t(rgba[i * 4 + channel]));
+            }
+
+            uint64_t bits = uint64_t(maximum) | (uint64_t(minimum) << 8);
+            if (maximum > minimum)
+            {
+                uint32_t palette[8];
+                GetBc4Palette(maximum, minimum, palette);
+
+                uint32_t range = maximum - minimum;
+                for (uint32_t i = 0; i < 16; i++)
+                {
+                    uint32_t value = rgba[i * 4 + channel];
+                    uint32_t index = 0;
+                    if (quality == BcQuality::High)
+                    {
+                        uint32_t bestError = 256;
+                        for (uint32_t p = 0; p < 8; p++)
+                        {
+                            uint32_t error = uint32_t(abs(int32_t(value) - int32_t(palette[p])));
+                            if (error < bestError)
+                            {
+                                bestError = error;
+                                index = p;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        // Level 0 is the minimum, 7 the maximum, the levels in between are the indices 7 down to 2
+                        uint32_t level = ((value - minimum) * 14 + range) / (2 * range);
+                        index = level == 7 ? 0 : (level == 0 ? 1 : 8 - level);
+                    }
+                    bits |= uint64_t(index) << (16 + i * 3);
+                }
+            }
+
+            memcpy(dest, &bits, 8);
+        }
+
+        // BC7 mode 6 block
+
+        const uint32_t Bc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        // Quantizes an endpoint to 7 bits per channel and a shared p-bit, choosing the p-bit with the lower error
+        void QuantizeBc7Endpoint(const float* color, uint32_t* quantized, uint32_t& pBit)
+        {
+            float bestError = 1e30f;
+            for (uint32_t p = 0; p < 2; p++)
+            {
+                uint32_t candidate[4];
+                float error = 0.0f;
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    float value = (color[c] - float(p)) * 0.5f + 0.5f;
+                    candidate[c] = uint32_t(std::min(std::max(value, 0.0f), 127.0f));
+                    float diff = float(candidate[c] * 2 + p) - color[c];
+                    error += diff * diff;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    pBit = p;
+                    memcpy(quantized, candidate, sizeof(candidate));
+                }
+            }
+        }
+
+        struct Bc7Mode6
+        {
+            uint32_t endpoints[2][4]; // 7 bits per channel
+            uint32_t pBits[2];
+            uint8_t indices[16];
+        };
+
+        void GetBc7Palette(const Bc7Mode6& block, uint32_t palette[16][4])
+        {
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                uint32_t e0 = (block.endpoints[0][c] << 1) | block.pBits[0];
+                uint32_t e1 = (block.endpoints[1][c] << 1) | block.pBits[1];
+                for (uint32_t i = 0; i < 16; i++)
+                    palette[i][c] = ((64 - Bc7Weights4[i]) * e0 + Bc7Weights4[i] * e1 + 32) >> 6;
+            }
+        }
+
+        float QuantizeBc7(const BlockTexels& texels, BcQuality quality, const float* start, const float* end, Bc7Mode6& block)
+        {
+            QuantizeBc7Endpoint(start, block.endpoints[0], block.pBits[0]);
+            QuantizeBc7Endpoint(end, block.endpoints[1], block.pBits[1]);
+
+            uint32_t palette[16][4];
+            GetBc7Palette(block, palette);
+
+            if (quality == BcQuality::High)
+            {
+                float paletteFloat[16][4];
+                for (uint32_t p = 0; p < 16; p++)
+                {
+                    for (uint32_t c = 0; c < 4; c++)
+                        paletteFloat[p][c] = float(palette[p][c]);
+                }
+                return SearchPalette<4>(texels, paletteFloat, 16, block.indices);
+            }
+
+            // The weights are close to evenly spaced
+            float from[4], to[4];
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                from[c] = float(palette[0][c]);
+                to[c] = float(palette[15][c]);
+            }
+            ProjectTexels<4>(texels, from, to, 16, block.indices);
+            return quality == BcQuality::Fast ? 0.0f : MeasurePaletteError<4>(texels, palette, block.indices);
+        }
+
+        void WriteBits(uint64_t* bits, uint32_t& position, uint32_t value, uint32_t count)
+        {
+            uint32_t word = position >> 6;
+            uint32_t shift = position & 63;
+            bits[word] |= uint64_t(value) << shift;
+            if (shift + count > 64)
+                bits[word + 1] |= uint64_t(value) >> (64 - shift);
+            position += count;
+        }
+
+        uint32_t ReadBits(const uint64_t* bits, uint32_t& position, uint32_t count)
+        {
+            uint32_t word = position >> 6;
+            uint32_t shift = position & 63;
+            uint64_t value = bits[word] >> shift;
+            if (shift + count > 64)
+                value |= bits[word + 1] << (64 - shift);
+            position += count;
+            return uint32_t(value & ((1ull << count) - 1));
+        }
+
+        void EncodeBc7(const BlockTexels& texels, BcQuality quality, uint8_t* dest)
+        {
+            float start[4], end[4];
+            FindEndpoints<4>(texels, quality, start, end);
+
+            Bc7Mode6 block;
+            float error = QuantizeBc7(texels, quality, start, end, block);
+
+            {
+                for (uint32_t iteration = 0; iteration < GetRefineIterations(quality) && error > 0.0f; iteration++)
+                {
+                    float weights[16];
+                    for (uint32_t i = 0; i < 16; i++)
+                        weights[i] = float(Bc7Weights4[block.indices[i]]) / 64.0f;
+                    if (!RefineEndpoints<4>(texels, weights, start, end))
+                        break;
+
+                    Bc7Mode6 refined;
+                    float refinedError = QuantizeBc7(texels, quality, start, end, refined);
+                    if (refinedError >= error)
+                        break;
+
+                    error = refinedError;
+                    block = refined;
+                }
+            }
+
+            // The most significant bit of the first index is implied zero, swap the endpoints if it is set
+            if (block.indices[0] >= 8)
+            {
+                for (uint32_t c = 0; c < 4; c++)
+                    std::swap(block.endpoints[0][c], block.endpoints[1][c]);
+                std::swap(block.pBits[0], block.pBits[1]);
+                for (uint32_t i = 0; i < 16; i++)
+                    block.indices[i] = uint8_t(15 - block.indices[i]);
+            }
+
+            uint64_t bits[2] = {};
+            uint32_t position = 0;
+            WriteBits(bits, position, 1u << 6, 7);
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                WriteBits(bits, position, block.endpoints[0][c], 7);
+                WriteBits(bits, position, block.endpoints[1][c], 7);
+            }
+            WriteBits(bits, position, block.pBits[0], 1);
+            WriteBits(bits, position, block.pBits[1], 1);
+            WriteBits(bits, position, block.indices[0], 3);
+            for (uint32_t i = 1; i < 16; i++)
+                WriteBits(bits, position, block.indices[i], 4);
+
+            memcpy(dest, bits, 16);
+        }
+
+        bool DecodeBc7(const uint8_t* source, uint8_t* rgba)
+        {
+            uint64_t bits[2];
+            memcpy(bits, source, 16);
+
+            uint32_t position = 0;
+            if (ReadBits(bits, position, 7) != (1u << 6))
+                return false;
+
+            Bc7Mode6 block;
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                block.endpoints[0][c] = ReadBits(bits, position, 7);
+                block.endpoints[1][c] = ReadBits(bits, position, 7);
+            }
+            block.pBits[0] = ReadBits(bits, position, 1);
+            block.pBits[1] = ReadBits(bits, position, 1);
+            block.indices[0] = uint8_t(ReadBits(bits, position, 3));
+            for (uint32_t i = 1; i < 16; i++)
+                block.indices[i] = uint8_t(ReadBits(bits, position, 4));
+
+            uint32_t palette[16][4];
+            GetBc7Palette(block, palette);
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                for (uint32_t c = 0; c < 4; c++)
+                    rgba[i * 4 + c] = uint8_t(palette[block.indices[i]][c]);
+            }
+            return true;
+        }
+
+        void DecodeBc1(const uint8_t* source, uint8_t* rgba)
+        {
+            uint16_t color0, color1;
+            uint32_t indices;
+            memcpy(&color0, source, 2);
+            memcpy(&color1, source + 2, 2);
+            memcpy(&indices, source + 4, 4);
+
+            uint32_t palette[4][4];
+            GetBc1Palette(color0, color1, palette);
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                for (uint32_t c = 0; c < 4; c++)
+                    rgba[i * 4 + c] = uint8_t(palette[(indices >> (i * 2)) & 3][c]);
+            }
+        }
+
+        void DecodeBc4(const uint8_t* source, uint8_t* rgba, uint32_t channel)
+        {
+            uint64_t bits;
+            memcpy(&bits, source, 8);
+
+            uint32_t palette[8];
+            GetBc4Palette(uint32_t(bits & 0xFF), uint32_t((bits >> 8) & 0xFF), palette);
+            for (uint32_t i = 0; i < 16; i++)
+                rgba[i * 4 + channel] = uint8_t(palette[(bits >> (16 + i * 3)) & 7]);
+        }
+    }
+
+    bool GetBcFormat(uint32_t dxgiFormat, BcFormat& format)
+    {
+        switch (dxgiFormat)
+        {
+        case 70: case 71: case 72: format = BcFormat::BC1; return true; // DXGI_FORMAT_BC1_*
+        case 76: case 77: case 78: format = BcFormat::BC3; return true; // DXGI_FORMAT_BC3_*
+        case 82: case 83: format = BcFormat::BC5; return true;          // DXGI_FORMAT_BC5_TYPELESS, BC5_UNORM
+        case 97: case 98: case 99: format = BcFormat::BC7; return true; // DXGI_FORMAT_BC7_*
+        default: return false;
+        }
+    }
+
+    uint32_t GetBcDxgiFormat(BcFormat format, bool srgb)
+    {
+        switch (format)
+        {
+        case BcFormat::BC1: return srgb ? 72 : 71;
+        case BcFormat::BC3: return srgb ? 78 : 77;
+        case BcFormat::BC5: return 83;
+        case BcFormat::BC7: return srgb ? 99 : 98;
+        default: return 0;
+        }
+    }
+
+    bool ParseBcFormat(const char* name, BcFormat& format)
+    {
+        for (uint32_t i = 0; i < uint32_t(BcFormat::Count); i++)
+        {
+            if (!strcmp(name, GetBcFormatName(BcFormat(i))))
+            {
+                format = BcFormat(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t GetBcBytesPerBlock(BcFormat format)
+    {
+        return format == BcFormat::BC1 ? 8 : 16;
+    }
+
+    const char* GetBcFormatName(BcFormat format)
+    {
+        static const char* names[] = { "bc1", "bc3", "bc5", "bc7" };
+        return format < BcFormat::Count ? names[uint32_t(format)] : "unknown";
+    }
+
+    const char* GetBcQualityName(BcQuality quality)
+    {
+        static const char* names[] = { "fast", "normal", "high" };
+        return quality < BcQuality::Count ? names[uint32_t(quality)] : "unknown";
+    }
+
+    void EncodeBcBlock(BcFormat format, BcQuality quality, const uint8_t* rgba, uint8_t* dest)
+    {
+        switch (format)
+        {
+        case BcFormat::BC1:
+        {
+            BlockTexels texels;
+            LoadBlockTexels(rgba, texels);
+            EncodeBc1Color(texels, quality, dest);
+            break;
+        }
+        case BcFormat::BC3:
+        {
+            BlockTexels texels;
+            LoadBlockTexels(rgba, texels);
+            EncodeBc4(rgba, 3, quality, dest);
+            EncodeBc1Color(texels, quality, dest + 8);
+            break;
+        }
+        case BcFormat::BC5:
+            EncodeBc4(rgba, 0, quality, dest);
+            EncodeBc4(rgba, 1, quality, dest + 8);
+            break;
+        case BcFormat::BC7:
+        {
+            BlockTexels texels;
+            LoadBlockTexels(rgba, texels);
+            EncodeBc7(texels, quality, dest);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    bool DecodeBcBlock(BcFormat format, const uint8_t* block, uint8_t* rgba)
+    {
+        switch (format)
+        {
+        case BcFormat::BC1:
+            DecodeBc1(block, rgba);
+            return true;
+        case BcFormat::BC3:
+            DecodeBc1(block + 8, rgba);
+            DecodeBc4(block, rgba, 3);
+            return true;
+        case BcFormat::BC5:
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                rgba[i * 4 + 2] = 0;
+                rgba[i * 4 + 3] = 255;
+            }
+            DecodeBc4(block, rgba, 0);
+            DecodeBc4(block + 8, rgba, 1);
+            return true;
+        case BcFormat::BC7:
+            return DecodeBc7(block, rgba);
+        default:
+            return false;
+        }
+    }
+
+    void EncodeBcImage(BcFormat format, BcQuality quality, const uint8_t* rgba, uint32_t width, uint32_t height, size_t rgbaRowPitch,
+        uint8_t* dest, size_t destRowPitch)
+    {
+        uint32_t bytesPerBlock = GetBcBytesPerBlock(format);
+        uint32_t blocksX = (width + 3) / 4;
+        uint32_t blocksY = (height + 3) / 4;
+
+        uint8_t texels[64];
+        uint8_t block[16];
+        for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+        {
+            uint8_t* destRow = dest + size_t(blockY) * destRowPitch;
+            for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+            {
+                // Partial blocks at the edges repeat the last row and column
+                for (uint32_t y = 0; y < 4; y++)
+                {
+                    uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+                    const uint8_t* sourceRow = rgba + size_t(sourceY) * rgbaRowPitch;
+                    if (blockX * 4 + 3 < width)
+                        memcpy(texels + y * 16, sourceRow + size_t(blockX) * 16, 16);
+                    else
+                    {
+                        for (uint32_t x = 0; x < 4; x++)
+                            memcpy(texels + y * 16 + x * 4, sourceRow + size_t(std::min(blockX * 4 + x, width - 1)) * 4, 4);
+                    }
+                }
+
+                EncodeBcBlock(format, quality, texels, block);
+                memcpy(destRow + size_t(blockX) * bytesPerBlock, block, bytesPerBlock);
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Encoding of RGBA8 texels to block compressed formats
+//
+// Used to transcode tiles stored in an intermediate form to the format of the texture just before upload, so the
+// encoders trade quality for speed. BC1 and BC3 use the four color mode, BC1 ignores alpha. BC7 only uses mode 6,
+// a single RGBA subset with 7 bit endpoints, shared p-bits and 4 bit indices.
+
+namespace tilestream
+{
+    enum class BcFormat : uint32_t
+    {
+        BC1,
+        BC3,
+        BC5, // Red and green channels
+        BC7,
+        Count
+    };
+
+    enum class BcQuality : uint32_t
+    {
+        Fast,   // Bounding box endpoints
+        Normal, // Principal axis endpoints refined once by least squares
+        High,   // Refined twice, palette search for indices
+        Count
+    };
+
+    // Maps the DXGI formats of BC1, BC3, BC5 and BC7, including sRGB and signed variants, false for other formats
+    bool GetBcFormat(uint32_t dxgiFormat, BcFormat& format);
+    // Returns the UNORM or sRGB DXGI format of a BC format, BC5 has no sRGB variant
+    uint32_t GetBcDxgiFormat(BcFormat format, bool srgb);
+    bool ParseBcFormat(const char* name, BcFormat& format);
+    uint32_t GetBcBytesPerBlock(BcFormat format);
+    const char* GetBcFormatName(BcFormat format);
+    const char* GetBcQualityName(BcQuality quality);
+
+    // Encodes one 4x4 block of RGBA8 texels, stored row by row
+    void EncodeBcBlock(BcFormat format, BcQuality quality, const uint8_t* rgba, uint8_t* dest);
+
+    // Decodes one block to 4x4 RGBA8 texels, BC7 blocks using other modes than 6 are not supported and return false
+    bool DecodeBcBlock(BcFormat format, const uint8_t* block, uint8_t* rgba);
+
+    // Encodes an image of width by height texels, replicating the edge texels into partial blocks.
+    // dest receives rows of blocks with destRowPitch bytes each and is written sequentially.
+    void EncodeBcImage(BcFormat format, BcQuality quality, const uint8_t* rgba, uint32_t width, uint32_t height, size_t rgbaRowPitch,
+        uint8_t* dest, size_t destRowPitch);
+}
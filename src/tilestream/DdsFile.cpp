@@ -0,0 +1,213 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "DdsFile.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace tilestream
+{
+    namespace
+    {
+        constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+        {
+            return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) | (uint32_t(uint8_t(d)) << 24);
+        }
+
+        constexpr uint32_t DdsMagic = MakeFourCC('D', 'D', 'S', ' ');
+
+        constexpr uint32_t DdsPixelFormatFourCC = 0x4;
+        constexpr uint32_t DdsCaps2Cubemap = 0x200;
+        constexpr uint32_t DdsCaps2Volume = 0x200000;
+        constexpr uint32_t DdsResourceMiscTextureCube = 0x4;
+        constexpr uint32_t DdsResourceDimensionTexture3D = 4;
+
+        struct DdsPixelFormat
+        {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t fourCC;
+            uint32_t rgbBitCount;
+            uint32_t rBitMask;
+            uint32_t gBitMask;
+            uint32_t bBitMask;
+            uint32_t aBitMask;
+        };
+
+        struct DdsHeader
+        {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t height;
+            uint32_t width;
+            uint32_t pitchOrLinearSize;
+            uint32_t depth;
+            uint32_t mipMapCount;
+            uint32_t reserved1[11];
+            DdsPixelFormat pixelFormat;
+            uint32_t caps;
+            uint32_t caps2;
+            uint32_t caps3;
+            uint32_t caps4;
+            uint32_t reserved2;
+        };
+
+        struct DdsHeaderDxt10
+        {
+            uint32_t dxgiFormat;
+            uint32_t resourceDimension;
+            uint32_t miscFlag;
+            uint32_t arraySize;
+            uint32_t miscFlags2;
+        };
+
+        static_assert(sizeof(DdsHeader) == 124, "Unexpected DDS header size");
+        static_assert(sizeof(DdsHeaderDxt10) == 20, "Unexpected DDS DX10 header size");
+
+        // Maps the legacy FourCC codes of block compressed formats to DXGI formats
+        uint32_t GetDxgiFormatFromFourCC(uint32_t fourCC)
+        {
+            switch (fourCC)
+            {
+            case MakeFourCC('D', 'X', 'T', '1'): return 71; // BC1_UNORM
+            case MakeFourCC('D', 'X', 'T', '2'):
+            case MakeFourCC('D', 'X', 'T', '3'): return 74; // BC2_UNORM
+            case MakeFourCC('D', 'X', 'T', '4'):
+            case MakeFourCC('D', 'X', 'T', '5'): return 77; // BC3_UNORM
+            case MakeFourCC('A', 'T', 'I', '1'):
+            case MakeFourCC('B', 'C', '4', 'U'): return 80; // BC4_UNORM
+            case MakeFourCC('B', 'C', '4', 'S'): return 81; // BC4_SNORM
+            case MakeFourCC('A', 'T', 'I', '2'):
+            case MakeFourCC('B', 'C', '5', 'U'): return 83; // BC5_UNORM
+            case MakeFourCC('B', 'C', '5', 'S'): return 84; // BC5_SNORM
+            default: return 0;
+            }
+        }
+    }
+
+    bool GetDxgiFormatBlockInfo(uint32_t dxgiFormat, uint32_t& blockSize, uint32_t& bytesPerBlock)
+    {
+        blockSize = 1;
+
+        if (dxgiFormat >= 1 && dxgiFormat <= 4)          // R32G32B32A32
+            bytesPerBlock = 16;
+        else if (dxgiFormat >= 5 && dxgiFormat <= 8)     // R32G32B32
+            bytesPerBlock = 12;
+        else if (dxgiFormat >= 9 && dxgiFormat <= 18)    // R16G16B16A16, R32G32
+            bytesPerBlock = 8;
+        else if (dxgiFormat >= 23 && dxgiFormat <= 43)   // R10G10B10A2, R11G11B10, R8G8B8A8, R16G16, R32
+            bytesPerBlock = 4;
+        else if (dxgiFormat >= 48 && dxgiFormat <= 59)   // R8G8, R16
+            bytesPerBlock = 2;
+        else if (dxgiFormat >= 60 && dxgiFormat <= 65)   // R8, A8
+            bytesPerBlock = 1;
+        else if (dxgiFormat >= 87 && dxgiFormat <= 93)   // B8G8R8A8, B8G8R8X8
+            bytesPerBlock = 4;
+        else if ((dxgiFormat >= 70 && dxgiFormat <= 72) || (dxgiFormat >= 79 && dxgiFormat <= 81)) // BC1, BC4
+        {
+            blockSize = 4;
+            bytesPerBlock = 8;
+        }
+        else if ((dxgiFormat >= 73 && dxgiFormat <= 78) || (dxgiFormat >= 82 && dxgiFormat <= 84) || (dxgiFormat >= 94 && dxgiFormat <= 99)) // BC2, BC3, BC5, BC6H, BC7
+        {
+            blockSize = 4;
+            bytesPerBlock = 16;
+        }
+        else
+            return false;
+
+        return true;
+    }
+
+    bool ParseDdsFile(const uint8_t* data, size_t size, DdsTextureInfo& info)
+    {
+        info = {};
+
+        if (size < sizeof(uint32_t) + sizeof(DdsHeader))
+            return false;
+
+        uint32_t magic;
+        memcpy(&magic, data, sizeof(magic));
+        if (magic != DdsMagic)
+            return false;
+
+        DdsHeader header;
+        memcpy(&header, data + sizeof(uint32_t), sizeof(header));
+        if (header.size != sizeof(DdsHeader))
+            return false;
+
+        uint64_t dataOffset = sizeof(uint32_t) + sizeof(DdsHeader);
+
+        info.width = std::max(header.width, 1u);
+        info.height = std::max(header.height, 1u);
+        info.depth = (header.caps2 & DdsCaps2Volume) ? std::max(header.depth, 1u) : 1;
+        info.mipLevels = std::max(header.mipMapCount, 1u);
+        info.isCubemap = (header.caps2 & DdsCaps2Cubemap) != 0;
+        info.arraySize = info.isCubemap ? 6 : 1;
+
+        if ((header.pixelFormat.flags & DdsPixelFormatFourCC) && header.pixelFormat.fourCC == MakeFourCC('D', 'X', '1', '0'))
+        {
+            if (size < dataOffset + sizeof(DdsHeaderDxt10))
+                return false;
+
+            DdsHeaderDxt10 headerDxt10;
+            memcpy(&headerDxt10, data + dataOffset, sizeof(headerDxt10));
+            dataOffset += sizeof(DdsHeaderDxt10);
+
+            info.dxgiFormat = headerDxt10.dxgiFormat;
+            info.isCubemap = (headerDxt10.miscFlag & DdsResourceMiscTextureCube) != 0;
+            info.arraySize = std::max(headerDxt10.arraySize, 1u) * (info.isCubemap ? 6 : 1);
+            if (headerDxt10.resourceDimension != DdsResourceDimensionTexture3D)
+                info.depth = 1;
+        }
+        else if (header.pixelFormat.flags & DdsPixelFormatFourCC)
+        {
+            info.dxgiFormat = GetDxgiFormatFromFourCC(header.pixelFormat.fourCC);
+        }
+        else if (header.pixelFormat.rgbBitCount == 32 && header.pixelFormat.rBitMask == 0x000000FF && header.pixelFormat.aBitMask == 0xFF000000)
+        {
+            info.dxgiFormat = 28; // R8G8B8A8_UNORM
+        }
+        else if (header.pixelFormat.rgbBitCount == 32 && header.pixelFormat.rBitMask == 0x00FF0000 && header.pixelFormat.aBitMask == 0xFF000000)
+        {
+            info.dxgiFormat = 87; // B8G8R8A8_UNORM
+        }
+
+        if (!GetDxgiFormatBlockInfo(info.dxgiFormat, info.blockSize, info.bytesPerBlock))
+            return false;
+
+        info.subresources.reserve(size_t(info.arraySize) * info.mipLevels);
+        for (uint32_t arraySlice = 0; arraySlice < info.arraySize; arraySlice++)
+        {
+            for (uint32_t mip = 0; mip < info.mipLevels; mip++)
+            {
+                DdsSubresourceLayout layout;
+                layout.width = std::max(info.width >> mip, 1u);
+                layout.height = std::max(info.height >> mip, 1u);
+                layout.depth = std::max(info.depth >> mip, 1u);
+
+                uint64_t blocksWide = (layout.width + info.blockSize - 1) / info.blockSize;
+                uint64_t blocksHigh = (layout.height + info.blockSize - 1) / info.blockSize;
+                layout.rowPitch = blocksWide * info.bytesPerBlock;
+                layout.slicePitch = layout.rowPitch * blocksHigh;
+                layout.sizeInBytes = layout.slicePitch * layout.depth;
+                layout.dataOffset = dataOffset;
+
+                dataOffset += layout.sizeInBytes;
+                info.subresources.push_back(layout);
+            }
+        }
+
+        return dataOffset <= size;
+    }
+}
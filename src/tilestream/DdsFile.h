@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace tilestream
+{
+    // Location of one subresource inside a DDS file
+    struct DdsSubresourceLayout
+    {
+        uint64_t dataOffset;  // Offset from the start of the file
+        uint64_t rowPitch;    // Bytes per row of blocks
+        uint64_t slicePitch;  // Bytes per depth slice
+        uint64_t sizeInBytes; // Bytes of the whole subresource
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+    };
+
+    struct DdsTextureInfo
+    {
+        uint32_t dxgiFormat;
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+        uint32_t arraySize; // Includes the 6 faces of cube maps
+        uint32_t mipLevels;
+        bool isCubemap;
+
+        uint32_t blockSize;     // Width and height of a block in texels, 1 for uncompressed formats
+        uint32_t bytesPerBlock;
+
+        // Subresources in D3D order, index = arraySlice * mipLevels + mip
+        std::vector<DdsSubresourceLayout> subresources;
+    };
+
+    // Returns the block dimensions and size of a DXGI format, false for formats without a fixed block layout
+    bool GetDxgiFormatBlockInfo(uint32_t dxgiFormat, uint32_t& blockSize, uint32_t& bytesPerBlock);
+
+    // Parses the header of a DDS file in memory and computes the layout of all subresources.
+    // Returns false if the file is not a DDS file, uses an unsupported format or is truncated.
+    bool ParseDdsFile(const uint8_t* data, size_t size, DdsTextureInfo& info);
+}
@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "File.h"
+
+#include <stdio.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tilestream
+{
+#ifdef _WIN32
+    bool ReadOnlyFile::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+        HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(fileHandle, &fileSize))
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        m_fileHandle = fileHandle;
+        m_size = uint64_t(fileSize.QuadPart);
+        return true;
+    }
+
+    void ReadOnlyFile::Close()
+    {
+        if (m_fileHandle)
+            CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+        m_size = 0;
+    }
+
+    bool ReadOnlyFile::IsOpen() const
+    {
+        return m_fileHandle != nullptr;
+    }
+
+    bool ReadOnlyFile::ReadAt(uint64_t offset, size_t size, void* dest) const
+    {
+        uint8_t* destBytes = static_cast<uint8_t*>(dest);
+        while (size > 0)
+        {
+            // ReadFile takes 32 bit sizes, the OVERLAPPED offset makes the read positional and thread safe
+            DWORD bytesToRead = DWORD(size < 0x40000000 ? size : 0x40000000);
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = DWORD(offset);
+            overlapped.OffsetHigh = DWORD(offset >> 32);
+
+            DWORD bytesRead = 0;
+            if (!ReadFile(m_fileHandle, destBytes, bytesToRead, &bytesRead, &overlapped) || bytesRead == 0)
+                return false;
+
+            destBytes += bytesRead;
+            offset += bytesRead;
+            size -= bytesRead;
+        }
+        return true;
+    }
+#else
+    bool ReadOnlyFile::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+        int fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+            return false;
+
+        struct stat fileStat = {};
+        if (fstat(fileDescriptor, &fileStat) != 0)
+        {
+            close(fileDescriptor);
+            return false;
+        }
+
+        m_fileDescriptor = fileDescriptor;
+        m_size = uint64_t(fileStat.st_size);
+        return true;
+    }
+
+    void ReadOnlyFile::Close()
+    {
+        if (m_fileDescriptor >= 0)
+            close(m_fileDescriptor);
+        m_fileDescriptor = -1;
+        m_size = 0;
+    }
+
+    bool ReadOnlyFile::IsOpen() const
+    {
+        return m_fileDescriptor >= 0;
+    }
+
+    bool ReadOnlyFile::ReadAt(uint64_t offset, size_t size, void* dest) const
+    {
+        uint8_t* destBytes = static_cast<uint8_t*>(dest);
+        while (size > 0)
+        {
+            ssize_t bytesRead = pread(m_fileDescriptor, destBytes, size, off_t(offset));
+            if (bytesRead <= 0)
+                return false;
+
+            destBytes += bytesRead;
+            offset += uint64_t(bytesRead);
+            size -= size_t(bytesRead);
+        }
+        return true;
+    }
+#endif
+
+    bool WriteWholeFile(const std::filesystem::path& path, const void* data, size_t size)
+    {
+#ifdef _WIN32
+        FILE* file = _wfopen(path.c_str(), L"wb");
+#else
+        FILE* file = fopen(path.c_str(), "wb");
+#endif
+        if (!file)
+            return false;
+
+        bool success = fwrite(data, 1, size, file) == size;
+        success = (fclose(file) == 0) && success;
+        return success;
+    }
+}
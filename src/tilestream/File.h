@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <filesystem>
+
+namespace tilestream
+{
+    // A file opened for positional reads, safe to use from multiple threads at once
+    class ReadOnlyFile
+    {
+    public:
+        ReadOnlyFile() {}
+        ~ReadOnlyFile() { Close(); }
+
+        ReadOnlyFile(const ReadOnlyFile&) = delete;
+        ReadOnlyFile& operator=(const ReadOnlyFile&) = delete;
+
+        bool Open(const std::filesystem::path& path);
+        void Close();
+
+        bool IsOpen() const;
+        uint64_t GetSize() const { return m_size; }
+
+        // Reads exactly size bytes at the given offset, returns false on errors or short reads
+        bool ReadAt(uint64_t offset, size_t size, void* dest) const;
+
+#ifdef _WIN32
+        void* GetNativeHandle() const { return m_fileHandle; }
+#else
+        int GetNativeHandle() const { return m_fileDescriptor; }
+#endif
+
+    private:
+        uint64_t m_size = 0;
+
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+#else
+        int m_fileDescriptor = -1;
+#endif
+    };
+
+    // Writes a whole file, returns false on errors
+    bool WriteWholeFile(const std::filesystem::path& path, const void* data, size_t size);
+}
@@ -0,0 +1,347 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "IoScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string.h>
+#include <thread>
+
+namespace tilestream
+{
+    bool ExecuteBatchSynchronously(const IoBatch& batch, std::vector<uint8_t>& scratch)
+    {
+        if (!batch.file)
+            return batch.requests[0]->task();
+
+        if (batch.requests.size() == 1)
+        {
+            const IoRequest* request = batch.requests[0];
+            return batch.file->ReadAt(request->offset, request->size, request->dest);
+        }
+
+        scratch.resize(size_t(batch.size));
+        if (!batch.file->ReadAt(batch.offset, scratch.size(), scratch.data()))
+            return false;
+
+        for (const IoRequest* request : batch.requests)
+            memcpy(request->dest, scratch.data() + (request->offset - batch.offset), request->size);
+
+        return true;
+    }
+
+    bool BatchNeedsPostProcess(const IoBatch& batch)
+    {
+        for (const IoRequest* request : batch.requests)
+        {
+            if (request->postProcess)
+                return true;
+        }
+        return false;
+    }
+
+    namespace
+    {
+        class ThreadPoolIoBackend : public IoBackend
+        {
+        public:
+            ThreadPoolIoBackend(IoScheduler& scheduler, uint32_t numThreads)
+                : m_scheduler(scheduler)
+            {
+                for (uint32_t i = 0; i < std::max(numThreads, 1u); i++)
+                    m_threads.emplace_back([this]() { WorkerThread(); });
+            }
+
+            ~ThreadPoolIoBackend() override
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_exit = true;
+                }
+                m_condition.notify_all();
+
+                for (std::thread& thread : m_threads)
+                    thread.join();
+            }
+
+            void Execute(IoBatch* batch) override
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_batches.push_back(batch);
+                }
+                m_condition.notify_one();
+            }
+
+            const char* GetName() const override
+            {
+                return "Thread pool";
+            }
+
+        private:
+            void WorkerThread()
+            {
+                std::vector<uint8_t> scratch;
+
+                while (true)
+                {
+                    IoBatch* batch = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_condition.wait(lock, [this]() { return m_exit || !m_batches.empty(); });
+
+                        // Drain the queue before exiting so no request is lost
+                        if (m_batches.empty())
+                            return;
+
+                        batch = m_batches.front();
+                        m_batches.pop_front();
+                    }
+
+                    // Asynchronous tasks complete their request themselves
+                    if (!batch->file && batch->requests[0]->asyncTask)
+                    {
+                        IoRequest* request = batch->requests[0];
+                        delete batch;
+                        request->asyncTask(request);
+                        continue;
+                    }
+
+                    bool success = batch->readCompleted || ExecuteBatchSynchronously(*batch, scratch);
+                    m_scheduler.CompleteBatch(batch, success);
+                }
+            }
+
+            IoScheduler& m_scheduler;
+            std::vector<std::thread> m_threads;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::deque<IoBatch*> m_batches;
+            bool m_exit = false;
+        };
+    }
+
+    std::unique_ptr<IoBackend> CreateThreadPoolIoBackend(IoScheduler& scheduler, uint32_t numThreads)
+    {
+        return std::make_unique<ThreadPoolIoBackend>(scheduler, numThreads);
+    }
+
+    IoScheduler::IoScheduler(const IoSchedulerDesc& desc)
+        : m_desc(desc)
+    {
+        if (m_desc.useIoUring)
+            m_backend = CreateIoUringBackend(*this, m_desc.ioUringQueueDepth, m_desc.maxCoalesceGap, m_desc.numThreads);
+
+        if (!m_backend)
+            m_backend = CreateThreadPoolIoBackend(*this, m_desc.numThreads);
+    }
+
+    IoScheduler::~IoScheduler()
+    {
+        CancelPending();
+        WaitIdle();
+        m_backend.reset();
+    }
+
+    void IoScheduler::Submit(IoRequest* request)
+    {
+        request->success = false;
+        request->next = nullptr;
+        m_pending.push_back(request);
+    }
+
+    void IoScheduler::Dispatch()
+    {
+        if (m_pending.empty())
+            return;
+
+        // Admit requests in submission order while under the cap, at least one so oversized requests make progress
+        size_t numAdmitted = 0;
+        uint64_t bytesAdmitted = 0;
+        while (numAdmitted < m_pending.size())
+        {
+            uint64_t size = m_pending[numAdmitted]->size;
+            if ((m_bytesInFlight > 0 || numAdmitted > 0) && m_bytesInFlight + bytesAdmitted + size > m_desc.maxBytesInFlight)
+                break;
+
+            bytesAdmitted += size;
+            numAdmitted++;
+        }
+
+        if (numAdmitted == 0)
+            return;
+
+        std::vector<IoRequest*> admitted(m_pending.begin(), m_pending.begin() + numAdmitted);
+        m_pending.erase(m_pending.begin(), m_pending.begin() + numAdmitted);
+
+        m_bytesInFlight += bytesAdmitted;
+        m_numInFlight += uint32_t(admitted.size());
+
+        // Sort file reads by location so neighbours can be merged, tasks go last
+        std::stable_sort(admitted.begin(), admitted.end(), [](const IoRequest* a, const IoRequest* b)
+        {
+            bool aIsTask = a->file == nullptr;
+            bool bIsTask = b->file == nullptr;
+            if (aIsTask != bIsTask)
+                return bIsTask;
+            if (a->file != b->file)
+                return a->file < b->file;
+            return a->offset < b->offset;
+        });
+
+        IoBatch* batch = nullptr;
+        for (IoRequest* request : admitted)
+        {
+            if (batch && request->file)
+            {
+                // Merge with the current read if the gap and the resulting read are small enough
+                uint64_t batchEnd = batch->offset + batch->size;
+                uint64_t requestEnd = request->offset + request->size;
+                bool canMerge = request->file == batch->file &&
+                    request->offset >= batch->offset &&
+                    request->offset <= batchEnd + m_desc.maxCoalesceGap &&
+                    std::max(batchEnd, requestEnd) - batch->offset <= m_desc.maxCoalescedBytes &&
+                    batch->requests.size() < m_desc.maxCoalescedRequests;
+
+                if (canMerge)
+                {
+                    batch->size = std::max(batchEnd, requestEnd) - batch->offset;
+                    batch->requests.push_back(request);
+                    m_stats.requestsCoalesced++;
+                    continue;
+                }
+            }
+
+            if (batch)
+                m_backend->Execute(batch);
+
+            batch = new IoBatch();
+            batch->file = request->file;
+            batch->offset = request->offset;
+            batch->size = request->size;
+            batch->requests.push_back(request);
+
+            if (request->file)
+                m_stats.readsIssued++;
+            else
+            {
+                // Tasks are never merged
+                m_backend->Execute(batch);
+                batch = nullptr;
+            }
+        }
+
+        if (batch)
+            m_backend->Execute(batch);
+    }
+
+    void IoScheduler::CompleteBatch(IoBatch* batch, bool success)
+    {
+        for (IoRequest* request : batch->requests)
+            CompleteRequest(request, success);
+
+        delete batch;
+    }
+
+    void IoScheduler::CompleteRequest(IoRequest* request, bool success)
+    {
+        request->success = success && (!request->postProcess || request->postProcess());
+        m_completedQueue.Push(request);
+    }
+
+    IoRequest* IoScheduler::RetireCompleted(IoRequest* completed)
+    {
+        IoRequest* tail = nullptr;
+        for (IoRequest* request = completed; request; request = request->next)
+        {
+            m_bytesInFlight -= request->size;
+            m_numInFlight--;
+
+            m_stats.requestsCompleted++;
+            if (!request->success)
+                m_stats.requestsFailed++;
+            else if (request->file)
+                m_stats.bytesRead += request->size;
+
+            tail = request;
+        }
+        return tail;
+    }
+
+    void IoScheduler::AppendCompleted(IoRequest* head, IoRequest* tail)
+    {
+        if (!head)
+            return;
+
+        if (m_completedTail)
+            m_completedTail->next = head;
+        else
+            m_completedHead = head;
+        m_completedTail = tail;
+    }
+
+    IoRequest* IoScheduler::PopCompleted()
+    {
+        IoRequest* completed = m_completedQueue.PopAll();
+        AppendCompleted(completed, RetireCompleted(completed));
+
+        completed = m_completedHead;
+        m_completedHead = nullptr;
+        m_completedTail = nullptr;
+        return completed;
+    }
+
+    void IoScheduler::CancelPending()
+    {
+        for (IoRequest* request : m_pending)
+        {
+            request->success = false;
+            request->next = nullptr;
+            AppendCompleted(request, request);
+
+            m_stats.requestsCompleted++;
+            m_stats.requestsFailed++;
+        }
+
+        m_pending.clear();
+    }
+
+    void IoScheduler::WaitIdle()
+    {
+        while (m_numInFlight > 0)
+        {
+            // Keep the completions for the next PopCompleted
+            IoRequest* completed = m_completedQueue.PopAll();
+            if (completed)
+                AppendCompleted(completed, RetireCompleted(completed));
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    const char* IoScheduler::GetBackendName() const
+    {
+        return m_backend->GetName();
+    }
+
+    IoSchedulerStats IoScheduler::GetStats() const
+    {
+        IoSchedulerStats stats = m_stats;
+        stats.bytesInFlight = m_bytesInFlight;
+        stats.requestsPending = uint32_t(m_pending.size());
+        return stats;
+    }
+}
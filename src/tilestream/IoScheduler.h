@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "File.h"
+#include "MpscQueue.h"
+
+namespace tilestream
+{
+    // A read of a file range into caller owned memory, or a task to run on a worker thread
+    struct IoRequest
+    {
+        const ReadOnlyFile* file = nullptr;
+        uint64_t offset = 0;
+        uint32_t size = 0; // Also counted against the bytes in flight for tasks
+        uint8_t* dest = nullptr;
+
+        // Runs on a worker thread instead of a file read when set, returns success
+        std::function<bool()> task;
+
+        // Starts work on a worker thread instead of a file read when set. The request stays in flight until
+        // IoScheduler::CompleteRequest is called for it, from any thread, which allows waiting on other systems.
+        std::function<void(IoRequest*)> asyncTask;
+
+        // Runs on a worker thread after the data has been read, for example to decompress it, returns success
+        std::function<bool()> postProcess;
+
+        void* userData = nullptr;
+        bool success = false;
+
+        IoRequest* next = nullptr; // Owned by the scheduler while the request is queued
+    };
+
+    struct IoSchedulerDesc
+    {
+        uint32_t numThreads = 4;
+        uint64_t maxBytesInFlight = 32ull << 20;
+        uint32_t maxCoalescedBytes = 1u << 20; // Largest read created by merging requests
+        uint32_t maxCoalesceGap = 16u << 10;   // Largest gap between merged requests, read and discarded
+        uint32_t maxCoalescedRequests = 64;
+        bool useIoUring = true;                // Linux only, falls back to the thread pool if unavailable
+        uint32_t ioUringQueueDepth = 128;
+    };
+
+    struct IoSchedulerStats
+    {
+        uint64_t requestsCompleted = 0;
+        uint64_t requestsFailed = 0;
+        uint64_t readsIssued = 0;       // File reads after coalescing
+        uint64_t requestsCoalesced = 0; // File requests merged into another read
+        uint64_t bytesRead = 0;
+        uint64_t bytesInFlight = 0;
+        uint32_t requestsPending = 0;
+    };
+
+    // A group of requests executed by one read, or a single task
+    struct IoBatch
+    {
+        const ReadOnlyFile* file = nullptr;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        std::vector<IoRequest*> requests;
+        bool readCompleted = false; // Set by backends which hand a read batch to another one for post processing
+    };
+
+    class IoBackend;
+
+    // Asynchronous reads of tile data. Requests are submitted and dispatched from one thread, which also consumes the
+    // completions. Adjacent reads of the same file are merged into larger reads, and the bytes in flight are capped.
+    // Completed requests are handed back through a lock-free queue.
+    class IoScheduler
+    {
+    public:
+        explicit IoScheduler(const IoSchedulerDesc& desc);
+        ~IoScheduler();
+
+        IoScheduler(const IoScheduler&) = delete;
+        IoScheduler& operator=(const IoScheduler&) = delete;
+
+        // Queues a request, it is issued by a later Dispatch in submission order as the bytes in flight allow
+        void Submit(IoRequest* request);
+
+        // Issues queued requests while under the bytes in flight cap, merging reads of adjacent file ranges
+        void Dispatch();
+
+        // Returns all completed requests as a list linked with next, in completion order
+        IoRequest* PopCompleted();
+
+        // Completes all requests which haven't been dispatched yet as failed
+        void CancelPending();
+
+        // Blocks until all dispatched requests have completed, they are still returned by PopCompleted
+        void WaitIdle();
+
+        bool IsIdle() const { return m_pending.empty() && m_numInFlight == 0; }
+        const char* GetBackendName() const;
+        IoSchedulerStats GetStats() const;
+
+        // Called by the backends from worker threads, runs the post processing of the requests of a successful read
+        void CompleteBatch(IoBatch* batch, bool success);
+
+        // Completes a single request, called from any thread once an asyncTask has finished
+        void CompleteRequest(IoRequest* request, bool success);
+
+    private:
+        // Updates the accounting for a list of completed requests and returns its tail
+        IoRequest* RetireCompleted(IoRequest* completed);
+        void AppendCompleted(IoRequest* head, IoRequest* tail);
+
+        IoSchedulerDesc m_desc;
+        std::unique_ptr<IoBackend> m_backend;
+
+        std::vector<IoRequest*> m_pending;
+        MpscQueue<IoRequest> m_completedQueue;
+        IoRequest* m_completedHead = nullptr; // Completions retired by WaitIdle and CancelPending, not popped yet
+        IoRequest* m_completedTail = nullptr;
+
+        uint64_t m_bytesInFlight = 0;
+        uint32_t m_numInFlight = 0;
+        IoSchedulerStats m_stats;
+    };
+
+    // Executes batches, implemented by the thread pool and io_uring backends
+    class IoBackend
+    {
+    public:
+        virtual ~IoBackend() {}
+        virtual void Execute(IoBatch* batch) = 0;
+        virtual const char* GetName() const = 0;
+    };
+
+    std::unique_ptr<IoBackend> CreateThreadPoolIoBackend(IoScheduler& scheduler, uint32_t numThreads);
+
+    // Returns nullptr if io_uring is not available on this system
+    std::unique_ptr<IoBackend> CreateIoUringBackend(IoScheduler& scheduler, uint32_t queueDepth, uint32_t maxCoalesceGap, uint32_t numTaskThreads);
+
+    // Reads a batch with positional reads, merged requests are read at once and copied to their destinations
+    bool ExecuteBatchSynchronously(const IoBatch& batch, std::vector<uint8_t>& scratch);
+
+    // Returns true if any request of the batch has post processing
+    bool BatchNeedsPostProcess(const IoBatch& batch);
+}
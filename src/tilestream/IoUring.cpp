@@ -0,0 +1,312 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+// io_uring backend of the IoScheduler, using the raw system calls so there is no dependency on liburing
+
+#include "IoScheduler.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <deque>
+#include <mutex>
+#include <thread>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define TILESTREAM_WITH_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace tilestream
+{
+#ifdef TILESTREAM_WITH_IO_URING
+    namespace
+    {
+        // A batch in flight, reading straight into the request destinations with one vectored read
+        struct IoUringRead
+        {
+            IoBatch* batch;
+            std::vector<iovec> iovecs;
+        };
+
+        class IoUringBackend : public IoBackend
+        {
+        public:
+            IoUringBackend(IoScheduler& scheduler, uint32_t maxCoalesceGap, uint32_t numTaskThreads)
+                : m_scheduler(scheduler)
+                , m_discardBuffer(std::max(maxCoalesceGap, 1u))
+                , m_taskBackend(CreateThreadPoolIoBackend(scheduler, numTaskThreads))
+            {
+            }
+
+            ~IoUringBackend() override
+            {
+                if (m_reaperThread.joinable())
+                {
+                    // The scheduler waits for all requests before destroying the backend, the NOP only wakes up the reaper
+                    {
+                        std::lock_guard<std::mutex> lock(m_submitMutex);
+                        io_uring_sqe* sqe = GetNextSqe();
+                        sqe->opcode = IORING_OP_NOP;
+                        sqe->user_data = 0;
+                        SubmitSqe();
+                    }
+                    m_reaperThread.join();
+                }
+
+                if (m_sqes)
+                    munmap(m_sqes, m_sqesSize);
+                if (m_cqRing && m_cqRing != m_sqRing)
+                    munmap(m_cqRing, m_cqRingSize);
+                if (m_sqRing)
+                    munmap(m_sqRing, m_sqRingSize);
+                if (m_ringFd >= 0)
+                    close(m_ringFd);
+            }
+
+            bool Init(uint32_t queueDepth)
+            {
+                io_uring_params params = {};
+                m_ringFd = int(syscall(__NR_io_uring_setup, std::max(queueDepth, 1u), &params));
+                if (m_ringFd < 0)
+                    return false;
+
+                m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+                m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (singleMmap)
+                    m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+                void* sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+                if (sqRing == MAP_FAILED)
+                    return false;
+                m_sqRing = static_cast<uint8_t*>(sqRing);
+
+                if (singleMmap)
+                    m_cqRing = m_sqRing;
+                else
+                {
+                    void* cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_CQ_RING);
+                    if (cqRing == MAP_FAILED)
+                        return false;
+                    m_cqRing = static_cast<uint8_t*>(cqRing);
+                }
+
+                m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+                void* sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES);
+                if (sqes == MAP_FAILED)
+                    return false;
+                m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+                m_sqTail = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.tail);
+                m_sqMask = *reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.ring_mask);
+                m_sqArray = reinterpret_cast<uint32_t*>(m_sqRing + params.sq_off.array);
+                m_cqHead = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.head);
+                m_cqTail = reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.tail);
+                m_cqMask = *reinterpret_cast<uint32_t*>(m_cqRing + params.cq_off.ring_mask);
+                m_cqes = reinterpret_cast<io_uring_cqe*>(m_cqRing + params.cq_off.cqes);
+
+                // Keep one entry for the NOP that stops the reaper
+                m_maxInFlight = params.sq_entries - 1;
+                if (m_maxInFlight == 0)
+                    return false;
+
+                m_reaperThread = std::thread([this]() { ReaperThread(); });
+                return true;
+            }
+
+            void Execute(IoBatch* batch) override
+            {
+                // Tasks and overlapping requests can't be expressed as one vectored read
+                if (!batch->file || !CanReadDirectly(*batch))
+                {
+                    m_taskBackend->Execute(batch);
+                    return;
+                }
+
+                IoUringRead* read = new IoUringRead();
+                read->batch = batch;
+
+                uint64_t cursor = batch->offset;
+                for (IoRequest* request : batch->requests)
+                {
+                    if (request->offset > cursor)
+                        read->iovecs.push_back({ m_discardBuffer.data(), size_t(request->offset - cursor) });
+                    read->iovecs.push_back({ request->dest, request->size });
+                    cursor = request->offset + request->size;
+                }
+
+                std::lock_guard<std::mutex> lock(m_submitMutex);
+                if (m_numInFlight < m_maxInFlight)
+                    SubmitRead(read);
+                else
+                    m_overflow.push_back(read);
+            }
+
+            const char* GetName() const override
+            {
+                return "io_uring";
+            }
+
+        private:
+            bool CanReadDirectly(const IoBatch& batch) const
+            {
+                uint64_t cursor = batch.offset;
+                for (const IoRequest* request : batch.requests)
+                {
+                    if (request->offset < cursor || request->offset - cursor > m_discardBuffer.size())
+                        return false;
+                    cursor = request->offset + request->size;
+                }
+                return true;
+            }
+
+            io_uring_sqe* GetNextSqe()
+            {
+                uint32_t index = *m_sqTail & m_sqMask;
+                io_uring_sqe* sqe = &m_sqes[index];
+                memset(sqe, 0, sizeof(*sqe));
+                m_sqArray[index] = index;
+                return sqe;
+            }
+
+            void SubmitSqe()
+            {
+                // Publish the entry to the kernel before entering
+                __atomic_store_n(m_sqTail, *m_sqTail + 1, __ATOMIC_RELEASE);
+                while (syscall(__NR_io_uring_enter, m_ringFd, 1, 0, 0, nullptr, 0) < 0 && errno == EINTR)
+                {
+                }
+            }
+
+            void SubmitRead(IoUringRead* read)
+            {
+                io_uring_sqe* sqe = GetNextSqe();
+                sqe->opcode = IORING_OP_READV;
+                sqe->fd = read->batch->file->GetNativeHandle();
+                sqe->addr = reinterpret_cast<uint64_t>(read->iovecs.data());
+                sqe->len = uint32_t(read->iovecs.size());
+                sqe->off = read->batch->offset;
+                sqe->user_data = reinterpret_cast<uint64_t>(read);
+
+                m_numInFlight++;
+                SubmitSqe();
+            }
+
+            void ReaperThread()
+            {
+                std::vector<uint8_t> scratch;
+                bool exit = false;
+
+                while (!exit)
+                {
+                    if (syscall(__NR_io_uring_enter, m_ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+                        break;
+
+                    // Taking the submit lock orders the submissions before their completions for the C++ memory model,
+                    // the kernel's own ordering through the ring isn't visible to tools like ThreadSanitizer
+                    uint32_t head = *m_cqHead;
+                    uint32_t tail;
+                    {
+                        std::lock_guard<std::mutex> lock(m_submitMutex);
+                        tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+                    }
+                    uint32_t numCompleted = 0;
+
+                    for (; head != tail; head++)
+                    {
+                        const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+                        IoUringRead* read = reinterpret_cast<IoUringRead*>(cqe.user_data);
+                        if (!read)
+                        {
+                            exit = true;
+                            continue;
+                        }
+
+                        // Short reads and errors are retried with plain positional reads
+                        bool success = cqe.res >= 0 && uint64_t(cqe.res) == read->batch->size;
+                        if (!success)
+                            success = ExecuteBatchSynchronously(*read->batch, scratch);
+
+                        // Post processing like decompression runs on the task threads to keep the reaper responsive
+                        if (success && BatchNeedsPostProcess(*read->batch))
+                        {
+                            read->batch->readCompleted = true;
+                            m_taskBackend->Execute(read->batch);
+                        }
+                        else
+                            m_scheduler.CompleteBatch(read->batch, success);
+                        delete read;
+                        numCompleted++;
+                    }
+
+                    __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+                    std::lock_guard<std::mutex> lock(m_submitMutex);
+                    m_numInFlight -= numCompleted;
+                    while (!m_overflow.empty() && m_numInFlight < m_maxInFlight)
+                    {
+                        SubmitRead(m_overflow.front());
+                        m_overflow.pop_front();
+                    }
+                }
+            }
+
+            IoScheduler& m_scheduler;
+            std::vector<uint8_t> m_discardBuffer;
+            std::unique_ptr<IoBackend> m_taskBackend;
+
+            int m_ringFd = -1;
+            uint8_t* m_sqRing = nullptr;
+            uint8_t* m_cqRing = nullptr;
+            size_t m_sqRingSize = 0;
+            size_t m_cqRingSize = 0;
+            io_uring_sqe* m_sqes = nullptr;
+            size_t m_sqesSize = 0;
+
+            uint32_t* m_sqTail = nullptr;
+            uint32_t m_sqMask = 0;
+            uint32_t* m_sqArray = nullptr;
+            uint32_t* m_cqHead = nullptr;
+            uint32_t* m_cqTail = nullptr;
+            uint32_t m_cqMask = 0;
+            io_uring_cqe* m_cqes = nullptr;
+
+            std::mutex m_submitMutex;
+            uint32_t m_numInFlight = 0;
+            uint32_t m_maxInFlight = 0;
+            std::deque<IoUringRead*> m_overflow;
+            std::thread m_reaperThread;
+        };
+    }
+
+    std::unique_ptr<IoBackend> CreateIoUringBackend(IoScheduler& scheduler, uint32_t queueDepth, uint32_t maxCoalesceGap, uint32_t numTaskThreads)
+    {
+        auto backend = std::make_unique<IoUringBackend>(scheduler, maxCoalesceGap, numTaskThreads);
+        if (!backend->Init(queueDepth))
+            return nullptr;
+
+        return backend;
+    }
+#else
+    std::unique_ptr<IoBackend> CreateIoUringBackend(IoScheduler&, uint32_t, uint32_t, uint32_t)
+    {
+        return nullptr;
+    }
+#endif
+}
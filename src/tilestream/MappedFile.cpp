@@ -0,0 +1,123 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tilestream
+{
+#ifdef _WIN32
+    bool MappedFile::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+        HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle)
+        {
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!data)
+        {
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        m_fileHandle = fileHandle;
+        m_mappingHandle = mappingHandle;
+        m_data = static_cast<const uint8_t*>(data);
+        m_size = uint64_t(fileSize.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        if (m_mappingHandle)
+            CloseHandle(m_mappingHandle);
+        if (m_fileHandle)
+            CloseHandle(m_fileHandle);
+
+        m_data = nullptr;
+        m_size = 0;
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+    }
+#else
+    bool MappedFile::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+        int fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+            return false;
+
+        struct stat fileStat = {};
+        if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(fileDescriptor);
+            return false;
+        }
+
+        void* data = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fileDescriptor);
+            return false;
+        }
+
+        // Tiles are read in a scattered order, read-ahead of whole files is mostly wasted
+        madvise(data, size_t(fileStat.st_size), MADV_RANDOM);
+
+        m_fileDescriptor = fileDescriptor;
+        m_data = static_cast<const uint8_t*>(data);
+        m_size = uint64_t(fileStat.st_size);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data)
+            munmap(const_cast<uint8_t*>(m_data), size_t(m_size));
+        if (m_fileDescriptor >= 0)
+            close(m_fileDescriptor);
+
+        m_data = nullptr;
+        m_size = 0;
+        m_fileDescriptor = -1;
+    }
+#endif
+}
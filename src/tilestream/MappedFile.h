@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <filesystem>
+
+namespace tilestream
+{
+    // A read-only memory mapping of a whole file. Pages are only read from disk when they are touched.
+    class MappedFile
+    {
+    public:
+        MappedFile() {}
+        ~MappedFile() { Close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::filesystem::path& path);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        const uint8_t* GetData() const { return m_data; }
+        uint64_t GetSize() const { return m_size; }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        uint64_t m_size = 0;
+
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#else
+        int m_fileDescriptor = -1;
+#endif
+    };
+}
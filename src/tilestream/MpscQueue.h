@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <atomic>
+
+namespace tilestream
+{
+    // Lock-free multi producer, single consumer queue of intrusive nodes. T needs a "T* next" member.
+    // Producers push with one compare-exchange, the consumer takes everything at once and restores FIFO order.
+    template <typename T>
+    class MpscQueue
+    {
+    public:
+        void Push(T* node)
+        {
+            T* head = m_head.load(std::memory_order_relaxed);
+            do
+            {
+                node->next = head;
+            } while (!m_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Returns all queued nodes as a list linked with next, oldest first
+        T* PopAll()
+        {
+            T* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+            T* reversed = nullptr;
+            while (node)
+            {
+                T* next = node->next;
+                node->next = reversed;
+                reversed = node;
+                node = next;
+            }
+            return reversed;
+        }
+
+        bool IsEmpty() const
+        {
+            return m_head.load(std::memory_order_relaxed) == nullptr;
+        }
+
+    private:
+        std::atomic<T*> m_head = nullptr;
+    };
+}
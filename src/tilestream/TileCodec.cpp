@@ -0,0 +1,621 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "TileCodec.h"
+
+#include <algorithm>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TILESTREAM_WITH_SSE2 1
+#endif
+
+#ifdef TILESTREAM_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef TILESTREAM_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace tilestream
+{
+    namespace
+    {
+        // LZ4 block format: sequences of a token, literals, a 16 bit match offset and extra length bytes
+        constexpr size_t LzMinMatch = 4;
+        constexpr size_t LzLastLiterals = 5;    // The last bytes of a block are always literals
+        constexpr size_t LzMatchFindLimit = 12; // The last match starts at least this far before the end of a block
+        constexpr size_t LzMaxOffset = 65535;
+        constexpr uint32_t LzHashBits = 14;
+        constexpr int LzDefaultLevel = 6;
+
+        uint32_t Read32(const uint8_t* data)
+        {
+            uint32_t value;
+            memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        uint64_t Read64(const uint8_t* data)
+        {
+            uint64_t value;
+            memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        uint64_t RotateLeft64(uint64_t value, int bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        // Content hash in the style of XXH64, four independent lanes keep the multipliers busy
+        constexpr uint64_t HashPrime1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t HashPrime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t HashPrime3 = 0x165667B19E3779F9ull;
+
+        uint64_t HashRound(uint64_t accumulator, uint64_t value)
+        {
+            accumulator += value * HashPrime2;
+            return RotateLeft64(accumulator, 31) * HashPrime1;
+        }
+
+        uint32_t LzHash(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - LzHashBits);
+        }
+
+        size_t LzCompressBound(size_t size)
+        {
+            return size + size / 255 + 16;
+        }
+
+        uint8_t* LzWriteLength(uint8_t* output, size_t length)
+        {
+            for (; length >= 255; length -= 255)
+                *output++ = 255;
+            *output++ = uint8_t(length);
+            return output;
+        }
+
+        // Writes one sequence, the last sequence of a block has literals only and a match length of zero
+        uint8_t* LzWriteSequence(uint8_t* output, const uint8_t* literals, size_t numLiterals, size_t offset, size_t matchLength)
+        {
+            uint8_t* token = output++;
+            *token = uint8_t(std::min<size_t>(numLiterals, 15) << 4);
+            if (numLiterals >= 15)
+                output = LzWriteLength(output, numLiterals - 15);
+            memcpy(output, literals, numLiterals);
+            output += numLiterals;
+
+            if (matchLength == 0)
+                return output;
+
+            *output++ = uint8_t(offset);
+            *output++ = uint8_t(offset >> 8);
+            size_t length = matchLength - LzMinMatch;
+            *token |= uint8_t(std::min<size_t>(length, 15));
+            if (length >= 15)
+                output = LzWriteLength(output, length - 15);
+            return output;
+        }
+
+        // Greedy compressor, levels above 1 follow hash chains of up to 2^(level-1) candidates for longer matches
+        size_t LzCompress(const uint8_t* data, size_t size, uint8_t* output, int level)
+        {
+            uint8_t* outputStart = output;
+            size_t anchor = 0;
+
+            if (size > LzMatchFindLimit)
+            {
+                uint32_t maxCandidates = level <= 1 ? 1u : 1u << std::min(level - 1, 10);
+                std::vector<int32_t> head(size_t(1) << LzHashBits, -1);
+                std::vector<int32_t> chain(maxCandidates > 1 ? size : 0);
+                size_t matchLimit = size - LzLastLiterals;
+
+                auto insert = [&](size_t position)
+                {
+                    uint32_t hash = LzHash(Read32(data + position));
+                    if (!chain.empty())
+                        chain[position] = head[hash];
+                    head[hash] = int32_t(position);
+                };
+
+                size_t position = 0;
+                while (position + LzMatchFindLimit <= size)
+                {
+                    uint32_t sequence = Read32(data + position);
+                    int32_t candidate = head[LzHash(sequence)];
+                    insert(position);
+
+                    size_t bestLength = 0;
+                    size_t bestOffset = 0;
+                    for (uint32_t i = 0; i < maxCandidates && candidate >= 0 && position - size_t(candidate) <= LzMaxOffset; i++)
+                    {
+                        if (Read32(data + candidate) == sequence)
+                        {
+                            size_t length = LzMinMatch;
+                            while (position + length < matchLimit && data[candidate + length] == data[position + length])
+                                length++;
+                            if (length > bestLength)
+                            {
+                                bestLength = length;
+                                bestOffset = position - size_t(candidate);
+                            }
+                        }
+
+                        if (chain.empty())
+                            break;
+                        candidate = chain[candidate];
+                    }
+
+                    if (bestLength == 0)
+                    {
+                        // Skip ahead faster through incompressible data in the fast mode
+                        position += (maxCandidates == 1) ? 1 + ((position - anchor) >> 6) : 1;
+                        continue;
+                    }
+
+                    output = LzWriteSequence(output, data + anchor, position - anchor, bestOffset, bestLength);
+
+                    size_t matchEnd = position + bestLength;
+                    for (position++; position < matchEnd && position + LzMatchFindLimit <= size; position++)
+                        insert(position);
+                    position = matchEnd;
+                    anchor = matchEnd;
+                }
+            }
+
+            output = LzWriteSequence(output, data + anchor, size - anchor, 0, 0);
+            return size_t(output - outputStart);
+        }
+
+        bool LzReadLength(const uint8_t*& input, const uint8_t* inputEnd, size_t& length)
+        {
+            uint8_t value;
+            do
+            {
+                if (input >= inputEnd)
+                    return false;
+                value = *input++;
+                length += value;
+            } while (value == 255);
+            return true;
+        }
+
+        bool LzDecompress(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize)
+        {
+            const uint8_t* inputEnd = input + inputSize;
+            uint8_t* outputStart = output;
+            uint8_t* outputEnd = output + outputSize;
+
+            while (input < inputEnd)
+            {
+                uint8_t token = *input++;
+
+                size_t numLiterals = token >> 4;
+                if (numLiterals == 15 && !LzReadLength(input, inputEnd, numLiterals))
+                    return false;
+                if (size_t(inputEnd - input) < numLiterals || size_t(outputEnd - output) < numLiterals)
+                    return false;
+
+                // Short runs are copied with a fixed size when there is room, the extra bytes are overwritten later
+                if (numLiterals <= 16 && inputEnd - input >= 16 && outputEnd - output >= 16)
+                    memcpy(output, input, 16);
+                else
+                    memcpy(output, input, numLiterals);
+                input += numLiterals;
+                output += numLiterals;
+
+                // The last sequence ends after its literals
+                if (input == inputEnd)
+                    break;
+
+                if (inputEnd - input < 2)
+                    return false;
+                size_t offset = size_t(input[0]) | (size_t(input[1]) << 8);
+                input += 2;
+
+                size_t matchLength = token & 15;
+                if (matchLength == 15 && !LzReadLength(input, inputEnd, matchLength))
+                    return false;
+                matchLength += LzMinMatch;
+
+                if (offset == 0 || offset > size_t(output - outputStart) || size_t(outputEnd - output) < matchLength)
+                    return false;
+
+                const uint8_t* match = output - offset;
+                if (offset >= 8 && size_t(outputEnd - output) >= matchLength + 8)
+                {
+                    // Copy in steps of 8 bytes, each step only reads bytes written before
+                    uint8_t* matchEnd = output + matchLength;
+                    for (; output < matchEnd; output += 8, match += 8)
+                        memcpy(output, match, 8);
+                    output = matchEnd;
+                    continue;
+                }
+                else if (offset >= matchLength)
+                    memcpy(output, match, matchLength);
+                else
+                {
+                    // Overlapping matches repeat the last offset bytes
+                    for (size_t i = 0; i < matchLength; i++)
+                        output[i] = match[i];
+                }
+                output += matchLength;
+            }
+
+            return output == outputEnd;
+        }
+
+        // Groups byte i of every element together, trailing bytes which don't fill an element are kept in place
+        void ShuffleBytes(const uint8_t* data, size_t size, uint32_t elementSize, uint8_t* output)
+        {
+            size_t numElements = size / elementSize;
+            for (uint32_t byte = 0; byte < elementSize; byte++)
+                for (size_t element = 0; element < numElements; element++)
+                    output[byte * numElements + element] = data[element * elementSize + byte];
+
+            size_t shuffledSize = numElements * elementSize;
+            memcpy(output + shuffledSize, data + shuffledSize, size - shuffledSize);
+        }
+
+        // Transposes a matrix of 8x8 bytes held in 8 rows, by swapping ever larger blocks across the diagonal
+        void TransposeBytes8x8(uint64_t* rows)
+        {
+            for (uint32_t i = 0; i < 8; i += 2)
+            {
+                uint64_t swap = ((rows[i] >> 8) ^ rows[i + 1]) & 0x00FF00FF00FF00FFull;
+                rows[i + 1] ^= swap;
+                rows[i] ^= swap << 8;
+            }
+            for (uint32_t i : { 0u, 1u, 4u, 5u })
+            {
+                uint64_t swap = ((rows[i] >> 16) ^ rows[i + 2]) & 0x0000FFFF0000FFFFull;
+                rows[i + 2] ^= swap;
+                rows[i] ^= swap << 16;
+            }
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                uint64_t swap = ((rows[i] >> 32) ^ rows[i + 4]) & 0x00000000FFFFFFFFull;
+                rows[i + 4] ^= swap;
+                rows[i] ^= swap << 32;
+            }
+        }
+
+        // Reverses ShuffleBytes, writing the output sequentially
+        void UnshuffleBytes(const uint8_t* data, size_t size, uint32_t elementSize, uint8_t* output)
+        {
+            size_t numElements = size / elementSize;
+            size_t element = 0;
+
+#ifdef TILESTREAM_WITH_SSE2
+            // BC blocks are reassembled 16 at a time by interleaving ever larger units of the byte streams
+            if (elementSize == 8 || elementSize == 16)
+            {
+                for (; element + 16 <= numElements; element += 16)
+                {
+                    __m128i x[16];
+                    __m128i y[16];
+                    for (uint32_t byte = 0; byte < elementSize; byte++)
+                        x[byte] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + byte * numElements + element));
+
+                    if (elementSize == 16)
+                    {
+                        for (uint32_t i = 0; i < 8; i++)
+                        {
+                            y[i] = _mm_unpacklo_epi8(x[2 * i], x[2 * i + 1]);
+                            y[i + 8] = _mm_unpackhi_epi8(x[2 * i], x[2 * i + 1]);
+                        }
+                        for (uint32_t half = 0; half < 16; half += 8)
+                        {
+                            for (uint32_t i = 0; i < 4; i++)
+                            {
+                                x[half + i] = _mm_unpacklo_epi16(y[half + 2 * i], y[half + 2 * i + 1]);
+                                x[half + i + 4] = _mm_unpackhi_epi16(y[half + 2 * i], y[half + 2 * i + 1]);
+                            }
+                        }
+                        for (uint32_t quarter = 0; quarter < 16; quarter += 4)
+                        {
+                            for (uint32_t i = 0; i < 2; i++)
+                            {
+                                y[quarter + i] = _mm_unpacklo_epi32(x[quarter + 2 * i], x[quarter + 2 * i + 1]);
+                                y[quarter + i + 2] = _mm_unpackhi_epi32(x[quarter + 2 * i], x[quarter + 2 * i + 1]);
+                            }
+                        }
+                        for (uint32_t i = 0; i < 16; i += 2)
+                        {
+                            x[i] = _mm_unpacklo_epi64(y[i], y[i + 1]);
+                            x[i + 1] = _mm_unpackhi_epi64(y[i], y[i + 1]);
+                        }
+                    }
+                    else
+                    {
+                        for (uint32_t i = 0; i < 4; i++)
+                        {
+                            y[i] = _mm_unpacklo_epi8(x[2 * i], x[2 * i + 1]);
+                            y[i + 4] = _mm_unpackhi_epi8(x[2 * i], x[2 * i + 1]);
+                        }
+                        for (uint32_t half = 0; half < 8; half += 4)
+                        {
+                            for (uint32_t i = 0; i < 2; i++)
+                            {
+                                x[half + i] = _mm_unpacklo_epi16(y[half + 2 * i], y[half + 2 * i + 1]);
+                                x[half + i + 2] = _mm_unpackhi_epi16(y[half + 2 * i], y[half + 2 * i + 1]);
+                            }
+                        }
+                        for (uint32_t i = 0; i < 8; i += 2)
+                        {
+                            y[i] = _mm_unpacklo_epi32(x[i], x[i + 1]);
+                            y[i + 1] = _mm_unpackhi_epi32(x[i], x[i + 1]);
+                        }
+                        for (uint32_t i = 0; i < 8; i++)
+                            x[i] = y[i];
+                    }
+
+                    for (uint32_t i = 0; i < elementSize; i++)
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 16), x[i]);
+                    output += 16 * elementSize;
+                }
+            }
+#endif
+
+            // Elements made of 8 byte groups are reassembled 8 elements at a time with 8x8 transposes
+            if (elementSize % 8 == 0 && elementSize <= 16)
+            {
+                uint64_t elements[16];
+                for (; element + 8 <= numElements; element += 8)
+                {
+                    for (uint32_t group = 0; group < elementSize / 8; group++)
+                    {
+                        uint64_t rows[8];
+                        for (uint32_t byte = 0; byte < 8; byte++)
+                            memcpy(&rows[byte], data + (group * 8 + byte) * numElements + element, sizeof(uint64_t));
+
+                        TransposeBytes8x8(rows);
+                        for (uint32_t i = 0; i < 8; i++)
+                            elements[i * (elementSize / 8) + group] = rows[i];
+                    }
+
+                    memcpy(output, elements, 8 * elementSize);
+                    output += 8 * elementSize;
+                }
+            }
+
+            for (; element < numElements; element++)
+                for (uint32_t byte = 0; byte < elementSize; byte++)
+                    *output++ = data[byte * numElements + element];
+
+            size_t shuffledSize = numElements * elementSize;
+            memcpy(output, data + shuffledSize, size - shuffledSize);
+        }
+
+        // Returns the compressed size, or 0 if the codec failed or the data didn't fit into capacity
+        size_t Compress(TileCodec codec, int level, const uint8_t* data, size_t size, uint8_t* output, size_t capacity)
+        {
+            switch (codec)
+            {
+            case TileCodec::Lz4:
+                if (capacity < LzCompressBound(size))
+                    return 0;
+                return LzCompress(data, size, output, level > 0 ? level : LzDefaultLevel);
+#ifdef TILESTREAM_WITH_ZLIB
+            case TileCodec::Deflate:
+            {
+                uLongf outputSize = uLongf(capacity);
+                if (compress2(output, &outputSize, data, uLong(size), level > 0 ? level : 9) != Z_OK)
+                    return 0;
+                return size_t(outputSize);
+            }
+#endif
+#ifdef TILESTREAM_WITH_ZSTD
+            case TileCodec::Zstd:
+            {
+                size_t outputSize = ZSTD_compress(output, capacity, data, size, level > 0 ? level : 12);
+                return ZSTD_isError(outputSize) ? 0 : outputSize;
+            }
+#endif
+            default:
+                return 0;
+            }
+        }
+
+        size_t GetCompressBound(TileCodec codec, size_t size)
+        {
+            switch (codec)
+            {
+#ifdef TILESTREAM_WITH_ZLIB
+            case TileCodec::Deflate:
+                return size_t(compressBound(uLong(size)));
+#endif
+#ifdef TILESTREAM_WITH_ZSTD
+            case TileCodec::Zstd:
+                return ZSTD_compressBound(size);
+#endif
+            default:
+                return LzCompressBound(size);
+            }
+        }
+
+        bool Decompress(TileCodec codec, const uint8_t* data, size_t storedSize, uint8_t* output, size_t size)
+        {
+            switch (codec)
+            {
+            case TileCodec::Lz4:
+                return LzDecompress(data, storedSize, output, size);
+#ifdef TILESTREAM_WITH_ZLIB
+            case TileCodec::Deflate:
+            {
+                uLongf outputSize = uLongf(size);
+                return uncompress(output, &outputSize, data, uLong(storedSize)) == Z_OK && outputSize == size;
+            }
+#endif
+#ifdef TILESTREAM_WITH_ZSTD
+            case TileCodec::Zstd:
+                return ZSTD_decompress(output, size, data, storedSize) == size;
+#endif
+            default:
+                return false;
+            }
+        }
+    }
+
+    bool IsTileCodecAvailable(TileCodec codec)
+    {
+        switch (codec)
+        {
+        case TileCodec::None:
+        case TileCodec::Lz4:
+            return true;
+#ifdef TILESTREAM_WITH_ZLIB
+        case TileCodec::Deflate:
+            return true;
+#endif
+#ifdef TILESTREAM_WITH_ZSTD
+        case TileCodec::Zstd:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    const char* GetTileCodecName(TileCodec codec)
+    {
+        switch (codec)
+        {
+        case TileCodec::None: return "none";
+        case TileCodec::Lz4: return "lz4";
+        case TileCodec::Deflate: return "deflate";
+        case TileCodec::Zstd: return "zstd";
+        default: return "unknown";
+        }
+    }
+
+    bool ParseTileCodec(const char* name, TileCodec& codec)
+    {
+        for (uint32_t i = 0; i < uint32_t(TileCodec::Count); i++)
+        {
+            if (!strcmp(name, GetTileCodecName(TileCodec(i))))
+            {
+                codec = TileCodec(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t EncodeTile(const TileEncoderDesc& desc, uint32_t elementSize, const uint8_t* data, size_t size, std::vector<uint8_t>& output)
+    {
+        output.clear();
+
+        if (desc.codec != TileCodec::None && IsTileCodecAvailable(desc.codec) && size > 0)
+        {
+            std::vector<uint8_t> shuffled;
+            bool shuffle = desc.shuffle && elementSize > 1;
+            if (shuffle)
+            {
+                shuffled.resize(size);
+                ShuffleBytes(data, size, elementSize, shuffled.data());
+            }
+
+            output.resize(GetCompressBound(desc.codec, size));
+            size_t compressedSize = Compress(desc.codec, desc.level, shuffle ? shuffled.data() : data, size, output.data(), output.size());
+            if (compressedSize > 0 && compressedSize < size)
+            {
+                output.resize(compressedSize);
+                return uint32_t(desc.codec) | (shuffle ? TileFlagShuffled : 0);
+            }
+        }
+
+        output.assign(data, data + size);
+        return 0;
+    }
+
+    bool IsUniformData(const uint8_t* data, size_t size, uint32_t elementSize)
+    {
+        if (elementSize == 0 || size < elementSize || size % elementSize != 0)
+            return false;
+
+        // Every element equals the one before it
+        return memcmp(data, data + elementSize, size - elementSize) == 0;
+    }
+
+    bool DecodeTile(uint32_t flags, uint32_t elementSize, const uint8_t* data, size_t storedSize, uint8_t* dest, size_t size)
+    {
+        TileCodec codec = TileCodec(flags & TileFlagCodecMask);
+        bool shuffled = (flags & TileFlagShuffled) != 0;
+        if ((shuffled && elementSize == 0) || (flags & TileFlagTranscode) != 0)
+            return false;
+
+        if (flags & TileFlagUniform)
+        {
+            if (storedSize == 0 || size % storedSize != 0)
+                return false;
+            for (size_t offset = 0; offset < size; offset += storedSize)
+                memcpy(dest + offset, data, storedSize);
+            return true;
+        }
+
+        if (codec == TileCodec::None)
+        {
+            if (storedSize != size)
+                return false;
+            if (shuffled)
+                UnshuffleBytes(data, size, elementSize, dest);
+            else
+                memcpy(dest, data, size);
+            return true;
+        }
+
+        // Decoders read back their output to copy matches, which is very slow from write combined memory,
+        // so tiles are decoded into cached memory first and then written to dest in one pass
+        thread_local std::vector<uint8_t> scratch;
+        scratch.resize(size);
+        if (!Decompress(codec, data, storedSize, scratch.data(), size))
+            return false;
+
+        if (shuffled)
+            UnshuffleBytes(scratch.data(), size, elementSize, dest);
+        else
+            memcpy(dest, scratch.data(), size);
+
+        return true;
+    }
+
+    uint64_t HashTileData(const uint8_t* data, size_t size, uint64_t seed)
+    {
+        uint64_t lanes[4] = { seed + HashPrime1 + HashPrime2, seed + HashPrime2, seed, seed - HashPrime1 };
+        size_t position = 0;
+        for (; position + 32 <= size; position += 32)
+        {
+            for (uint32_t lane = 0; lane < 4; lane++)
+                lanes[lane] = HashRound(lanes[lane], Read64(data + position + lane * 8));
+        }
+
+        uint64_t hash = RotateLeft64(lanes[0], 1) + RotateLeft64(lanes[1], 7) + RotateLeft64(lanes[2], 12) + RotateLeft64(lanes[3], 18);
+        hash += uint64_t(size);
+
+        for (; position + 8 <= size; position += 8)
+            hash = RotateLeft64(hash ^ HashRound(0, Read64(data + position)), 27) * HashPrime1 + HashPrime3;
+        for (; position < size; position++)
+            hash = RotateLeft64(hash ^ (data[position] * HashPrime3), 11) * HashPrime1;
+
+        hash ^= hash >> 33;
+        hash *= HashPrime2;
+        hash ^= hash >> 29;
+        hash *= HashPrime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
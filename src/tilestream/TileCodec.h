@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// Compression of stored tiles and packed mips
+//
+// Every stored tile carries its own flags, so each tile is decoded on its own and tiles which don't compress are kept
+// as they are. The low byte of the flags is the codec, TileFlagShuffled marks tiles whose bytes were grouped by their
+// position in a block before compression, which exposes the similar endpoint bytes of BC blocks to the codec.
+
+namespace tilestream
+{
+    enum class TileCodec : uint32_t
+    {
+        None = 0,
+        Lz4 = 1,     // Built in encoder and decoder of the LZ4 block format, always available
+        Deflate = 2, // zlib, available when built with TILESTREAM_WITH_ZLIB
+        Zstd = 3,    // zstd, available when built with TILESTREAM_WITH_ZSTD
+        Count
+    };
+
+    constexpr uint32_t TileFlagCodecMask = 0xFF;
+    constexpr uint32_t TileFlagShuffled = 0x100;
+    constexpr uint32_t TileFlagTranscode = 0x200; // Intermediate texels encoded to BCn when loaded, see TileTranscoder.h
+    constexpr uint32_t TileFlagUniform = 0x400;   // The tile repeats one block, which is stored on its own
+
+    struct TileEncoderDesc
+    {
+        TileCodec codec = TileCodec::Lz4;
+        int level = 0;       // Codec specific, 0 uses the default of the codec
+        bool shuffle = true; // Group bytes by their position in a block before compressing
+    };
+
+    bool IsTileCodecAvailable(TileCodec codec);
+    const char* GetTileCodecName(TileCodec codec);
+    bool ParseTileCodec(const char* name, TileCodec& codec);
+
+    // Compresses a tile to output and returns its flags. Tiles which don't get smaller are stored as they are,
+    // with zero flags. elementSize is the size of a block, used by the shuffle.
+    uint32_t EncodeTile(const TileEncoderDesc& desc, uint32_t elementSize, const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+
+    // Returns true if data is one element repeated, tiles like that are stored as the element with TileFlagUniform
+    bool IsUniformData(const uint8_t* data, size_t size, uint32_t elementSize);
+
+    // Decodes a stored tile into dest, size must be the size of the tile before encoding. dest is written once and
+    // sequentially, so it may point to write combined upload memory.
+    bool DecodeTile(uint32_t flags, uint32_t elementSize, const uint8_t* data, size_t storedSize, uint8_t* dest, size_t size);
+
+    // 64 bit hash of the contents of a tile, tiles with equal hashes are treated as identical.
+    // The seed separates data which must not match across different encodings.
+    uint64_t HashTileData(const uint8_t* data, size_t size, uint64_t seed = 0);
+}
@@ -0,0 +1,296 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "TilePack.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace tilestream
+{
+    bool GetStandardTileShape(uint32_t blockSize, uint32_t bytesPerBlock, uint32_t& widthInTexels, uint32_t& heightInTexels)
+    {
+        // Standard swizzle 64 KiB tiles are square for 8, 32 and 128 bit elements and twice as wide as high otherwise
+        uint32_t widthInBlocks = 0;
+        uint32_t heightInBlocks = 0;
+        switch (bytesPerBlock)
+        {
+        case 1: widthInBlocks = 256; heightInBlocks = 256; break;
+        case 2: widthInBlocks = 256; heightInBlocks = 128; break;
+        case 4: widthInBlocks = 128; heightInBlocks = 128; break;
+        case 8: widthInBlocks = 128; heightInBlocks = 64; break;
+        case 16: widthInBlocks = 64; heightInBlocks = 64; break;
+        default: break;
+        }
+
+        widthInTexels = widthInBlocks * blockSize;
+        heightInTexels = heightInBlocks * blockSize;
+        return widthInBlocks != 0;
+    }
+
+    void CopyBlockRect(const uint8_t* source, uint64_t sourceRowPitch, uint32_t sourceBlockX, uint32_t sourceBlockY,
+        uint8_t* dest, uint64_t destRowPitch, uint32_t destBlockX, uint32_t destBlockY,
+        uint32_t widthInBlocks, uint32_t heightInBlocks, uint32_t bytesPerBlock)
+    {
+        const uint8_t* sourceRow = source + sourceBlockY * sourceRowPitch + uint64_t(sourceBlockX) * bytesPerBlock;
+        uint8_t* destRow = dest + destBlockY * destRowPitch + uint64_t(destBlockX) * bytesPerBlock;
+        size_t rowBytes = size_t(widthInBlocks) * bytesPerBlock;
+
+        for (uint32_t row = 0; row < heightInBlocks; row++)
+        {
+            memcpy(destRow, sourceRow, rowBytes);
+            sourceRow += sourceRowPitch;
+            destRow += destRowPitch;
+        }
+    }
+
+    bool TilePackReader::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+        if (!m_file.Open(path))
+            return false;
+
+        if (!m_file.ReadAt(0, sizeof(m_header), &m_header) || m_header.magic != TilePackMagic || m_header.version != TilePackVersion)
+        {
+            Close();
+            return false;
+        }
+
+        uint32_t blockSize, bytesPerBlock;
+        bool validHeader = GetDxgiFormatBlockInfo(m_header.dxgiFormat, blockSize, bytesPerBlock) &&
+            blockSize == m_header.blockSize && bytesPerBlock == m_header.bytesPerBlock &&
+            m_header.arraySize > 0 && m_header.mipLevels > 0 && m_header.numStandardMips <= m_header.mipLevels &&
+            m_header.tileWidthInTexels > 0 && m_header.tileHeightInTexels > 0 &&
+            IsTileCodecAvailable(TileCodec(m_header.codec));
+        if (!validHeader)
+        {
+            Close();
+            return false;
+        }
+
+        m_subresources.resize(size_t(m_header.arraySize) * m_header.mipLevels);
+        m_tiles.resize(m_header.numTiles);
+        if (!m_file.ReadAt(m_header.subresourceTableOffset, m_subresources.size() * sizeof(TilePackSubresource), m_subresources.data()) ||
+            !m_file.ReadAt(m_header.tileTableOffset, m_tiles.size() * sizeof(TilePackTileEntry), m_tiles.data()))
+        {
+            Close();
+            return false;
+        }
+
+        for (const TilePackSubresource& subresource : m_subresources)
+        {
+            if (uint64_t(subresource.firstTile) + uint64_t(subresource.widthInTiles) * subresource.heightInTiles > m_tiles.size())
+            {
+                Close();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void TilePackReader::Close()
+    {
+        m_file.Close();
+        m_header = {};
+        m_subresources.clear();
+        m_tiles.clear();
+    }
+
+    const TilePackSubresource& TilePackReader::GetSubresource(uint32_t arraySlice, uint32_t mip) const
+    {
+        return m_subresources[size_t(arraySlice) * m_header.mipLevels + mip];
+    }
+
+    const TilePackTileEntry* TilePackReader::GetTile(uint32_t arraySlice, uint32_t mip, uint32_t tileX, uint32_t tileY) const
+    {
+        const TilePackSubresource& subresource = GetSubresource(arraySlice, mip);
+        if (tileX >= subresource.widthInTiles || tileY >= subresource.heightInTiles)
+            return nullptr;
+
+        return &m_tiles[subresource.firstTile + tileY * subresource.widthInTiles + tileX];
+    }
+
+    TileRegion TilePackReader::GetTileRegion(uint32_t arraySlice, uint32_t mip, uint32_t tileX, uint32_t tileY) const
+    {
+        const TilePackSubresource& subresource = GetSubresource(arraySlice, mip);
+        uint32_t blockSize = m_header.blockSize;
+        uint32_t alignedWidth = ((subresource.width + blockSize - 1) / blockSize) * blockSize;
+        uint32_t alignedHeight = ((subresource.height + blockSize - 1) / blockSize) * blockSize;
+
+        TileRegion region;
+        region.arraySlice = arraySlice;
+        region.mip = mip;
+        region.x = tileX * m_header.tileWidthInTexels;
+        region.y = tileY * m_header.tileHeightInTexels;
+        region.width = std::min(m_header.tileWidthInTexels, alignedWidth - std::min(region.x, alignedWidth));
+        region.height = std::min(m_header.tileHeightInTexels, alignedHeight - std::min(region.y, alignedHeight));
+        return region;
+    }
+
+    uint32_t TilePackReader::GetRowPitch(uint32_t widthInTexels) const
+    {
+        return ((widthInTexels + m_header.blockSize - 1) / m_header.blockSize) * m_header.bytesPerBlock;
+    }
+
+    uint64_t TilePackReader::GetSizeInBytes(uint32_t widthInTexels, uint32_t heightInTexels) const
+    {
+        return uint64_t(GetRowPitch(widthInTexels)) * ((heightInTexels + m_header.blockSize - 1) / m_header.blockSize);
+    }
+
+    const TilePackTileEntry* TilePackReader::FindStoredTile(const TileRegion& region) const
+    {
+        if (region.arraySlice >= m_header.arraySize || region.mip >= m_header.numStandardMips)
+            return nullptr;
+
+        if (region.x % m_header.tileWidthInTexels != 0 || region.y % m_header.tileHeightInTexels != 0)
+            return nullptr;
+
+        uint32_t tileX = region.x / m_header.tileWidthInTexels;
+        uint32_t tileY = region.y / m_header.tileHeightInTexels;
+        const TilePackTileEntry* tile = GetTile(region.arraySlice, region.mip, tileX, tileY);
+        if (!tile)
+            return nullptr;
+
+        // Compare in blocks, the region may not be rounded up to whole blocks at the edge of the subresource
+        TileRegion tileRegion = GetTileRegion(region.arraySlice, region.mip, tileX, tileY);
+        if (GetRowPitch(region.width) != GetRowPitch(tileRegion.width) ||
+            GetSizeInBytes(region.width, region.height) != GetSizeInBytes(tileRegion.width, tileRegion.height))
+            return nullptr;
+
+        return tile;
+    }
+
+    bool TilePackReader::ReadTile(const TilePackTileEntry& tile, uint8_t* dest) const
+    {
+        if (tile.flags == 0)
+            return tile.storedSize == tile.size && m_file.ReadAt(tile.offset, tile.size, dest);
+
+        thread_local std::vector<uint8_t> stored;
+        stored.resize(tile.storedSize);
+        if (!m_file.ReadAt(tile.offset, stored.size(), stored.data()))
+            return false;
+
+        if (tile.flags & TileFlagTranscode)
+            return TranscodeTile(tile.flags, m_header.dxgiFormat, m_transcodeQuality, stored.data(), stored.size(), dest, tile.size);
+        return DecodeTile(tile.flags, m_header.bytesPerBlock, stored.data(), stored.size(), dest, tile.size);
+    }
+
+    bool TilePackReader::ReadUniformBlock(const TilePackTileEntry& tile, std::vector<uint8_t>& block) const
+    {
+        if ((tile.flags & TileFlagUniform) == 0)
+            return false;
+
+        // Transcoded tiles store a texel, encoding it gives the block
+        block.resize(m_header.bytesPerBlock);
+        if (tile.flags & TileFlagTranscode)
+        {
+            uint8_t texel[4];
+            return tile.storedSize == sizeof(texel) && m_file.ReadAt(tile.offset, sizeof(texel), texel) &&
+                TranscodeTile(tile.flags, m_header.dxgiFormat, m_transcodeQuality, texel, sizeof(texel), block.data(), block.size());
+        }
+        return tile.storedSize == block.size() && m_file.ReadAt(tile.offset, block.size(), block.data());
+    }
+
+    bool TilePackReader::ReadPackedMip(const TilePackSubresource& subresource, uint8_t* dest) const
+    {
+        if (subresource.packedFlags == 0)
+            return m_file.ReadAt(subresource.packedOffset, size_t(subresource.packedSize), dest);
+
+        std::vector<uint8_t> stored(size_t(subresource.packedStoredSize));
+        if (!m_file.ReadAt(subresource.packedOffset, stored.size(), stored.data()))
+            return false;
+
+        if (subresource.packedFlags & TileFlagTranscode)
+            return TranscodeTile(subresource.packedFlags, m_header.dxgiFormat, m_transcodeQuality, stored.data(), stored.size(), dest, size_t(subresource.packedSize));
+        return DecodeTile(subresource.packedFlags, m_header.bytesPerBlock, stored.data(), stored.size(), dest, size_t(subresource.packedSize));
+    }
+
+    bool TilePackReader::ReadRegion(const TileRegion& region, uint8_t* dest, uint64_t destRowPitch) const
+    {
+        if (region.arraySlice >= m_header.arraySize || region.mip >= m_header.mipLevels)
+            return false;
+
+        const TilePackSubresource& subresource = GetSubresource(region.arraySlice, region.mip);
+        uint32_t blockSize = m_header.blockSize;
+        uint32_t bytesPerBlock = m_header.bytesPerBlock;
+
+        // Work in blocks, clipped to the subresource
+        uint32_t subresourceBlocksX = (subresource.width + blockSize - 1) / blockSize;
+        uint32_t subresourceBlocksY = (subresource.height + blockSize - 1) / blockSize;
+        uint32_t regionBlockX0 = region.x / blockSize;
+        uint32_t regionBlockY0 = region.y / blockSize;
+        uint32_t regionBlockX1 = std::min((region.x + region.width + blockSize - 1) / blockSize, subresourceBlocksX);
+        uint32_t regionBlockY1 = std::min((region.y + region.height + blockSize - 1) / blockSize, subresourceBlocksY);
+        if (regionBlockX0 >= regionBlockX1 || regionBlockY0 >= regionBlockY1)
+            return false;
+
+        std::vector<uint8_t> scratch;
+
+        if (subresource.widthInTiles == 0)
+        {
+            // Packed mip, read it whole
+            bool wholeMip = regionBlockX0 == 0 && regionBlockY0 == 0 && regionBlockX1 == subresourceBlocksX && regionBlockY1 == subresourceBlocksY;
+            if (wholeMip && destRowPitch == subresource.rowPitch)
+                return ReadPackedMip(subresource, dest);
+
+            scratch.resize(size_t(subresource.packedSize));
+            if (!ReadPackedMip(subresource, scratch.data()))
+                return false;
+
+            CopyBlockRect(scratch.data(), subresource.rowPitch, regionBlockX0, regionBlockY0, dest, destRowPitch, 0, 0,
+                regionBlockX1 - regionBlockX0, regionBlockY1 - regionBlockY0, bytesPerBlock);
+            return true;
+        }
+
+        uint32_t tileBlocksX = m_header.tileWidthInTexels / blockSize;
+        uint32_t tileBlocksY = m_header.tileHeightInTexels / blockSize;
+
+        for (uint32_t tileY = regionBlockY0 / tileBlocksY; tileY <= (regionBlockY1 - 1) / tileBlocksY; tileY++)
+        {
+            for (uint32_t tileX = regionBlockX0 / tileBlocksX; tileX <= (regionBlockX1 - 1) / tileBlocksX; tileX++)
+            {
+                const TilePackTileEntry* tile = GetTile(region.arraySlice, region.mip, tileX, tileY);
+                if (!tile)
+                    return false;
+
+                TileRegion tileRegion = GetTileRegion(region.arraySlice, region.mip, tileX, tileY);
+                uint32_t tileBlockX0 = tileRegion.x / blockSize;
+                uint32_t tileBlockY0 = tileRegion.y / blockSize;
+                uint32_t tileBlockX1 = tileBlockX0 + (tileRegion.width + blockSize - 1) / blockSize;
+                uint32_t tileBlockY1 = tileBlockY0 + (tileRegion.height + blockSize - 1) / blockSize;
+                uint32_t tileRowPitch = GetRowPitch(tileRegion.width);
+
+                // Fast path, the region is exactly this tile
+                bool wholeTile = regionBlockX0 == tileBlockX0 && regionBlockY0 == tileBlockY0 && regionBlockX1 == tileBlockX1 && regionBlockY1 == tileBlockY1;
+                if (wholeTile && destRowPitch == tileRowPitch)
+                    return ReadTile(*tile, dest);
+
+                scratch.resize(tile->size);
+                if (!ReadTile(*tile, scratch.data()))
+                    return false;
+
+                uint32_t overlapX0 = std::max(regionBlockX0, tileBlockX0);
+                uint32_t overlapY0 = std::max(regionBlockY0, tileBlockY0);
+                uint32_t overlapX1 = std::min(regionBlockX1, tileBlockX1);
+                uint32_t overlapY1 = std::min(regionBlockY1, tileBlockY1);
+
+                CopyBlockRect(scratch.data(), tileRowPitch, overlapX0 - tileBlockX0, overlapY0 - tileBlockY0,
+                    dest, destRowPitch, overlapX0 - regionBlockX0, overlapY0 - regionBlockY0,
+                    overlapX1 - overlapX0, overlapY1 - overlapY0, bytesPerBlock);
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "DdsFile.h"
+#include "File.h"
+#include "TileCodec.h"
+#include "TileTranscoder.h"
+
+// Tile pack container
+//
+// A streaming optimized layout of a texture. Every standard 64 KiB tile is stored contiguously in the layout used
+// for tile uploads: rows of blocks, each row as wide as the tile (edge tiles are narrower), tightly packed.
+// Uploading a tile therefore needs one contiguous read instead of gathering rows across a whole mip.
+// Tiles and packed mips may be compressed one by one, see TileCodec.h, and are then stored tightly packed.
+// RGBA8 textures may also be converted to a BC format whose tiles are stored in the intermediate form of
+// TileTranscoder.h, the header then describes the BC texture and the tiles are transcoded when they are read.
+// Every tile carries a hash of its content, tiles with the same content share one copy of the stored data.
+// Tiles repeating a single block are stored as that block, see TileFlagUniform.
+//
+//   TilePackHeader
+//   TilePackSubresource[arraySize * mipLevels]   index = arraySlice * mipLevels + mip
+//   TilePackTileEntry[numTiles]                  per-mip tile tables, row major, located with firstTile
+//   tile data                                    uncompressed packs start every plain tile at a TilePackAlignment boundary
+//   packed mip data                              mips with numStandardMips <= mip
+//
+// All values are little endian.
+
+namespace tilestream
+{
+    constexpr uint32_t TilePackMagic = 0x50545452; // "RTTP"
+    constexpr uint32_t TilePackVersion = 3;
+    constexpr uint32_t TilePackTileSizeInBytes = 65536;
+    constexpr uint32_t TilePackAlignment = 4096;
+
+    struct TilePackHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t dxgiFormat;
+        uint32_t width;
+        uint32_t height;
+        uint32_t arraySize;
+        uint32_t mipLevels;
+        uint32_t blockSize;
+        uint32_t bytesPerBlock;
+        uint32_t tileWidthInTexels;
+        uint32_t tileHeightInTexels;
+        uint32_t numStandardMips; // Mips stored as tiles, the remaining ones are stored as packed mips
+        uint32_t numTiles;
+        uint32_t codec;           // TileCodec used by the writer, individual tiles may still be stored uncompressed
+        uint64_t subresourceTableOffset;
+        uint64_t tileTableOffset;
+    };
+
+    struct TilePackSubresource
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t widthInTiles;  // 0 for packed mips
+        uint32_t heightInTiles; // 0 for packed mips
+        uint32_t firstTile;
+        uint32_t rowPitch;      // Tightly packed pitch of the whole mip
+        uint64_t packedOffset;  // Packed mips only
+        uint64_t packedSize;    // Packed mips only
+        uint64_t packedStoredSize;
+        uint32_t packedFlags;   // Encoding of the packed mip, see TileCodec.h
+        uint32_t reserved;
+    };
+
+    struct TilePackTileEntry
+    {
+        uint64_t offset;
+        uint64_t contentHash;   // HashTileData of the decoded tile, of the intermediate form for transcoded tiles
+        uint32_t storedSize;
+        uint32_t size;          // Size after decoding
+        uint32_t flags;         // Encoding of the tile, see TileCodec.h
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(TilePackHeader) == 72, "Unexpected tile pack header size");
+    static_assert(sizeof(TilePackSubresource) == 56, "Unexpected tile pack subresource size");
+    static_assert(sizeof(TilePackTileEntry) == 32, "Unexpected tile pack tile entry size");
+
+    // Returns the shape of a 64 KiB standard tile for the given block layout, as defined by D3D12 standard swizzle.
+    // Fails for block sizes without a standard shape, such as 96 bit formats.
+    bool GetStandardTileShape(uint32_t blockSize, uint32_t bytesPerBlock, uint32_t& widthInTexels, uint32_t& heightInTexels);
+
+    // Region of a subresource in texels, the layout of a tile or mip in memory is derived from its width
+    struct TileRegion
+    {
+        uint32_t arraySlice;
+        uint32_t mip;
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    // Copies a rectangle of blocks between two tightly laid out images with the given row pitches
+    void CopyBlockRect(const uint8_t* source, uint64_t sourceRowPitch, uint32_t sourceBlockX, uint32_t sourceBlockY,
+        uint8_t* dest, uint64_t destRowPitch, uint32_t destBlockX, uint32_t destBlockY,
+        uint32_t widthInBlocks, uint32_t heightInBlocks, uint32_t bytesPerBlock);
+
+    class TilePackReader
+    {
+    public:
+        bool Open(const std::filesystem::path& path);
+        void Close();
+
+        const TilePackHeader& GetHeader() const { return m_header; }
+        const TilePackSubresource& GetSubresource(uint32_t arraySlice, uint32_t mip) const;
+        const ReadOnlyFile& GetFile() const { return m_file; }
+
+        // Returns the stored tile containing the texel, nullptr for packed mips
+        const TilePackTileEntry* GetTile(uint32_t arraySlice, uint32_t mip, uint32_t tileX, uint32_t tileY) const;
+
+        // Returns the region covered by a stored tile, edge tiles are clipped to the block aligned subresource
+        TileRegion GetTileRegion(uint32_t arraySlice, uint32_t mip, uint32_t tileX, uint32_t tileY) const;
+
+        uint32_t GetRowPitch(uint32_t widthInTexels) const;
+        uint64_t GetSizeInBytes(uint32_t widthInTexels, uint32_t heightInTexels) const;
+
+        // Returns the stored tile if the region is exactly one stored tile, which can then be read with one read
+        const TilePackTileEntry* FindStoredTile(const TileRegion& region) const;
+
+        // Reads and decodes a stored tile, dest receives tile.size bytes in the upload layout
+        bool ReadTile(const TilePackTileEntry& tile, uint8_t* dest) const;
+
+        // Reads the block repeated over a tile with TileFlagUniform, returns false for other tiles
+        bool ReadUniformBlock(const TilePackTileEntry& tile, std::vector<uint8_t>& block) const;
+
+        // Encoding quality of tiles stored in the intermediate form
+        void SetTranscodeQuality(BcQuality quality) { m_transcodeQuality = quality; }
+
+        // Reads any region of the texture into dest with the given row pitch. Regions matching a stored tile take one
+        // contiguous read, other regions are assembled from the stored tiles or packed mips they overlap.
+        bool ReadRegion(const TileRegion& region, uint8_t* dest, uint64_t destRowPitch) const;
+
+    private:
+        bool ReadPackedMip(const TilePackSubresource& subresource, uint8_t* dest) const;
+
+        ReadOnlyFile m_file;
+        TilePackHeader m_header = {};
+        std::vector<TilePackSubresource> m_subresources;
+        std::vector<TilePackTileEntry> m_tiles;
+        BcQuality m_transcodeQuality = BcQuality::Normal;
+    };
+
+    struct TilePackWriterDesc
+    {
+        // Number of mips stored as tiles, -1 uses all mips with at least one whole standard tile
+        int numStandardMips = -1;
+
+        TileEncoderDesc encoder;
+
+        // Stores the tiles of an RGBA8 texture in the intermediate form, transcoded to this format when they are read.
+        // Count keeps the format of the texture.
+        BcFormat transcodeFormat = BcFormat::Count;
+        IntermediateDesc intermediate;
+    };
+
+    // Converts a DDS file in memory to a tile pack. Only 2D textures and texture arrays are supported.
+    bool WriteTilePack(const DdsTextureInfo& ddsInfo, const uint8_t* ddsData, const TilePackWriterDesc& desc,
+        std::vector<uint8_t>& output, std::string& error);
+}
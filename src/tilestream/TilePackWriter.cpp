@@ -0,0 +1,262 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "TilePack.h"
+
+#include <algorithm>
+#include <string.h>
+#include <unordered_map>
+
+namespace tilestream
+{
+    namespace
+    {
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    bool WriteTilePack(const DdsTextureInfo& ddsInfo, const uint8_t* ddsData, const TilePackWriterDesc& desc,
+        std::vector<uint8_t>& output, std::string& error)
+    {
+        if (ddsInfo.depth != 1)
+        {
+            error = "volume textures are not supported";
+            return false;
+        }
+
+        // Transcoded packs describe the BC texture, the texels are read from the RGBA8 source
+        bool transcode = desc.transcodeFormat < BcFormat::Count;
+        if (transcode && ddsInfo.dxgiFormat != 28 && ddsInfo.dxgiFormat != 29) // DXGI_FORMAT_R8G8B8A8_UNORM(_SRGB)
+        {
+            error = "transcoding requires an RGBA8 texture";
+            return false;
+        }
+
+        TilePackHeader header = {};
+        header.magic = TilePackMagic;
+        header.version = TilePackVersion;
+        header.dxgiFormat = transcode ? GetBcDxgiFormat(desc.transcodeFormat, ddsInfo.dxgiFormat == 29) : ddsInfo.dxgiFormat;
+        header.width = ddsInfo.width;
+        header.height = ddsInfo.height;
+        header.arraySize = ddsInfo.arraySize;
+        header.mipLevels = ddsInfo.mipLevels;
+        header.blockSize = transcode ? 4 : ddsInfo.blockSize;
+        header.bytesPerBlock = transcode ? GetBcBytesPerBlock(desc.transcodeFormat) : ddsInfo.bytesPerBlock;
+        if (!GetStandardTileShape(header.blockSize, header.bytesPerBlock, header.tileWidthInTexels, header.tileHeightInTexels))
+        {
+            error = "the format has no standard tile shape";
+            return false;
+        }
+
+        // Mips smaller than a tile in either dimension end up in the packed mip tail
+        uint32_t numStandardMips = 0;
+        while (numStandardMips < header.mipLevels &&
+            std::max(header.width >> numStandardMips, 1u) >= header.tileWidthInTexels &&
+            std::max(header.height >> numStandardMips, 1u) >= header.tileHeightInTexels)
+            numStandardMips++;
+        if (desc.numStandardMips >= 0)
+            numStandardMips = std::min(uint32_t(desc.numStandardMips), header.mipLevels);
+        header.numStandardMips = numStandardMips;
+        header.codec = uint32_t(desc.encoder.codec);
+
+        if (!IsTileCodecAvailable(desc.encoder.codec))
+        {
+            error = std::string("codec '") + GetTileCodecName(desc.encoder.codec) + "' is not available in this build";
+            return false;
+        }
+
+        // Uncompressed tiles are aligned so they can be read straight into upload memory, compressed ones are decoded
+        // from a separate buffer anyway and are stored tightly packed
+        uint64_t tileAlignment = desc.encoder.codec == TileCodec::None && !transcode ? TilePackAlignment : 1;
+
+        uint32_t tileBlocksX = header.tileWidthInTexels / header.blockSize;
+        uint32_t tileBlocksY = header.tileHeightInTexels / header.blockSize;
+
+        // Size of a subresource in blocks of the pack format
+        auto getBlocks = [&](const DdsSubresourceLayout& layout, uint32_t& blocksX, uint32_t& blocksY)
+        {
+            blocksX = (layout.width + header.blockSize - 1) / header.blockSize;
+            blocksY = (layout.height + header.blockSize - 1) / header.blockSize;
+        };
+
+        // Returns true if all texels of an RGBA8 rectangle have the same value
+        auto isUniformRgba = [](const uint8_t* rgba, uint32_t width, uint32_t height, size_t rowPitch)
+        {
+            for (uint32_t y = 0; y < height; y++)
+            {
+                const uint8_t* row = rgba + y * rowPitch;
+                if (memcmp(row, rgba, 4) != 0 || !IsUniformData(row, size_t(width) * 4, 4))
+                    return false;
+            }
+            return true;
+        };
+
+        // Encodes a rectangle of blocks of a subresource in the upload layout, returns the flags, the decoded size
+        // and the content hash. Transcoded tiles hash their intermediate form, which decodes to the same blocks.
+        // Regions repeating one block, or one texel when transcoding, are stored as that with TileFlagUniform.
+        std::vector<uint8_t> regionData;
+        auto encodeRegion = [&](const DdsSubresourceLayout& layout, uint32_t blockX, uint32_t blockY, uint32_t widthInBlocks,
+            uint32_t heightInBlocks, std::vector<uint8_t>& encoded, uint32_t& size, uint64_t& contentHash)
+        {
+            size = widthInBlocks * heightInBlocks * header.bytesPerBlock;
+            if (transcode)
+            {
+                // Clip to the texels of the mip, the transcoder replicates the edges into partial blocks
+                uint32_t x = blockX * header.blockSize;
+                uint32_t y = blockY * header.blockSize;
+                uint32_t width = std::min(widthInBlocks * header.blockSize, layout.width - x);
+                uint32_t height = std::min(heightInBlocks * header.blockSize, layout.height - y);
+                const uint8_t* rgba = ddsData + layout.dataOffset + y * layout.rowPitch + uint64_t(x) * 4;
+                if (isUniformRgba(rgba, width, height, size_t(layout.rowPitch)))
+                {
+                    encoded.assign(rgba, rgba + 4);
+                    contentHash = HashTileData(encoded.data(), encoded.size(), TileFlagTranscode | TileFlagUniform);
+                    return TileFlagTranscode | TileFlagUniform;
+                }
+
+                uint32_t flags = EncodeIntermediateTile(desc.encoder, desc.intermediate, desc.transcodeFormat, rgba, width, height,
+                    size_t(layout.rowPitch), encoded);
+                contentHash = HashTileData(encoded.data(), encoded.size(), flags);
+                return flags;
+            }
+
+            uint32_t rowPitch = widthInBlocks * header.bytesPerBlock;
+            regionData.resize(size);
+            CopyBlockRect(ddsData + layout.dataOffset, layout.rowPitch, blockX, blockY,
+                regionData.data(), rowPitch, 0, 0, widthInBlocks, heightInBlocks, header.bytesPerBlock);
+            contentHash = HashTileData(regionData.data(), regionData.size());
+            if (IsUniformData(regionData.data(), regionData.size(), header.bytesPerBlock))
+            {
+                encoded.assign(regionData.begin(), regionData.begin() + header.bytesPerBlock);
+                return TileFlagUniform;
+            }
+            return EncodeTile(desc.encoder, header.bytesPerBlock, regionData.data(), regionData.size(), encoded);
+        };
+
+        std::vector<TilePackSubresource> subresources(ddsInfo.subresources.size());
+        for (uint32_t arraySlice = 0; arraySlice < header.arraySize; arraySlice++)
+        {
+            for (uint32_t mip = 0; mip < header.mipLevels; mip++)
+            {
+                const DdsSubresourceLayout& layout = ddsInfo.subresources[arraySlice * header.mipLevels + mip];
+                TilePackSubresource& subresource = subresources[arraySlice * header.mipLevels + mip];
+                uint32_t blocksX, blocksY;
+                getBlocks(layout, blocksX, blocksY);
+
+                subresource = {};
+                subresource.width = layout.width;
+                subresource.height = layout.height;
+                subresource.rowPitch = blocksX * header.bytesPerBlock;
+                subresource.firstTile = header.numTiles;
+
+                if (mip < numStandardMips)
+                {
+                    subresource.widthInTiles = (blocksX + tileBlocksX - 1) / tileBlocksX;
+                    subresource.heightInTiles = (blocksY + tileBlocksY - 1) / tileBlocksY;
+                    header.numTiles += subresource.widthInTiles * subresource.heightInTiles;
+                }
+            }
+        }
+
+        header.subresourceTableOffset = sizeof(TilePackHeader);
+        header.tileTableOffset = header.subresourceTableOffset + subresources.size() * sizeof(TilePackSubresource);
+        uint64_t dataOffset = AlignUp(header.tileTableOffset + uint64_t(header.numTiles) * sizeof(TilePackTileEntry), TilePackAlignment);
+
+        std::vector<TilePackTileEntry> tiles(header.numTiles);
+        output.assign(dataOffset, 0);
+
+        std::vector<uint8_t> encoded;
+
+        // Tiles with the same content, like the uniform tiles of a flat color, are stored once
+        std::unordered_map<uint64_t, uint32_t> tilesByHash;
+
+        // Standard tiles, each one contiguous in the upload layout
+        for (uint32_t arraySlice = 0; arraySlice < header.arraySize; arraySlice++)
+        {
+            for (uint32_t mip = 0; mip < numStandardMips; mip++)
+            {
+                const DdsSubresourceLayout& layout = ddsInfo.subresources[arraySlice * header.mipLevels + mip];
+                const TilePackSubresource& subresource = subresources[arraySlice * header.mipLevels + mip];
+                uint32_t blocksX, blocksY;
+                getBlocks(layout, blocksX, blocksY);
+
+                for (uint32_t tileY = 0; tileY < subresource.heightInTiles; tileY++)
+                {
+                    for (uint32_t tileX = 0; tileX < subresource.widthInTiles; tileX++)
+                    {
+                        uint32_t blockX = tileX * tileBlocksX;
+                        uint32_t blockY = tileY * tileBlocksY;
+                        uint32_t widthInBlocks = std::min(tileBlocksX, blocksX - blockX);
+                        uint32_t heightInBlocks = std::min(tileBlocksY, blocksY - blockY);
+
+                        uint32_t tileIndex = subresource.firstTile + tileY * subresource.widthInTiles + tileX;
+                        TilePackTileEntry& tile = tiles[tileIndex];
+                        tile = {};
+                        tile.flags = encodeRegion(layout, blockX, blockY, widthInBlocks, heightInBlocks, encoded, tile.size, tile.contentHash);
+                        tile.storedSize = uint32_t(encoded.size());
+
+                        // The stored bytes are compared as well, a hash collision must not corrupt the pack
+                        auto it = tilesByHash.find(tile.contentHash);
+                        if (it != tilesByHash.end())
+                        {
+                            const TilePackTileEntry& original = tiles[it->second];
+                            if (original.flags == tile.flags && original.size == tile.size && original.storedSize == tile.storedSize &&
+                                memcmp(output.data() + original.offset, encoded.data(), encoded.size()) == 0)
+                            {
+                                tile.offset = original.offset;
+                                continue;
+                            }
+                        }
+                        else
+                        {
+                            tilesByHash[tile.contentHash] = tileIndex;
+                        }
+
+                        tile.offset = AlignUp(output.size(), tile.flags == 0 ? tileAlignment : 1);
+                        output.resize(tile.offset, 0);
+                        output.insert(output.end(), encoded.begin(), encoded.end());
+                    }
+                }
+            }
+        }
+
+        output.resize(AlignUp(output.size(), tileAlignment), 0);
+
+        // Packed mips, stored whole in the tight layout of the pack format
+        for (uint32_t arraySlice = 0; arraySlice < header.arraySize; arraySlice++)
+        {
+            for (uint32_t mip = numStandardMips; mip < header.mipLevels; mip++)
+            {
+                const DdsSubresourceLayout& layout = ddsInfo.subresources[arraySlice * header.mipLevels + mip];
+                TilePackSubresource& subresource = subresources[arraySlice * header.mipLevels + mip];
+                uint32_t blocksX, blocksY, size;
+                uint64_t contentHash;
+                getBlocks(layout, blocksX, blocksY);
+
+                subresource.packedOffset = output.size();
+                subresource.packedFlags = encodeRegion(layout, 0, 0, blocksX, blocksY, encoded, size, contentHash);
+                subresource.packedSize = size;
+                subresource.packedStoredSize = encoded.size();
+                output.insert(output.end(), encoded.begin(), encoded.end());
+            }
+        }
+
+        memcpy(output.data(), &header, sizeof(header));
+        memcpy(output.data() + header.subresourceTableOffset, subresources.data(), subresources.size() * sizeof(TilePackSubresource));
+        if (!tiles.empty())
+            memcpy(output.data() + header.tileTableOffset, tiles.data(), tiles.size() * sizeof(TilePackTileEntry));
+
+        return true;
+    }
+}
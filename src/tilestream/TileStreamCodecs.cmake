@@ -0,0 +1,33 @@
+# Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+#
+# NVIDIA CORPORATION and its licensors retain all intellectual property
+# and proprietary rights in and to this software, related documentation
+# and any modifications thereto.  Any use, reproduction, disclosure or
+# distribution of this software and related documentation without an express
+# license agreement from NVIDIA CORPORATION is strictly prohibited.
+
+# Optional tile codecs of the tilestream sources, enabled for a target when their libraries are found.
+# The built in LZ4 codec needs no library, tile packs using a codec missing from a build fail to open.
+
+option(TILESTREAM_WITH_ZLIB "Enable the deflate tile codec if zlib is found" ON)
+option(TILESTREAM_WITH_ZSTD "Enable the zstd tile codec if zstd is found" ON)
+
+function(tilestream_link_codecs target)
+    if (TILESTREAM_WITH_ZLIB)
+        find_package(ZLIB QUIET)
+        if (ZLIB_FOUND)
+            target_compile_definitions(${target} PRIVATE TILESTREAM_WITH_ZLIB)
+            target_link_libraries(${target} ZLIB::ZLIB)
+        endif()
+    endif()
+
+    if (TILESTREAM_WITH_ZSTD)
+        find_path(ZSTD_INCLUDE_DIR zstd.h)
+        find_library(ZSTD_LIBRARY NAMES zstd zstd_static)
+        if (ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+            target_compile_definitions(${target} PRIVATE TILESTREAM_WITH_ZSTD)
+            target_include_directories(${target} PRIVATE ${ZSTD_INCLUDE_DIR})
+            target_link_libraries(${target} ${ZSTD_LIBRARY})
+        endif()
+    endif()
+endfunction()
@@ -0,0 +1,395 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#include "TileTranscoder.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace tilestream
+{
+    namespace
+    {
+        enum class IntermediateLayout : uint8_t
+        {
+            RG,       // Red and green planes
+            YCoCg444, // Luma and chroma planes at full resolution
+            YCoCg420, // Chroma planes at half resolution, rounded up
+            Count
+        };
+
+        // Stored uncompressed in front of the residuals
+        struct IntermediateHeader
+        {
+            uint16_t width;
+            uint16_t height;
+            uint8_t layout;
+            uint8_t nearLossless;
+            uint8_t hasAlpha;
+            uint8_t reserved;
+            uint32_t residualSize;
+            uint32_t reserved2;
+        };
+
+        static_assert(sizeof(IntermediateHeader) == 16, "Unexpected intermediate header size");
+
+        struct PlaneSize
+        {
+            uint32_t width;
+            uint32_t height;
+        };
+
+        uint32_t GetPlanes(const IntermediateHeader& header, PlaneSize* planes)
+        {
+            uint32_t numPlanes = 0;
+            PlaneSize full = { header.width, header.height };
+            PlaneSize half = { (header.width + 1u) / 2, (header.height + 1u) / 2 };
+            switch (IntermediateLayout(header.layout))
+            {
+            case IntermediateLayout::RG:
+                planes[numPlanes++] = full;
+                planes[numPlanes++] = full;
+                break;
+            case IntermediateLayout::YCoCg444:
+            case IntermediateLayout::YCoCg420:
+                planes[numPlanes++] = full;
+                planes[numPlanes++] = IntermediateLayout(header.layout) == IntermediateLayout::YCoCg420 ? half : full;
+                planes[numPlanes++] = planes[1];
+                break;
+            default:
+                return 0;
+            }
+            if (header.hasAlpha)
+                planes[numPlanes++] = full;
+            return numPlanes;
+        }
+
+        uint8_t ClampToByte(int32_t value)
+        {
+            return uint8_t(std::min(std::max(value, 0), 255));
+        }
+
+        // LOCO-I median edge detector from the left, upper and upper left neighbours
+        int32_t PredictMed(const uint8_t* plane, uint32_t width, uint32_t x, uint32_t y)
+        {
+            if (y == 0)
+                return x == 0 ? 128 : plane[x - 1];
+
+            const uint8_t* row = plane + size_t(y) * width;
+            const uint8_t* above = row - width;
+            int32_t b = above[x];
+            if (x == 0)
+                return b;
+
+            int32_t a = row[x - 1];
+            int32_t c = above[x - 1];
+            if (c >= std::max(a, b))
+                return std::min(a, b);
+            if (c <= std::min(a, b))
+                return std::max(a, b);
+            return a + b - c;
+        }
+
+        // Replaces the plane by its reconstruction while writing the residuals, so that the prediction sees the same
+        // neighbours as the decoder when near lossless quantization is used
+        void EncodePlane(uint8_t* plane, uint32_t width, uint32_t height, uint32_t nearLossless, uint8_t* residuals)
+        {
+            int32_t step = int32_t(nearLossless) * 2 + 1;
+            for (uint32_t y = 0; y < height; y++)
+            {
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    uint8_t& value = plane[size_t(y) * width + x];
+                    int32_t prediction = PredictMed(plane, width, x, y);
+                    int32_t error = int32_t(value) - prediction;
+                    if (nearLossless == 0)
+                    {
+                        *residuals++ = uint8_t(error);
+                        continue;
+                    }
+
+                    int32_t quantized = error > 0 ? (error + int32_t(nearLossless)) / step : -((int32_t(nearLossless) - error) / step);
+                    *residuals++ = uint8_t(int8_t(quantized));
+                    value = ClampToByte(prediction + quantized * step);
+                }
+            }
+        }
+
+        // Same prediction as PredictMed, with the neighbours kept in registers along the row
+        template <bool quantized>
+        void DecodePlaneRows(const uint8_t* residuals, uint32_t width, uint32_t height, int32_t step, uint8_t* plane)
+        {
+            auto reconstruct = [step](int32_t prediction, uint8_t residual)
+            {
+                return quantized ? ClampToByte(prediction + int32_t(int8_t(residual)) * step) : uint8_t(prediction + residual);
+            };
+
+            int32_t left = 128;
+            for (uint32_t x = 0; x < width; x++)
+                left = plane[x] = reconstruct(left, residuals[x]);
+
+            for (uint32_t y = 1; y < height; y++)
+            {
+                const uint8_t* above = plane + size_t(y - 1) * width;
+                uint8_t* row = plane + size_t(y) * width;
+                const uint8_t* rowResiduals = residuals + size_t(y) * width;
+
+                int32_t a = row[0] = reconstruct(above[0], rowResiduals[0]);
+                int32_t c = above[0];
+                for (uint32_t x = 1; x < width; x++)
+                {
+                    int32_t b = above[x];
+                    int32_t smaller = std::min(a, b);
+                    int32_t larger = std::max(a, b);
+                    int32_t prediction = c >= larger ? smaller : (c <= smaller ? larger : a + b - c);
+                    a = row[x] = reconstruct(prediction, rowResiduals[x]);
+                    c = b;
+                }
+            }
+        }
+
+        void DecodePlane(const uint8_t* residuals, uint32_t width, uint32_t height, uint32_t nearLossless, uint8_t* plane)
+        {
+            if (nearLossless == 0)
+                DecodePlaneRows<false>(residuals, width, height, 1, plane);
+            else
+                DecodePlaneRows<true>(residuals, width, height, int32_t(nearLossless) * 2 + 1, plane);
+        }
+        void ConvertRowFromRG(const uint8_t* red, const uint8_t* green, uint32_t width, uint8_t* rgba)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                rgba[x * 4 + 0] = red[x];
+                rgba[x * 4 + 1] = green[x];
+                rgba[x * 4 + 2] = 0;
+            }
+        }
+
+        // Inverse of the YCoCg conversion of EncodeIntermediateTile, chroma texels cover 1 << chromaShift luma texels
+        template <uint32_t chromaShift>
+        void ConvertRowFromYCoCg(const uint8_t* luma, const uint8_t* co, const uint8_t* cg, uint32_t width, uint8_t* rgba)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                int32_t y = luma[x];
+                int32_t orange = int32_t(co[x >> chromaShift]) - 128;
+                int32_t green = int32_t(cg[x >> chromaShift]) - 128;
+                int32_t t = y - green;
+                rgba[x * 4 + 0] = ClampToByte(t + orange);
+                rgba[x * 4 + 1] = ClampToByte(y + green);
+                rgba[x * 4 + 2] = ClampToByte(t - orange);
+            }
+        }
+    }
+
+    uint32_t EncodeIntermediateTile(const TileEncoderDesc& encoder, const IntermediateDesc& desc, BcFormat format,
+        const uint8_t* rgba, uint32_t width, uint32_t height, size_t rgbaRowPitch, std::vector<uint8_t>& output)
+    {
+        IntermediateHeader header = {};
+        header.width = uint16_t(width);
+        header.height = uint16_t(height);
+        header.nearLossless = uint8_t(std::min(desc.nearLossless, 127u));
+
+        if (format == BcFormat::BC5)
+            header.layout = uint8_t(IntermediateLayout::RG);
+        else
+            header.layout = uint8_t(desc.subsampleChroma ? IntermediateLayout::YCoCg420 : IntermediateLayout::YCoCg444);
+
+        // Opaque tiles don't store alpha
+        if (format == BcFormat::BC3 || format == BcFormat::BC7)
+        {
+            for (uint32_t y = 0; y < height && !header.hasAlpha; y++)
+            {
+                const uint8_t* row = rgba + size_t(y) * rgbaRowPitch;
+                for (uint32_t x = 0; x < width && !header.hasAlpha; x++)
+                    header.hasAlpha = row[x * 4 + 3] != 255;
+            }
+        }
+
+        PlaneSize planeSizes[4];
+        uint32_t numPlanes = GetPlanes(header, planeSizes);
+        std::vector<std::vector<uint8_t>> planes(numPlanes);
+        for (uint32_t p = 0; p < numPlanes; p++)
+            planes[p].resize(size_t(planeSizes[p].width) * planeSizes[p].height);
+
+        bool isYCoCg = header.layout != uint8_t(IntermediateLayout::RG);
+        bool isSubsampled = header.layout == uint8_t(IntermediateLayout::YCoCg420);
+        uint32_t halfWidth = (width + 1) / 2;
+        std::vector<uint32_t> chromaSums(isSubsampled ? size_t(halfWidth) * 2 : 0);
+
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint8_t* row = rgba + size_t(y) * rgbaRowPitch;
+            for (uint32_t x = 0; x < width; x++)
+            {
+                const uint8_t* texel = row + x * 4;
+                size_t index = size_t(y) * width + x;
+                if (!isYCoCg)
+                {
+                    planes[0][index] = texel[0];
+                    planes[1][index] = texel[1];
+                }
+                else
+                {
+                    int32_t r = texel[0], g = texel[1], b = texel[2];
+                    uint8_t co = ClampToByte(((r - b + 1) >> 1) + 128);
+                    uint8_t cg = ClampToByte(((2 * g - r - b + 2) >> 2) + 128);
+                    planes[0][index] = uint8_t((r + 2 * g + b + 2) >> 2);
+                    if (isSubsampled)
+                    {
+                        chromaSums[(x / 2) * 2] += co;
+                        chromaSums[(x / 2) * 2 + 1] += cg;
+                    }
+                    else
+                    {
+                        planes[1][index] = co;
+                        planes[2][index] = cg;
+                    }
+                }
+                if (header.hasAlpha)
+                    planes[numPlanes - 1][index] = texel[3];
+            }
+
+            // Average the chroma of every 2x2 quad, quads at the edges may be partial
+            if (isSubsampled && ((y & 1) == 1 || y == height - 1))
+            {
+                uint32_t rows = (y & 1) + 1;
+                for (uint32_t x = 0; x < halfWidth; x++)
+                {
+                    uint32_t count = rows * std::min(2u, width - x * 2);
+                    size_t index = size_t(y / 2) * halfWidth + x;
+                    planes[1][index] = uint8_t((chromaSums[x * 2] + count / 2) / count);
+                    planes[2][index] = uint8_t((chromaSums[x * 2 + 1] + count / 2) / count);
+                }
+                std::fill(chromaSums.begin(), chromaSums.end(), 0u);
+            }
+        }
+
+        std::vector<uint8_t> residuals;
+        for (uint32_t p = 0; p < numPlanes; p++)
+        {
+            size_t offset = residuals.size();
+            residuals.resize(offset + planes[p].size());
+            EncodePlane(planes[p].data(), planeSizes[p].width, planeSizes[p].height, header.nearLossless, residuals.data() + offset);
+        }
+        header.residualSize = uint32_t(residuals.size());
+
+        // The residuals are bytes, there is nothing to shuffle
+        TileEncoderDesc residualEncoder = encoder;
+        residualEncoder.shuffle = false;
+        std::vector<uint8_t> encoded;
+        uint32_t flags = EncodeTile(residualEncoder, 1, residuals.data(), residuals.size(), encoded);
+
+        output.resize(sizeof(header));
+        memcpy(output.data(), &header, sizeof(header));
+        output.insert(output.end(), encoded.begin(), encoded.end());
+        return flags | TileFlagTranscode;
+    }
+
+    bool DecodeIntermediateTile(uint32_t flags, const uint8_t* data, size_t storedSize, std::vector<uint8_t>& rgba,
+        uint32_t& width, uint32_t& height)
+    {
+        IntermediateHeader header;
+        if ((flags & TileFlagTranscode) == 0 || storedSize < sizeof(header))
+            return false;
+        memcpy(&header, data, sizeof(header));
+
+        PlaneSize planeSizes[4];
+        uint32_t numPlanes = GetPlanes(header, planeSizes);
+        size_t expectedSize = 0;
+        for (uint32_t p = 0; p < numPlanes; p++)
+            expectedSize += size_t(planeSizes[p].width) * planeSizes[p].height;
+        if (numPlanes == 0 || header.width == 0 || header.height == 0 || header.residualSize != expectedSize)
+            return false;
+
+        thread_local std::vector<uint8_t> residuals;
+        thread_local std::vector<uint8_t> planeData;
+        residuals.resize(header.residualSize);
+        planeData.resize(header.residualSize);
+        if (!DecodeTile(flags & ~TileFlagTranscode, 1, data + sizeof(header), storedSize - sizeof(header), residuals.data(), residuals.size()))
+            return false;
+
+        const uint8_t* planes[4];
+        size_t offset = 0;
+        for (uint32_t p = 0; p < numPlanes; p++)
+        {
+            DecodePlane(residuals.data() + offset, planeSizes[p].width, planeSizes[p].height, header.nearLossless, planeData.data() + offset);
+            planes[p] = planeData.data() + offset;
+            offset += size_t(planeSizes[p].width) * planeSizes[p].height;
+        }
+
+        width = header.width;
+        height = header.height;
+        rgba.resize(size_t(width) * height * 4);
+
+        uint32_t chromaWidth = planeSizes[1].width;
+        for (uint32_t y = 0; y < height; y++)
+        {
+            uint8_t* row = rgba.data() + size_t(y) * width * 4;
+            const uint8_t* alpha = header.hasAlpha ? planes[numPlanes - 1] + size_t(y) * width : nullptr;
+            switch (IntermediateLayout(header.layout))
+            {
+            case IntermediateLayout::RG:
+                ConvertRowFromRG(planes[0] + size_t(y) * width, planes[1] + size_t(y) * width, width, row);
+                break;
+            case IntermediateLayout::YCoCg444:
+                ConvertRowFromYCoCg<0>(planes[0] + size_t(y) * width, planes[1] + size_t(y) * width, planes[2] + size_t(y) * width, width, row);
+                break;
+            default:
+                ConvertRowFromYCoCg<1>(planes[0] + size_t(y) * width, planes[1] + size_t(y / 2) * chromaWidth, planes[2] + size_t(y / 2) * chromaWidth, width, row);
+                break;
+            }
+
+            for (uint32_t x = 0; x < width; x++)
+                row[x * 4 + 3] = alpha ? alpha[x] : 255;
+        }
+
+        return true;
+    }
+
+    bool TranscodeTile(uint32_t flags, uint32_t dxgiFormat, BcQuality quality, const uint8_t* data, size_t storedSize,
+        uint8_t* dest, size_t size)
+    {
+        BcFormat format;
+        if (!GetBcFormat(dxgiFormat, format))
+            return false;
+
+        // Tiles of a single color store just that texel, every block of the tile is the same
+        if (flags & TileFlagUniform)
+        {
+            uint32_t bytesPerBlock = GetBcBytesPerBlock(format);
+            if (storedSize != 4 || size % bytesPerBlock != 0)
+                return false;
+
+            uint8_t texels[16 * 4];
+            for (uint32_t i = 0; i < 16; i++)
+                memcpy(texels + i * 4, data, 4);
+            uint8_t block[16];
+            EncodeBcBlock(format, quality, texels, block);
+            for (size_t offset = 0; offset < size; offset += bytesPerBlock)
+                memcpy(dest + offset, block, bytesPerBlock);
+            return true;
+        }
+
+        thread_local std::vector<uint8_t> rgba;
+        uint32_t width, height;
+        if (!DecodeIntermediateTile(flags, data, storedSize, rgba, width, height))
+            return false;
+
+        size_t rowPitch = size_t((width + 3) / 4) * GetBcBytesPerBlock(format);
+        if (rowPitch * ((height + 3) / 4) != size)
+            return false;
+
+        EncodeBcImage(format, quality, rgba.data(), width, height, size_t(width) * 4, dest, rowPitch);
+        return true;
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "BcEncoder.h"
+#include "TileCodec.h"
+
+// Tiles stored in an intermediate form and transcoded to BCn when they are loaded
+//
+// The intermediate stores the texels instead of BC blocks, which compresses a lot better: the color is converted to
+// YCoCg, optionally with the chroma at half resolution, every plane is predicted from its neighbours with the
+// LOCO-I median predictor and the residuals are compressed with the tile codec. A near lossless setting quantizes
+// the residuals, bounding the error of every plane value. Stored tiles carry TileFlagTranscode on top of the codec
+// flags and decode to the BC blocks of the texture format, the encoding quality is chosen at load time.
+
+namespace tilestream
+{
+    struct IntermediateDesc
+    {
+        uint32_t nearLossless = 0;   // Largest error of a plane value, 0 is lossless apart from the color conversion
+        bool subsampleChroma = true; // Store the chroma at half resolution in both dimensions
+    };
+
+    // Encodes width by height RGBA8 texels for the given target format and returns the flags of the stored tile.
+    // BC5 only keeps red and green, BC1 drops alpha.
+    uint32_t EncodeIntermediateTile(const TileEncoderDesc& encoder, const IntermediateDesc& desc, BcFormat format,
+        const uint8_t* rgba, uint32_t width, uint32_t height, size_t rgbaRowPitch, std::vector<uint8_t>& output);
+
+    // Decodes an intermediate tile to RGBA8, rgba receives width * height texels, tightly packed
+    bool DecodeIntermediateTile(uint32_t flags, const uint8_t* data, size_t storedSize, std::vector<uint8_t>& rgba,
+        uint32_t& width, uint32_t& height);
+
+    // Decodes an intermediate tile and encodes it to the BC format matching dxgiFormat. size must be the size of the
+    // BC blocks covering the tile, dest is written once and sequentially like with DecodeTile.
+    // Tiles of a single color are stored as one RGBA8 texel with TileFlagUniform, which needs no intermediate.
+    bool TranscodeTile(uint32_t flags, uint32_t dxgiFormat, BcQuality quality, const uint8_t* data, size_t storedSize,
+        uint8_t* dest, size_t size);
+}
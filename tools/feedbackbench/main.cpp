@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+
+// Measures the cost of merging feedback injected from the CPU with sampler feedback readbacks, as done by
+// FeedbackManager::BeginFrame for every texture with injected feedback
+//
+//   feedbackbench [--textures N] [--regions WxH] [--slices N] [--rects N] [--views N]
+
+#include "../../src/feedbackmanager/src/FeedbackMerge.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace nvfeedback;
+
+namespace
+{
+    void PrintUsage()
+    {
+        printf("Usage:\n");
+        printf("  feedbackbench [--textures N] [--regions WxH] [--slices N] [--rects N] [--views N]\n");
+    }
+
+    double Seconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Readback like grids, mostly unrequested with patches of neighboring mips
+    void FillFeedbackGrid(std::mt19937& random, uint32_t regionsX, uint32_t regionsY, uint8_t* grid)
+    {
+        std::uniform_int_distribution<uint32_t> mipDistribution(0, 7);
+        for (uint32_t y = 0; y < regionsY; y++)
+        {
+            for (uint32_t x = 0; x < regionsX; x++)
+            {
+                bool requested = ((x / 8) + (y / 8)) % 3 != 0;
+                grid[size_t(y) * regionsX + x] = requested ? uint8_t(mipDistribution(random)) : 0xFF;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numTextures = 1024;
+    uint32_t regionsX = 64;
+    uint32_t regionsY = 64;
+    uint32_t numSlices = 1;
+    uint32_t numRects = 16;
+    uint32_t numViews = 2;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--textures") && i + 1 < argc)
+            numTextures = std::max(uint32_t(atoi(argv[++i])), 1u);
+        else if (!strcmp(argv[i], "--regions") && i + 1 < argc)
+        {
+            if (sscanf(argv[++i], "%ux%u", &regionsX, &regionsY) != 2 || !regionsX || !regionsY)
+            {
+                PrintUsage();
+                return 1;
+            }
+        }
+        else if (!strcmp(argv[i], "--slices") && i + 1 < argc)
+            numSlices = std::max(uint32_t(atoi(argv[++i])), 1u);
+        else if (!strcmp(argv[i], "--rects") && i + 1 < argc)
+            numRects = uint32_t(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--views") && i + 1 < argc)
+            numViews = std::min(uint32_t(atoi(argv[++i])), 255u);
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    size_t sliceRegionsNum = size_t(regionsX) * regionsY;
+    size_t regionsNum = sliceRegionsNum * numSlices;
+    printf("%u textures, %ux%u regions, %u slices, %u injected rectangles per texture, %u extra views\n", numTextures, regionsX, regionsY, numSlices, numRects, numViews);
+
+    std::mt19937 random(1);
+    std::vector<uint8_t> readbacks(regionsNum * numTextures);
+    for (size_t slice = 0; slice < size_t(numTextures) * numSlices; slice++)
+        FillFeedbackGrid(random, regionsX, regionsY, readbacks.data() + slice * sliceRegionsNum);
+
+    // Injected grids are built from rectangles, as InjectFeedback does
+    struct Rect
+    {
+        uint32_t x0, y0, x1, y1;
+        uint8_t mip;
+    };
+    std::vector<Rect> rects(size_t(numRects) * numTextures);
+    std::uniform_int_distribution<uint32_t> xDistribution(0, regionsX - 1);
+    std::uniform_int_distribution<uint32_t> yDistribution(0, regionsY - 1);
+    std::uniform_int_distribution<uint32_t> mipDistribution(0, 7);
+    for (Rect& rect : rects)
+    {
+        uint32_t xa = xDistribution(random), xb = xDistribution(random);
+        uint32_t ya = yDistribution(random), yb = yDistribution(random);
+        rect = { std::min(xa, xb), std::min(ya, yb), std::max(xa, xb) + 1, std::max(ya, yb) + 1, uint8_t(mipDistribution(random)) };
+    }
+
+    std::vector<uint8_t> injected(regionsNum * numTextures);
+    auto injectRects = [&]()
+    {
+        std::fill(injected.begin(), injected.end(), uint8_t(0xFF));
+        for (uint32_t texture = 0; texture < numTextures; texture++)
+        {
+            for (uint32_t slice = 0; slice < numSlices; slice++)
+            {
+                uint8_t* grid = injected.data() + texture * regionsNum + slice * sliceRegionsNum;
+                for (uint32_t i = 0; i < numRects; i++)
+                {
+                    const Rect& rect = rects[size_t(texture) * numRects + i];
+                    MergeMinMipRect(grid, regionsX, rect.x0, rect.y0, rect.x1, rect.y1, rect.mip);
+                }
+            }
+        }
+    };
+
+    // Grids of extra views, such as split-screen players or reflections at lower detail, merged with a mip bias
+    std::vector<uint8_t> viewGrids(readbacks.size() * numViews);
+    for (size_t slice = 0; slice < size_t(numTextures) * numSlices * numViews; slice++)
+        FillFeedbackGrid(random, regionsX, regionsY, viewGrids.data() + slice * sliceRegionsNum);
+    auto viewMipBias = [](uint32_t view) { return int32_t(view % 3) - 1; };
+
+    // Reference results
+    injectRects();
+    std::vector<uint8_t> expected(readbacks);
+    for (size_t i = 0; i < expected.size(); i++)
+        expected[i] = std::min(expected[i], injected[i]);
+
+    std::vector<uint8_t> expectedViewMips(expected);
+    std::vector<uint8_t> expectedViews(expected.size(), 0);
+    for (uint32_t view = 0; view < numViews; view++)
+    {
+        const uint8_t* viewMips = viewGrids.data() + size_t(view) * readbacks.size();
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            if (viewMips[i] == 0xFF)
+                continue;
+            uint8_t mip = uint8_t(std::clamp(int32_t(viewMips[i]) + viewMipBias(view), 0, 0xFE));
+            if (mip < expectedViewMips[i])
+            {
+                expectedViewMips[i] = mip;
+                expectedViews[i] = uint8_t(view + 1);
+            }
+        }
+    }
+    std::vector<uint8_t> regionViews(readbacks.size());
+
+    std::vector<uint8_t> merged(readbacks.size());
+    bool valid = true;
+
+    // Every pass merges all textures, repeated until the measurement is long enough
+    uint64_t numPasses = 0;
+    double injectSeconds = 0.0;
+    double mergeSeconds = 0.0;
+    double viewsSeconds = 0.0;
+    auto benchStart = std::chrono::steady_clock::now();
+    do
+    {
+        auto start = std::chrono::steady_clock::now();
+        injectRects();
+        injectSeconds += Seconds(start);
+
+        memcpy(merged.data(), readbacks.data(), readbacks.size());
+        start = std::chrono::steady_clock::now();
+        for (uint32_t texture = 0; texture < numTextures; texture++)
+            MergeMinMips(merged.data() + texture * regionsNum, injected.data() + texture * regionsNum, regionsNum);
+        mergeSeconds += Seconds(start);
+
+        if (merged != expected)
+            valid = false;
+
+        if (numViews > 0)
+        {
+            std::fill(regionViews.begin(), regionViews.end(), uint8_t(0));
+            start = std::chrono::steady_clock::now();
+            for (uint32_t texture = 0; texture < numTextures; texture++)
+            {
+                for (uint32_t view = 0; view < numViews; view++)
+                {
+                    const uint8_t* viewMips = viewGrids.data() + size_t(view) * readbacks.size() + texture * regionsNum;
+                    MergeViewMinMips(merged.data() + texture * regionsNum, regionViews.data() + texture * regionsNum, viewMips, regionsNum,
+                        viewMipBias(view), uint8_t(view + 1));
+                }
+            }
+            viewsSeconds += Seconds(start);
+
+            if (merged != expectedViewMips || regionViews != expectedViews)
+                valid = false;
+        }
+        numPasses++;
+    } while (Seconds(benchStart) < 1.0);
+
+    double mergedBytes = double(readbacks.size()) * double(numPasses);
+    printf("%-8s %14s %12s\n", "stage", "us/texture", "MiB/s");
+    printf("%-8s %14.3f %12s\n", "inject", injectSeconds * 1e6 / double(numPasses) / numTextures, "");
+    printf("%-8s %14.3f %12.0f\n", "merge", mergeSeconds * 1e6 / double(numPasses) / numTextures, mergedBytes / mergeSeconds / (1024.0 * 1024.0));
+    if (numViews > 0)
+        printf("%-8s %14.3f %12.0f\n", "views", viewsSeconds * 1e6 / double(numPasses) / numTextures, mergedBytes * numViews / viewsSeconds / (1024.0 * 1024.0));
+    printf("merge of all %u textures: %.3f ms per frame%s\n", numTextures, (mergeSeconds + viewsSeconds) * 1e3 / double(numPasses), valid ? "" : "  FAILED");
+
+    return valid ? 0 : 1;
+}
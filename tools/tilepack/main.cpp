@@ -0,0 +1,937 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: LicenseRef-NvidiaProprietary
+ *
+ * NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+ * property and proprietary rights in and to this material, related
+ * documentation and any modifications thereto. Any use, reproduction,
+ * disclosure or distribution of this material and related documentation
+ * without an express license agreement from NVIDIA CORPORATION or
+ * its affiliates is strictly prohibited.
+ */
+
+// Converts DDS textures to tile packs, the streaming optimized container read by the sample
+//
+//   tilepack convert <file.dds | directory> [-o output.tilepack] [--standard-mips N] [--codec name] [--level N] [--no-shuffle]
+//                    [--transcode bc1|bc3|bc5|bc7] [--near-lossless N] [--full-chroma]
+//   tilepack info <file.tilepack>
+//   tilepack verify <file.dds> <file.tilepack>
+//   tilepack stream <file.tilepack> [--threads N] [--no-io-uring] [--max-in-flight MiB]
+//   tilepack bench <file.dds> [--threads N] [--level N]
+//   tilepack transcode-bench <rgba8.dds> [--threads N] [--codec name] [--near-lossless N] [--full-chroma]
+
+#include "../../src/tilestream/BcEncoder.h"
+#include "../../src/tilestream/DdsFile.h"
+#include "../../src/tilestream/IoScheduler.h"
+#include "../../src/tilestream/MappedFile.h"
+#include "../../src/tilestream/TileCodec.h"
+#include "../../src/tilestream/TilePack.h"
+#include "../../src/tilestream/TileTranscoder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace tilestream;
+
+namespace
+{
+    void PrintUsage()
+    {
+        printf("Usage:\n");
+        printf("  tilepack convert <file.dds | directory> [-o output.tilepack] [--standard-mips N] [--codec name] [--level N] [--no-shuffle]\n");
+        printf("                   [--transcode bc1|bc3|bc5|bc7] [--near-lossless N] [--full-chroma]\n");
+        printf("  tilepack info <file.tilepack>\n");
+        printf("  tilepack verify <file.dds> <file.tilepack>\n");
+        printf("  tilepack stream <file.tilepack> [--threads N] [--no-io-uring] [--max-in-flight MiB]\n");
+        printf("  tilepack bench <file.dds> [--threads N] [--level N]\n");
+        printf("  tilepack transcode-bench <rgba8.dds> [--threads N] [--codec name] [--near-lossless N] [--full-chroma]\n");
+        printf("Codecs:");
+        for (uint32_t codec = 0; codec < uint32_t(TileCodec::Count); codec++)
+        {
+            if (IsTileCodecAvailable(TileCodec(codec)))
+                printf(" %s", GetTileCodecName(TileCodec(codec)));
+        }
+        printf(" (default %s)\n", GetTileCodecName(TileEncoderDesc().codec));
+    }
+
+    bool ParseCodecArgument(const char* name, TileCodec& codec)
+    {
+        if (!ParseTileCodec(name, codec))
+        {
+            fprintf(stderr, "Unknown codec '%s'\n", name);
+            return false;
+        }
+        if (!IsTileCodecAvailable(codec))
+        {
+            fprintf(stderr, "Codec '%s' is not available in this build\n", name);
+            return false;
+        }
+        return true;
+    }
+
+    bool ParseTranscodeArgument(const char* name, BcFormat& format)
+    {
+        if (!ParseBcFormat(name, format))
+        {
+            fprintf(stderr, "Unknown transcode format '%s'\n", name);
+            return false;
+        }
+        return true;
+    }
+
+    bool IsDdsFile(const std::filesystem::path& path)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return char(tolower(c)); });
+        return extension == ".dds";
+    }
+
+    bool ConvertFile(const std::filesystem::path& inputPath, const std::filesystem::path& outputPath, const TilePackWriterDesc& desc)
+    {
+        MappedFile file;
+        if (!file.Open(inputPath))
+        {
+            fprintf(stderr, "%s: can't open file\n", inputPath.string().c_str());
+            return false;
+        }
+
+        DdsTextureInfo info;
+        if (!ParseDdsFile(file.GetData(), file.GetSize(), info))
+        {
+            fprintf(stderr, "%s: not a supported DDS file\n", inputPath.string().c_str());
+            return false;
+        }
+
+        std::vector<uint8_t> output;
+        std::string error;
+        if (!WriteTilePack(info, file.GetData(), desc, output, error))
+        {
+            fprintf(stderr, "%s: %s\n", inputPath.string().c_str(), error.c_str());
+            return false;
+        }
+
+        if (!WriteWholeFile(outputPath, output.data(), output.size()))
+        {
+            fprintf(stderr, "%s: can't write file\n", outputPath.string().c_str());
+            return false;
+        }
+
+        printf("%s -> %s (%ux%u, %u mips, %llu KiB, %.1f%% of the DDS file)\n", inputPath.string().c_str(), outputPath.string().c_str(),
+            info.width, info.height, info.mipLevels, (unsigned long long)(output.size() / 1024), 100.0 * double(output.size()) / double(file.GetSize()));
+        return true;
+    }
+
+    int Convert(int argc, char** argv)
+    {
+        std::filesystem::path inputPath;
+        std::filesystem::path outputPath;
+        TilePackWriterDesc desc;
+
+        for (int i = 0; i < argc; i++)
+        {
+            if (!strcmp(argv[i], "-o") && i + 1 < argc)
+                outputPath = argv[++i];
+            else if (!strcmp(argv[i], "--standard-mips") && i + 1 < argc)
+                desc.numStandardMips = atoi(argv[++i]);
+            else if (!strcmp(argv[i], "--codec") && i + 1 < argc)
+            {
+                if (!ParseCodecArgument(argv[++i], desc.encoder.codec))
+                    return 1;
+            }
+            else if (!strcmp(argv[i], "--level") && i + 1 < argc)
+                desc.encoder.level = atoi(argv[++i]);
+            else if (!strcmp(argv[i], "--no-shuffle"))
+                desc.encoder.shuffle = false;
+            else if (!strcmp(argv[i], "--transcode") && i + 1 < argc)
+            {
+                if (!ParseTranscodeArgument(argv[++i], desc.transcodeFormat))
+                    return 1;
+            }
+            else if (!strcmp(argv[i], "--near-lossless") && i + 1 < argc)
+                desc.intermediate.nearLossless = uint32_t(atoi(argv[++i]));
+            else if (!strcmp(argv[i], "--full-chroma"))
+                desc.intermediate.subsampleChroma = false;
+            else if (inputPath.empty())
+                inputPath = argv[i];
+            else
+            {
+                PrintUsage();
+                return 1;
+            }
+        }
+
+        if (inputPath.empty())
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        if (!std::filesystem::is_directory(inputPath))
+        {
+            if (outputPath.empty())
+                outputPath = std::filesystem::path(inputPath).replace_extension(".tilepack");
+            return ConvertFile(inputPath, outputPath, desc) ? 0 : 1;
+        }
+
+        // Convert all DDS files of a directory tree, writing the packs next to the sources
+        uint32_t numConverted = 0;
+        uint32_t numFailed = 0;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(inputPath))
+        {
+            if (!entry.is_regular_file() || !IsDdsFile(entry.path()))
+                continue;
+
+            if (ConvertFile(entry.path(), std::filesystem::path(entry.path()).replace_extension(".tilepack"), desc))
+                numConverted++;
+            else
+                numFailed++;
+        }
+
+        printf("Converted %u files, %u failed\n", numConverted, numFailed);
+        return numFailed == 0 ? 0 : 1;
+    }
+
+    int Info(int argc, char** argv)
+    {
+        if (argc != 1)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        TilePackReader reader;
+        if (!reader.Open(argv[0]))
+        {
+            fprintf(stderr, "%s: not a valid tile pack\n", argv[0]);
+            return 1;
+        }
+
+        const TilePackHeader& header = reader.GetHeader();
+        printf("Format:        DXGI %u (%ux%u blocks, %u bytes)\n", header.dxgiFormat, header.blockSize, header.blockSize, header.bytesPerBlock);
+        printf("Size:          %ux%u, %u slices, %u mips\n", header.width, header.height, header.arraySize, header.mipLevels);
+        printf("Tile shape:    %ux%u texels\n", header.tileWidthInTexels, header.tileHeightInTexels);
+        printf("Tiles:         %u in %u standard mips\n", header.numTiles, header.numStandardMips);
+        printf("Codec:         %s\n", GetTileCodecName(TileCodec(header.codec)));
+
+        const TilePackSubresource& lastMip = reader.GetSubresource(0, header.mipLevels - 1);
+        uint32_t firstFlags = header.numTiles > 0 ? reader.GetTile(0, 0, 0, 0)->flags : lastMip.packedFlags;
+        BcFormat bcFormat;
+        if ((firstFlags & TileFlagTranscode) && GetBcFormat(header.dxgiFormat, bcFormat))
+            printf("Transcoded:    intermediate tiles encoded to %s when read\n", GetBcFormatName(bcFormat));
+
+        // Tiles with the same content share their stored data, uniform tiles store a single block
+        uint32_t numUniformTiles = 0;
+        std::unordered_set<uint64_t> storedOffsets;
+        std::unordered_set<uint64_t> contentHashes;
+        for (uint32_t arraySlice = 0; arraySlice < header.arraySize; arraySlice++)
+        {
+            for (uint32_t mip = 0; mip < header.numStandardMips; mip++)
+            {
+                const TilePackSubresource& subresource = reader.GetSubresource(arraySlice, mip);
+                for (uint32_t tileY = 0; tileY < subresource.heightInTiles; tileY++)
+                {
+                    for (uint32_t tileX = 0; tileX < subresource.widthInTiles; tileX++)
+                    {
+                        const TilePackTileEntry* tile = reader.GetTile(arraySlice, mip, tileX, tileY);
+                        storedOffsets.insert(tile->offset);
+                        contentHashes.insert(tile->contentHash);
+                        if (tile->flags & TileFlagUniform)
+                            numUniformTiles++;
+                    }
+                }
+            }
+        }
+        printf("Unique tiles:  %zu stored, %zu distinct contents, %u uniform\n", storedOffsets.size(), contentHashes.size(), numUniformTiles);
+
+        for (uint32_t mip = 0; mip < header.mipLevels; mip++)
+        {
+            const TilePackSubresource& subresource = reader.GetSubresource(0, mip);
+            if (mip < header.numStandardMips)
+            {
+                uint64_t size = 0;
+                uint64_t storedSize = 0;
+                for (uint32_t tileY = 0; tileY < subresource.heightInTiles; tileY++)
+                {
+                    for (uint32_t tileX = 0; tileX < subresource.widthInTiles; tileX++)
+                    {
+                        const TilePackTileEntry* tile = reader.GetTile(0, mip, tileX, tileY);
+                        size += tile->size;
+                        storedSize += tile->storedSize;
+                    }
+                }
+                printf("  mip %2u: %5ux%-5u %ux%u tiles, stored %.1f%%\n", mip, subresource.width, subresource.height,
+                    subresource.widthInTiles, subresource.heightInTiles, 100.0 * double(storedSize) / double(std::max<uint64_t>(size, 1)));
+            }
+            else
+                printf("  mip %2u: %5ux%-5u packed, %llu bytes, stored %llu\n", mip, subresource.width, subresource.height,
+                    (unsigned long long)subresource.packedSize, (unsigned long long)subresource.packedStoredSize);
+        }
+
+        return 0;
+    }
+
+    // Transcoded packs are lossy, decodes every tile and packed mip and measures the error against the RGBA8 source
+    int VerifyTranscoded(const MappedFile& file, const DdsTextureInfo& info, const TilePackReader& reader)
+    {
+        const TilePackHeader& header = reader.GetHeader();
+        BcFormat format;
+        if (!GetBcFormat(header.dxgiFormat, format) || (info.dxgiFormat != 28 && info.dxgiFormat != 29))
+        {
+            fprintf(stderr, "Texture formats don't match\n");
+            return 1;
+        }
+
+        // BC5 only keeps red and green, BC1 has no alpha
+        uint32_t numChannels = format == BcFormat::BC5 ? 2 : (format == BcFormat::BC1 ? 3 : 4);
+        uint32_t numRegions = 0;
+        uint32_t numFailed = 0;
+        double squaredError = 0.0;
+        uint64_t numValues = 0;
+        std::vector<uint8_t> blocks;
+
+        auto measureRegion = [&](const TileRegion& region)
+        {
+            const DdsSubresourceLayout& layout = info.subresources[region.arraySlice * info.mipLevels + region.mip];
+            uint32_t rowPitch = reader.GetRowPitch(region.width);
+            blocks.resize(size_t(reader.GetSizeInBytes(region.width, region.height)));
+
+            numRegions++;
+            if (!reader.ReadRegion(region, blocks.data(), rowPitch))
+            {
+                fprintf(stderr, "Failed to read slice %u mip %u region (%u, %u) %ux%u\n", region.arraySlice, region.mip, region.x, region.y, region.width, region.height);
+                numFailed++;
+                return;
+            }
+
+            uint8_t texels[64];
+            for (uint32_t blockY = 0; blockY * 4 < region.height; blockY++)
+            {
+                for (uint32_t blockX = 0; blockX * 4 < region.width; blockX++)
+                {
+                    DecodeBcBlock(format, blocks.data() + size_t(blockY) * rowPitch + size_t(blockX) * header.bytesPerBlock, texels);
+                    for (uint32_t y = 0; y < 4; y++)
+                    {
+                        for (uint32_t x = 0; x < 4; x++)
+                        {
+                            uint32_t texelX = region.x + blockX * 4 + x;
+                            uint32_t texelY = region.y + blockY * 4 + y;
+                            if (texelX >= layout.width || texelY >= layout.height)
+                                continue;
+
+                            const uint8_t* source = file.GetData() + layout.dataOffset + texelY * layout.rowPitch + uint64_t(texelX) * 4;
+                            for (uint32_t c = 0; c < numChannels; c++)
+                            {
+                                double diff = double(source[c]) - double(texels[(y * 4 + x) * 4 + c]);
+                                squaredError += diff * diff;
+                            }
+                            numValues += numChannels;
+                        }
+                    }
+                }
+            }
+        };
+
+        for (uint32_t arraySlice = 0; arraySlice < header.arraySize; arraySlice++)
+        {
+            for (uint32_t mip = 0; mip < header.mipLevels; mip++)
+            {
+                const TilePackSubresource& subresource = reader.GetSubresource(arraySlice, mip);
+                if (subresource.widthInTiles == 0)
+                    measureRegion({ arraySlice, mip, 0, 0, subresource.width, subresource.height });
+
+                for (uint32_t tileY = 0; tileY < subresource.heightInTiles; tileY++)
+                    for (uint32_t tileX = 0; tileX < subresource.widthInTiles; tileX++)
+                        measureRegion(reader.GetTileRegion(arraySlice, mip, tileX, tileY));
+            }
+        }
+
+        double meanSquaredError = squaredError / double(std::max<uint64_t>(numValues, 1));
+        double psnr = meanSquaredError > 0.0 ? 10.0 * log10(255.0 * 255.0 / meanSquaredError) : 99.0;
+        printf("Verified %u regions transcoded to %s, %u failed, PSNR %.2f dB\n", numRegions, GetBcFormatName(format), numFailed, psnr);
+
+        // Anything below this points at a broken transcode rather than the loss of the encoders
+        constexpr double MinPsnr = 30.0;
+        return (numFailed == 0 && psnr >= MinPsnr) ? 0 : 1;
+    }
+
+    // Compares every tile and packed mip, as well as regions not aligned to tiles, with the source DDS file
+    int Verify(int argc, char** argv)
+    {
+        if (argc != 2)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        MappedFile file;
+        DdsTextureInfo info;
+        if (!file.Open(argv[0]) || !ParseDdsFile(file.GetData(), file.GetSize(), info))
+        {
+            fprintf(stderr, "%s: not a supported DDS file\n", argv[0]);
+            return 1;
+        }
+
+        TilePackReader reader;
+        if (!reader.Open(argv[1]))
+        {
+            fprintf(stderr, "%s: not a valid tile pack\n", argv[1]);
+            return 1;
+        }
+
+        const TilePackHeader& header = reader.GetHeader();
+        if (header.width != info.width || header.height != info.height || header.mipLevels != info.mipLevels || header.arraySize != info.arraySize)
+        {
+            fprintf(stderr, "Texture dimensions don't match\n");
+            return 1;
+        }
+
+        if (header.dxgiFormat != info.dxgiFormat)
+            return VerifyTranscoded(file, info, reader);
+
+        uint32_t numRegions = 0;
+        uint32_t numMismatches = 0;
+        std::vector<uint8_t> expected;
+        std::vector<uint8_t> actual;
+
+        auto compareRegion = [&](const TileRegion& region)
+        {
+            const DdsSubresourceLayout& layout = info.subresources[region.arraySlice * info.mipLevels + region.mip];
+            uint32_t rowPitch = reader.GetRowPitch(region.width);
+            uint32_t widthInBlocks = rowPitch / info.bytesPerBlock;
+            uint32_t heightInBlocks = (region.height + info.blockSize - 1) / info.blockSize;
+
+            expected.assign(size_t(rowPitch) * heightInBlocks, 0);
+            actual.assign(expected.size(), 0xCD);
+            CopyBlockRect(file.GetData() + layout.dataOffset, layout.rowPitch, region.x / info.blockSize, region.y / info.blockSize,
+                expected.data(), rowPitch, 0, 0, widthInBlocks, heightInBlocks, info.bytesPerBlock);
+
+            numRegions++;
+            if (!reader.ReadRegion(region, actual.data(), rowPitch) || expected != actual)
+            {
+                fprintf(stderr, "Mismatch in slice %u mip %u region (%u, %u) %ux%u\n", region.arraySlice, region.mip, region.x, region.y, region.width, region.height);
+                numMismatches++;
+            }
+        };
+
+        for (uint32_t arraySlice = 0; arraySlice < header.arraySize; arraySlice++)
+        {
+            for (uint32_t mip = 0; mip < header.mipLevels; mip++)
+            {
+                const TilePackSubresource& subresource = reader.GetSubresource(arraySlice, mip);
+                uint32_t alignedWidth = (subresource.width + info.blockSize - 1) / info.blockSize * info.blockSize;
+                uint32_t alignedHeight = (subresource.height + info.blockSize - 1) / info.blockSize * info.blockSize;
+
+                // Whole mip
+                compareRegion({ arraySlice, mip, 0, 0, alignedWidth, alignedHeight });
+
+                // Every stored tile
+                for (uint32_t tileY = 0; tileY < subresource.heightInTiles; tileY++)
+                    for (uint32_t tileX = 0; tileX < subresource.widthInTiles; tileX++)
+                        compareRegion(reader.GetTileRegion(arraySlice, mip, tileX, tileY));
+
+                // A region straddling tile boundaries
+                if (alignedWidth > info.blockSize && alignedHeight > info.blockSize)
+                {
+                    uint32_t x = (alignedWidth / 2) / info.blockSize * info.blockSize;
+                    uint32_t y = (alignedHeight / 3) / info.blockSize * info.blockSize;
+                    compareRegion({ arraySlice, mip, x, y, alignedWidth - x, alignedHeight - y });
+                }
+            }
+        }
+
+        printf("Verified %u regions, %u mismatches\n", numRegions, numMismatches);
+        return numMismatches == 0 ? 0 : 1;
+    }
+
+    // Reads all tiles of a pack in random order through the asynchronous scheduler and checks them against plain reads
+    int Stream(int argc, char** argv)
+    {
+        const char* path = nullptr;
+        IoSchedulerDesc desc;
+
+        for (int i = 0; i < argc; i++)
+        {
+            if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+                desc.numThreads = uint32_t(atoi(argv[++i]));
+            else if (!strcmp(argv[i], "--no-io-uring"))
+                desc.useIoUring = false;
+            else if (!strcmp(argv[i], "--max-in-flight") && i + 1 < argc)
+                desc.maxBytesInFlight = uint64_t(atoi(argv[++i])) << 20;
+            else if (!path)
+                path = argv[i];
+            else
+            {
+                PrintUsage();
+                return 1;
+            }
+        }
+
+        TilePackReader reader;
+        if (!path || !reader.Open(path))
+        {
+            fprintf(stderr, "%s: not a valid tile pack\n", path ? path : "");
+            return 1;
+        }
+
+        const TilePackHeader& header = reader.GetHeader();
+        std::vector<IoRequest> requests(header.numTiles);
+        std::vector<const TilePackTileEntry*> tiles;
+        for (uint32_t arraySlice = 0; arraySlice < header.arraySize; arraySlice++)
+        {
+            for (uint32_t mip = 0; mip < header.numStandardMips; mip++)
+            {
+                const TilePackSubresource& subresource = reader.GetSubresource(arraySlice, mip);
+                for (uint32_t tileY = 0; tileY < subresource.heightInTiles; tileY++)
+                    for (uint32_t tileX = 0; tileX < subresource.widthInTiles; tileX++)
+                        tiles.push_back(reader.GetTile(arraySlice, mip, tileX, tileY));
+            }
+        }
+
+        // Tiles are requested in a random order, neighbours which end up in flight together get merged
+        std::mt19937 random(1234);
+        std::shuffle(tiles.begin(), tiles.end(), random);
+
+        std::vector<uint8_t> data(size_t(tiles.size()) * TilePackTileSizeInBytes);
+        std::vector<std::vector<uint8_t>> storedData(tiles.size());
+        IoScheduler scheduler(desc);
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < tiles.size(); i++)
+        {
+            IoRequest& request = requests[i];
+            request.file = &reader.GetFile();
+            request.offset = tiles[i]->offset;
+            request.size = tiles[i]->storedSize;
+            request.dest = data.data() + i * TilePackTileSizeInBytes;
+
+            // Compressed tiles are read into their own buffer and decoded on the worker threads
+            if (tiles[i]->flags != 0)
+            {
+                storedData[i].resize(tiles[i]->storedSize);
+                request.dest = storedData[i].data();
+                request.postProcess = [tile = tiles[i], stored = storedData[i].data(), dest = data.data() + i * TilePackTileSizeInBytes, &header]()
+                {
+                    if (tile->flags & TileFlagTranscode)
+                        return TranscodeTile(tile->flags, header.dxgiFormat, BcQuality::Normal, stored, tile->storedSize, dest, tile->size);
+                    return DecodeTile(tile->flags, header.bytesPerBlock, stored, tile->storedSize, dest, tile->size);
+                };
+            }
+
+            scheduler.Submit(&request);
+        }
+
+        size_t numCompleted = 0;
+        size_t numFailed = 0;
+        while (numCompleted < tiles.size())
+        {
+            scheduler.Dispatch();
+            IoRequest* completed = scheduler.PopCompleted();
+            if (!completed)
+                std::this_thread::yield();
+
+            for (IoRequest* request = completed; request; request = request->next)
+            {
+                numCompleted++;
+                if (!request->success)
+                    numFailed++;
+            }
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        IoSchedulerStats stats = scheduler.GetStats();
+
+        uint64_t decodedBytes = 0;
+        for (const TilePackTileEntry* tile : tiles)
+            decodedBytes += tile->size;
+
+        std::vector<uint8_t> expected(TilePackTileSizeInBytes);
+        size_t numMismatches = 0;
+        for (size_t i = 0; i < tiles.size(); i++)
+        {
+            reader.ReadTile(*tiles[i], expected.data());
+            if (memcmp(expected.data(), data.data() + i * TilePackTileSizeInBytes, tiles[i]->size) != 0)
+                numMismatches++;
+        }
+
+        printf("Backend:       %s\n", scheduler.GetBackendName());
+        printf("Tiles:         %zu (%zu failed, %zu mismatches)\n", tiles.size(), numFailed, numMismatches);
+        printf("Reads issued:  %llu (%llu requests coalesced)\n", (unsigned long long)stats.readsIssued, (unsigned long long)stats.requestsCoalesced);
+        printf("Throughput:    %.1f MiB/s read, %.1f MiB/s decoded\n", double(stats.bytesRead) / (1024.0 * 1024.0) / seconds,
+            double(decodedBytes) / (1024.0 * 1024.0) / seconds);
+
+        return (numFailed == 0 && numMismatches == 0) ? 0 : 1;
+    }
+
+    // Measures the compression ratio and the compression and decompression throughput of every codec on the tiles of a texture
+    int Bench(int argc, char** argv)
+    {
+        const char* path = nullptr;
+        uint32_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        int level = 0;
+
+        for (int i = 0; i < argc; i++)
+        {
+            if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+                numThreads = std::max(uint32_t(atoi(argv[++i])), 1u);
+            else if (!strcmp(argv[i], "--level") && i + 1 < argc)
+                level = atoi(argv[++i]);
+            else if (!path)
+                path = argv[i];
+            else
+            {
+                PrintUsage();
+                return 1;
+            }
+        }
+
+        MappedFile file;
+        DdsTextureInfo info;
+        if (!path || !file.Open(path) || !ParseDdsFile(file.GetData(), file.GetSize(), info))
+        {
+            fprintf(stderr, "%s: not a supported DDS file\n", path ? path : "");
+            return 1;
+        }
+
+        // Cut the texture into tiles by writing an uncompressed pack in memory
+        TilePackWriterDesc writerDesc;
+        writerDesc.encoder.codec = TileCodec::None;
+        std::vector<uint8_t> pack;
+        std::string error;
+        if (!WriteTilePack(info, file.GetData(), writerDesc, pack, error))
+        {
+            fprintf(stderr, "%s: %s\n", path, error.c_str());
+            return 1;
+        }
+
+        TilePackHeader header;
+        memcpy(&header, pack.data(), sizeof(header));
+        std::vector<TilePackTileEntry> entries(header.numTiles);
+        memcpy(entries.data(), pack.data() + header.tileTableOffset, entries.size() * sizeof(TilePackTileEntry));
+        if (entries.empty())
+        {
+            fprintf(stderr, "%s: the texture has no standard tiles\n", path);
+            return 1;
+        }
+
+        uint64_t totalSize = 0;
+        for (const TilePackTileEntry& entry : entries)
+            totalSize += entry.size;
+
+        printf("%s: %zu tiles, %.1f MiB, %u threads\n", path, entries.size(), double(totalSize) / (1024.0 * 1024.0), numThreads);
+        printf("%-8s %-8s %7s %12s %12s %12s %14s\n", "codec", "shuffle", "stored", "comp MiB/s", "dec MiB/s", "dec MiB/s MT", "tiles/s/core");
+
+        auto seconds = [](std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        for (uint32_t codecIndex = 1; codecIndex < uint32_t(TileCodec::Count); codecIndex++)
+        {
+            TileCodec codec = TileCodec(codecIndex);
+            if (!IsTileCodecAvailable(codec))
+                continue;
+
+            for (bool shuffle : { false, true })
+            {
+                TileEncoderDesc encoder;
+                encoder.codec = codec;
+                encoder.level = level;
+                encoder.shuffle = shuffle;
+
+                // Compression, single threaded
+                std::vector<std::vector<uint8_t>> encoded(entries.size());
+                std::vector<uint32_t> flags(entries.size());
+                uint64_t storedSize = 0;
+                auto start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < entries.size(); i++)
+                {
+                    flags[i] = EncodeTile(encoder, header.bytesPerBlock, pack.data() + entries[i].offset, entries[i].size, encoded[i]);
+                    storedSize += encoded[i].size();
+                }
+                double compressSeconds = seconds(start);
+
+                // Decompression of all tiles by a number of threads, repeated until the measurement is long enough
+                std::vector<uint8_t> decoded(size_t(numThreads) * TilePackTileSizeInBytes);
+                std::atomic<bool> valid(true);
+                auto decompress = [&](uint32_t threadCount)
+                {
+                    // Every thread decodes its share of the tiles over and over, the passes of all threads are summed
+                    std::atomic<uint64_t> numPasses(0);
+                    auto passStart = std::chrono::steady_clock::now();
+                    std::vector<std::thread> threads;
+                    for (uint32_t thread = 0; thread < threadCount; thread++)
+                    {
+                        threads.emplace_back([&, thread]()
+                        {
+                            uint8_t* dest = decoded.data() + size_t(thread) * TilePackTileSizeInBytes;
+                            uint64_t threadPasses = 0;
+                            do
+                            {
+                                for (size_t i = thread; i < entries.size(); i += threadCount)
+                                {
+                                    if (!DecodeTile(flags[i], header.bytesPerBlock, encoded[i].data(), encoded[i].size(), dest, entries[i].size) ||
+                                        memcmp(dest, pack.data() + entries[i].offset, entries[i].size) != 0)
+                                        valid = false;
+                                }
+                                threadPasses++;
+                            } while (seconds(passStart) < 0.5);
+                            numPasses += threadPasses;
+                        });
+                    }
+                    for (std::thread& thread : threads)
+                        thread.join();
+
+                    return double(numPasses) / double(threadCount) / seconds(passStart);
+                };
+
+                double decompressRate = double(totalSize) * decompress(1);
+                double passesPerSecondThreaded = decompress(numThreads);
+                double decompressRateThreaded = double(totalSize) * passesPerSecondThreaded;
+
+                printf("%-8s %-8s %6.1f%% %12.1f %12.1f %12.1f %14.0f%s\n", GetTileCodecName(codec), shuffle ? "on" : "off",
+                    100.0 * double(storedSize) / double(totalSize),
+                    double(totalSize) / (1024.0 * 1024.0) / compressSeconds,
+                    decompressRate / (1024.0 * 1024.0),
+                    decompressRateThreaded / (1024.0 * 1024.0),
+                    double(entries.size()) * passesPerSecondThreaded / numThreads,
+                    valid ? "" : "  MISMATCH");
+            }
+        }
+
+        return 0;
+    }
+    // Measures the transcoding of intermediate tiles to every BC format and quality: throughput per core, the size of
+    // the intermediate compared to the BC blocks and the error against the source texture
+    int TranscodeBench(int argc, char** argv)
+    {
+        const char* path = nullptr;
+        uint32_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        TilePackWriterDesc writerDesc;
+
+        for (int i = 0; i < argc; i++)
+        {
+            if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+                numThreads = std::max(uint32_t(atoi(argv[++i])), 1u);
+            else if (!strcmp(argv[i], "--codec") && i + 1 < argc)
+            {
+                if (!ParseCodecArgument(argv[++i], writerDesc.encoder.codec))
+                    return 1;
+            }
+            else if (!strcmp(argv[i], "--near-lossless") && i + 1 < argc)
+                writerDesc.intermediate.nearLossless = uint32_t(atoi(argv[++i]));
+            else if (!strcmp(argv[i], "--full-chroma"))
+                writerDesc.intermediate.subsampleChroma = false;
+            else if (!path)
+                path = argv[i];
+            else
+            {
+                PrintUsage();
+                return 1;
+            }
+        }
+
+        MappedFile file;
+        DdsTextureInfo info;
+        if (!path || !file.Open(path) || !ParseDdsFile(file.GetData(), file.GetSize(), info))
+        {
+            fprintf(stderr, "%s: not a supported DDS file\n", path ? path : "");
+            return 1;
+        }
+
+        printf("%s: %ux%u, %u threads, %s codec, near lossless %u, %s chroma\n", path, info.width, info.height, numThreads,
+            GetTileCodecName(writerDesc.encoder.codec), writerDesc.intermediate.nearLossless, writerDesc.intermediate.subsampleChroma ? "half" : "full");
+        printf("%-6s %-8s %7s %7s %10s %10s %14s %15s %9s\n", "format", "quality", "stored", "vs BC", "enc Mpix/s", "Mpix/s", "tiles/s/core", "tiles/s/core MT", "PSNR");
+
+        auto seconds = [](std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        for (uint32_t formatIndex = 0; formatIndex < uint32_t(BcFormat::Count); formatIndex++)
+        {
+            BcFormat format = BcFormat(formatIndex);
+            writerDesc.transcodeFormat = format;
+
+            std::vector<uint8_t> pack;
+            std::string error;
+            auto start = std::chrono::steady_clock::now();
+            if (!WriteTilePack(info, file.GetData(), writerDesc, pack, error))
+            {
+                fprintf(stderr, "%s: %s\n", path, error.c_str());
+                return 1;
+            }
+            double encodeSeconds = seconds(start);
+
+            TilePackHeader header;
+            memcpy(&header, pack.data(), sizeof(header));
+            std::vector<TilePackSubresource> subresources(size_t(header.arraySize) * header.mipLevels);
+            std::vector<TilePackTileEntry> entries(header.numTiles);
+            memcpy(subresources.data(), pack.data() + header.subresourceTableOffset, subresources.size() * sizeof(TilePackSubresource));
+            memcpy(entries.data(), pack.data() + header.tileTableOffset, entries.size() * sizeof(TilePackTileEntry));
+            if (entries.empty())
+            {
+                fprintf(stderr, "%s: the texture has no standard tiles\n", path);
+                return 1;
+            }
+
+            // Source texels of every tile, to measure the error
+            std::vector<TileRegion> regions(entries.size());
+            uint64_t numTexels = 0;
+            uint64_t totalSize = 0;
+            uint64_t storedSize = 0;
+            for (uint32_t arraySlice = 0; arraySlice < header.arraySize; arraySlice++)
+            {
+                for (uint32_t mip = 0; mip < header.numStandardMips; mip++)
+                {
+                    const TilePackSubresource& subresource = subresources[arraySlice * header.mipLevels + mip];
+                    for (uint32_t tileY = 0; tileY < subresource.heightInTiles; tileY++)
+                    {
+                        for (uint32_t tileX = 0; tileX < subresource.widthInTiles; tileX++)
+                        {
+                            TileRegion& region = regions[subresource.firstTile + tileY * subresource.widthInTiles + tileX];
+                            region.arraySlice = arraySlice;
+                            region.mip = mip;
+                            region.x = tileX * header.tileWidthInTexels;
+                            region.y = tileY * header.tileHeightInTexels;
+                            region.width = std::min(header.tileWidthInTexels, subresource.width - region.x);
+                            region.height = std::min(header.tileHeightInTexels, subresource.height - region.y);
+                            numTexels += uint64_t(region.width) * region.height;
+                        }
+                    }
+                }
+            }
+            for (const TilePackTileEntry& entry : entries)
+            {
+                totalSize += entry.size;
+                storedSize += entry.storedSize;
+            }
+
+            uint32_t numChannels = format == BcFormat::BC5 ? 2 : (format == BcFormat::BC1 ? 3 : 4);
+
+            for (uint32_t qualityIndex = 0; qualityIndex < uint32_t(BcQuality::Count); qualityIndex++)
+            {
+                BcQuality quality = BcQuality(qualityIndex);
+                std::vector<uint8_t> transcoded(size_t(numThreads) * TilePackTileSizeInBytes);
+                std::atomic<bool> valid(true);
+
+                // Every thread transcodes its share of the tiles over and over, the passes of all threads are summed
+                auto transcode = [&](uint32_t threadCount)
+                {
+                    std::atomic<uint64_t> numPasses(0);
+                    auto passStart = std::chrono::steady_clock::now();
+                    std::vector<std::thread> threads;
+                    for (uint32_t thread = 0; thread < threadCount; thread++)
+                    {
+                        threads.emplace_back([&, thread]()
+                        {
+                            uint8_t* dest = transcoded.data() + size_t(thread) * TilePackTileSizeInBytes;
+                            uint64_t threadPasses = 0;
+                            do
+                            {
+                                for (size_t i = thread; i < entries.size(); i += threadCount)
+                                {
+                                    if (!TranscodeTile(entries[i].flags, header.dxgiFormat, quality, pack.data() + entries[i].offset,
+                                        entries[i].storedSize, dest, entries[i].size))
+                                        valid = false;
+                                }
+                                threadPasses++;
+                            } while (seconds(passStart) < 0.5);
+                            numPasses += threadPasses;
+                        });
+                    }
+                    for (std::thread& thread : threads)
+                        thread.join();
+
+                    return double(numPasses) / double(threadCount) / seconds(passStart);
+                };
+
+                double passesPerSecond = transcode(1);
+                double passesPerSecondThreaded = numThreads > 1 ? transcode(numThreads) : passesPerSecond;
+
+                // Error of the decoded blocks against the source texels
+                double squaredError = 0.0;
+                uint64_t numValues = 0;
+                uint8_t texels[64];
+                for (size_t i = 0; i < entries.size(); i++)
+                {
+                    const TileRegion& region = regions[i];
+                    const DdsSubresourceLayout& layout = info.subresources[region.arraySlice * info.mipLevels + region.mip];
+                    uint32_t rowPitch = (region.width + 3) / 4 * header.bytesPerBlock;
+                    if (!TranscodeTile(entries[i].flags, header.dxgiFormat, quality, pack.data() + entries[i].offset,
+                        entries[i].storedSize, transcoded.data(), entries[i].size))
+                        valid = false;
+
+                    for (uint32_t blockY = 0; blockY * 4 < region.height; blockY++)
+                    {
+                        for (uint32_t blockX = 0; blockX * 4 < region.width; blockX++)
+                        {
+                            DecodeBcBlock(format, transcoded.data() + size_t(blockY) * rowPitch + size_t(blockX) * header.bytesPerBlock, texels);
+                            for (uint32_t y = 0; y < 4 && blockY * 4 + y < region.height; y++)
+                            {
+                                const uint8_t* source = file.GetData() + layout.dataOffset + (region.y + blockY * 4 + y) * layout.rowPitch;
+                                for (uint32_t x = 0; x < 4 && blockX * 4 + x < region.width; x++)
+                                {
+                                    for (uint32_t c = 0; c < numChannels; c++)
+                                    {
+                                        double diff = double(source[(region.x + blockX * 4 + x) * 4 + c]) - double(texels[(y * 4 + x) * 4 + c]);
+                                        squaredError += diff * diff;
+                                    }
+                                    numValues += numChannels;
+                                }
+                            }
+                        }
+                    }
+                }
+                double meanSquaredError = squaredError / double(std::max<uint64_t>(numValues, 1));
+
+                printf("%-6s %-8s %6.1f%% %6.1f%% %10.1f %10.1f %14.0f %15.0f %6.2f dB%s\n", GetBcFormatName(format), GetBcQualityName(quality),
+                    100.0 * double(storedSize) / double(numTexels * 4),
+                    100.0 * double(storedSize) / double(totalSize),
+                    double(numTexels) / 1e6 / encodeSeconds,
+                    double(numTexels) * passesPerSecond / 1e6,
+                    double(entries.size()) * passesPerSecond,
+                    double(entries.size()) * passesPerSecondThreaded,
+                    meanSquaredError > 0.0 ? 10.0 * log10(255.0 * 255.0 / meanSquaredError) : 99.0,
+                    valid ? "" : "  FAILED");
+            }
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (!strcmp(argv[1], "convert"))
+        return Convert(argc - 2, argv + 2);
+    if (!strcmp(argv[1], "info"))
+        return Info(argc - 2, argv + 2);
+    if (!strcmp(argv[1], "verify"))
+        return Verify(argc - 2, argv + 2);
+    if (!strcmp(argv[1], "stream"))
+        return Stream(argc - 2, argv + 2);
+    if (!strcmp(argv[1], "bench"))
+        return Bench(argc - 2, argv + 2);
+    if (!strcmp(argv[1], "transcode-bench"))
+        return TranscodeBench(argc - 2, argv + 2);
+
+    PrintUsage();
+    return 1;
+}